@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+#include "algorithm_strategies.h"
+#include "track_store.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+struct Point {
+    float x, y, z;
+};
+
+// Tracks spread over a 10 km x 10 km airspace
+void populate(TrackStore& store, int64_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-5000.0f, 5000.0f);
+    std::uniform_real_distribution<float> altitude(0.0f, 500.0f);
+    for (int64_t i = 0; i < count; ++i) {
+        auto& target = store.create();
+        target.x = position(rng);
+        target.y = position(rng);
+        target.z = altitude(rng);
+        store.relocate(target);
+    }
+}
+
+// Half the detections land on existing tracks, half in empty space
+std::vector<Point> make_detections(const TrackStore& store, size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<float> position(-5000.0f, 5000.0f);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::vector<Point> detections;
+    auto it = store.begin();
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 2 == 0 && it != store.end()) {
+            detections.push_back({it->second.x + noise(rng), it->second.y + noise(rng), it->second.z});
+            ++it;
+        } else {
+            detections.push_back({position(rng), position(rng), 100.0f});
+        }
+    }
+    return detections;
+}
+
+Target* linear_closest(TrackStore& store, float x, float y, float z, float max_distance) {
+    Target* closest = nullptr;
+    float best_sq = max_distance * max_distance;
+    for (auto& [id, target] : store) {
+        float d2 = SpatialGrid::distance_sq(target, x, y, z);
+        if (d2 < best_sq) {
+            best_sq = d2;
+            closest = &target;
+        }
+    }
+    return closest;
+}
+
+// Dense formation: tracks 3 m apart so 5 m gates overlap into large clusters,
+// each observed once with 1 m noise, in shuffled order
+std::vector<Point> make_formation(TrackStore& store, int64_t count, std::mt19937& rng) {
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    const int64_t side = static_cast<int64_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    std::vector<Point> detections;
+    for (int64_t i = 0; i < count; ++i) {
+        auto& target = store.create();
+        target.x = 3.0f * static_cast<float>(i % side);
+        target.y = 3.0f * static_cast<float>(i / side);
+        target.z = 100.0f;
+        store.relocate(target);
+        detections.push_back({target.x + noise(rng), target.y + noise(rng), target.z});
+    }
+    std::shuffle(detections.begin(), detections.end(), rng);
+    return detections;
+}
+
+void run_frame_association(benchmark::State& state, const AssociationStrategy& strategy) {
+    std::mt19937 rng(1);
+    TrackStore store;
+    auto detections = make_formation(store, state.range(0), rng);
+    const float gate = 5.0f;
+    GatedCandidates candidates(detections.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < detections.size(); ++i) {
+            store.find_within(detections[i].x, detections[i].y, detections[i].z, gate, candidates[i]);
+        }
+        benchmark::DoNotOptimize(strategy.associate(candidates, gate * gate));
+    }
+    state.SetItemsProcessed(state.iterations() * detections.size());
+}
+
+} // namespace
+
+/**
+ * @brief Associate a 100-detection frame by scanning every track
+ */
+static void BM_AssociateLinearScan(benchmark::State& state) {
+    std::mt19937 rng(1);
+    TrackStore store;
+    populate(store, state.range(0), rng);
+    auto detections = make_detections(store, 100, rng);
+
+    for (auto _ : state) {
+        for (const auto& d : detections) {
+            benchmark::DoNotOptimize(linear_closest(store, d.x, d.y, d.z, 5.0f));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * detections.size());
+}
+BENCHMARK(BM_AssociateLinearScan)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Associate a 100-detection frame through the grid index
+ */
+static void BM_AssociateSpatialGrid(benchmark::State& state) {
+    std::mt19937 rng(1);
+    TrackStore store;
+    populate(store, state.range(0), rng);
+    auto detections = make_detections(store, 100, rng);
+
+    for (auto _ : state) {
+        for (const auto& d : detections) {
+            benchmark::DoNotOptimize(store.find_closest(d.x, d.y, d.z, 5.0f));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * detections.size());
+}
+BENCHMARK(BM_AssociateSpatialGrid)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Cost of keeping the index current as every track moves
+ */
+static void BM_RelocateAllTracks(benchmark::State& state) {
+    std::mt19937 rng(1);
+    TrackStore store;
+    populate(store, state.range(0), rng);
+
+    for (auto _ : state) {
+        for (auto& [id, target] : store) {
+            target.x += 0.5f;
+            store.relocate(target);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RelocateAllTracks)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Greedy per-detection association of one dense frame (gating included)
+ */
+static void BM_FrameGreedyNearest(benchmark::State& state) {
+    run_frame_association(state, NearestNeighbourAssociation());
+}
+BENCHMARK(BM_FrameGreedyNearest)->Arg(100)->Arg(300)->Arg(500)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Global nearest-neighbour association of one dense frame (gating included)
+ */
+static void BM_FrameGlobalNearest(benchmark::State& state) {
+    run_frame_association(state, GlobalNearestNeighbourAssociation());
+}
+BENCHMARK(BM_FrameGlobalNearest)->Arg(100)->Arg(300)->Arg(500)->Arg(1000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include "algorithms/target_tracking_algorithm.h"
+#include "bench_traffic.h"
+#include "messages/l1_to_l2.pb.h"
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+// One second of traffic at 10k msg/s: 50 radars at 200 Hz, a few objects each
+constexpr int kSensors = 50;
+constexpr int kFramesPerSensor = 200;
+constexpr int kObjectsPerFrame = 4;
+constexpr double kTargetRate = 10000.0;
+
+std::vector<fusion::L1MessagePtr> make_traffic() {
+    std::vector<fusion::L1MessagePtr> traffic;
+    for (auto& message : bench::make_sector_traffic(kSensors, kFramesPerSensor, kObjectsPerFrame, 11)) {
+        traffic.push_back(std::make_shared<messages::L1ToL2Message>(std::move(message)));
+    }
+    return traffic;
+}
+
+// Feeds the traffic in worker-sized batches; batch size 0 means one
+// process_l1_message call per message
+void run(benchmark::State& state, size_t batch_size) {
+    const auto traffic = make_traffic();
+    const std::span<const fusion::L1MessagePtr> all(traffic);
+
+    // The algorithm logs each new track; keep that out of the measurement
+    std::ostringstream sink;
+    auto* previous = std::cout.rdbuf(sink.rdbuf());
+    for (auto _ : state) {
+        state.PauseTiming();
+        TargetTrackingAlgorithm algorithm;
+        fusion::AlgorithmContext context;
+        algorithm.initialize(context);
+        sink.str("");
+        state.ResumeTiming();
+
+        if (batch_size == 0) {
+            for (const auto& message : all) {
+                algorithm.process_l1_message(context, *message);
+            }
+        } else {
+            for (size_t i = 0; i < all.size(); i += batch_size) {
+                algorithm.process_l1_batch(context, all.subspan(i, std::min(batch_size, all.size() - i)));
+            }
+        }
+    }
+    std::cout.rdbuf(previous);
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(traffic.size()));
+    // Share of one core needed to keep up with 10k msg/s (seconds of CPU per second of traffic)
+    state.counters["core_share_at_10k"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) * static_cast<double>(traffic.size()) / kTargetRate,
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+} // namespace
+
+/**
+ * @brief Previous model: one process_l1_message call (and shard lock) per message
+ */
+static void BM_PerMessage(benchmark::State& state) {
+    run(state, 0);
+}
+BENCHMARK(BM_PerMessage)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Worker batches handed to process_l1_batch
+ */
+static void BM_Batched(benchmark::State& state) {
+    run(state, static_cast<size_t>(state.range(0)));
+}
+BENCHMARK(BM_Batched)->Arg(1)->Arg(8)->Arg(32)->Arg(128)->Unit(benchmark::kMillisecond);
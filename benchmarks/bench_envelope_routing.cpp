@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include "l1_envelope.h"
+#include "messages/l1_to_l2.pb.h"
+#include <string>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+messages::L1ToL2Message make_envelope(const std::string& node_id) {
+    messages::L1ToL2Message message;
+    message.set_message_id(node_id + "_msg");
+    message.mutable_sender()->set_node_id(node_id);
+    message.mutable_sender()->set_node_type("lidar");
+    message.mutable_sender()->set_location("mast");
+    message.set_sequence_number(1);
+    return message;
+}
+
+std::string make_heartbeat() {
+    auto message = make_envelope("lidar_0");
+    message.mutable_heartbeat();
+    return message.SerializeAsString();
+}
+
+// Lidar frame with N points, the bulkiest payload L1 nodes send
+std::string make_lidar(int points) {
+    auto message = make_envelope("lidar_0");
+    auto* lidar = message.mutable_sensor_data()->mutable_lidar();
+    for (int i = 0; i < points; ++i) {
+        auto* point = lidar->add_points();
+        point->set_x(0.1f * i);
+        point->set_y(0.2f * i);
+        point->set_z(1.0f);
+    }
+    return message.SerializeAsString();
+}
+
+void report(benchmark::State& state, const std::string& wire) {
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(wire.size()));
+}
+
+} // namespace
+
+/**
+ * @brief Routing a message by parsing all of it (previous ingest path)
+ */
+static void BM_FullParse(benchmark::State& state) {
+    const std::string wire = state.range(0) == 0 ? make_heartbeat() : make_lidar(static_cast<int>(state.range(0)));
+    messages::L1ToL2Message message;
+    for (auto _ : state) {
+        message.ParseFromArray(wire.data(), static_cast<int>(wire.size()));
+        benchmark::DoNotOptimize(message.payload_case());
+    }
+    report(state, wire);
+}
+BENCHMARK(BM_FullParse)->Arg(0)->Arg(100)->Arg(1000);
+
+/**
+ * @brief Routing on the envelope, plus the sender parse node bookkeeping needs
+ */
+static void BM_EnvelopePeek(benchmark::State& state) {
+    const std::string wire = state.range(0) == 0 ? make_heartbeat() : make_lidar(static_cast<int>(state.range(0)));
+    common::NodeIdentity sender;
+    for (auto _ : state) {
+        auto envelope = core::peek_l1_envelope(wire);
+        sender.ParseFromArray(envelope->sender.data(), static_cast<int>(envelope->sender.size()));
+        benchmark::DoNotOptimize(envelope->sensor_case);
+    }
+    report(state, wire);
+}
+BENCHMARK(BM_EnvelopePeek)->Arg(0)->Arg(100)->Arg(1000);
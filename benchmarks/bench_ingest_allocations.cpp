@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include "arena_message_pool.h"
+#include "counting_allocator.h"
+#include "algorithm_framework.h"
+#include "bench_traffic.h"
+#include "messages/l1_to_l2.pb.h"
+#include <queue>
+#include <string>
+#include <vector>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+constexpr size_t kNodes = 8;
+
+std::vector<std::string> make_wire(int detections) {
+    std::vector<std::string> wire;
+    for (size_t node = 0; node < kNodes; ++node) {
+        wire.push_back(bench::make_radar_message(node, detections));
+    }
+    return wire;
+}
+
+} // namespace
+
+/**
+ * @brief Previous ingest path: the message is copied into the queue, out of
+ * the queue, into latest_l1_messages and into the history
+ */
+static void BM_IngestCopying(benchmark::State& state) {
+    const auto wire = make_wire(static_cast<int>(state.range(0)));
+    std::queue<messages::L1ToL2Message> queue;
+    std::unordered_map<std::string, messages::L1ToL2Message> latest;
+    std::unordered_map<std::string, std::vector<messages::L1ToL2Message>> history;
+
+    size_t next = 0;
+    uint64_t ingested = 0;
+    const uint64_t start = bench::g_allocations.load();
+    for (auto _ : state) {
+        const std::string& payload = wire[next++ % kNodes];
+
+        messages::L1ToL2Message message;
+        message.ParseFromString(payload);
+        queue.push(message);
+
+        messages::L1ToL2Message popped = queue.front();
+        queue.pop();
+
+        const std::string& node_id = popped.sender().node_id();
+        latest[node_id] = popped;
+        auto& node_history = history[node_id];
+        node_history.push_back(popped);
+        if (node_history.size() > 100) {
+            node_history.erase(node_history.begin(), node_history.begin() + 50);
+        }
+        ++ingested;
+    }
+    state.counters["allocs_per_msg"] =
+        static_cast<double>(bench::g_allocations.load() - start) / static_cast<double>(ingested);
+}
+BENCHMARK(BM_IngestCopying)->Arg(4)->Arg(64);
+
+/**
+ * @brief Arena ingest path: parsed once into a pooled arena and shared by
+ * the queue, latest_l1_messages and the history
+ */
+static void BM_IngestArena(benchmark::State& state) {
+    const auto wire = make_wire(static_cast<int>(state.range(0)));
+    core::ArenaMessagePool<messages::L1ToL2Message> pool;
+    std::queue<fusion::L1MessagePtr> queue;
+    fusion::AlgorithmContext context;
+
+    size_t next = 0;
+    uint64_t ingested = 0;
+    const uint64_t start = bench::g_allocations.load();
+    for (auto _ : state) {
+        const std::string& payload = wire[next++ % kNodes];
+
+        queue.push(pool.parse(payload.data(), payload.size()));
+
+        fusion::L1MessagePtr popped = std::move(queue.front());
+        queue.pop();
+
+        const std::string& node_id = popped->sender().node_id();
+        context.add_message_to_history(node_id, popped);
+        ++ingested;
+    }
+    state.counters["allocs_per_msg"] =
+        static_cast<double>(bench::g_allocations.load() - start) / static_cast<double>(ingested);
+}
+BENCHMARK(BM_IngestArena)->Arg(4)->Arg(64);
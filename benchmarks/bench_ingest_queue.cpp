@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+#include "mpmc_queue.h"
+#include "condition_wait.h"
+#include "algorithm_framework.h"
+#include "messages/l1_to_l2.pb.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+constexpr int kMessagesPerRun = 200000;
+constexpr size_t kQueueCapacity = 1000;
+
+/**
+ * @brief Previous ingest queue: std::queue guarded by a mutex and condition variable
+ */
+class LockedQueue {
+    std::queue<fusion::L1MessagePtr> queue_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    bool closed_ = false;
+
+public:
+    void push(fusion::L1MessagePtr message) {
+        std::unique_lock lock(mutex_);
+        core::wait_until_ready(not_full_, lock, [this] { return queue_.size() < kQueueCapacity; });
+        queue_.push(std::move(message));
+        not_empty_.notify_one();
+    }
+
+    bool pop(fusion::L1MessagePtr& message) {
+        std::unique_lock lock(mutex_);
+        core::wait_until_ready(not_empty_, lock, [this] { return !queue_.empty() || closed_; });
+        if (queue_.empty()) return false;
+        message = std::move(queue_.front());
+        queue_.pop();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+};
+
+fusion::L1MessagePtr make_message() {
+    auto message = std::make_shared<messages::L1ToL2Message>();
+    message->mutable_sender()->set_node_id("radar_bench");
+    return message;
+}
+
+// Producers push kMessagesPerRun messages in total; returns once workers drained them
+template<typename PushFn, typename WorkerFn, typename CloseFn>
+void run_pipeline(int producers, int workers, PushFn push, WorkerFn worker, CloseFn close) {
+    std::vector<std::thread> worker_threads;
+    for (int w = 0; w < workers; ++w) {
+        worker_threads.emplace_back(worker);
+    }
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p < producers; ++p) {
+        producer_threads.emplace_back([&push, producers] {
+            auto message = make_message();
+            for (int i = 0; i < kMessagesPerRun / producers; ++i) {
+                push(message);
+            }
+        });
+    }
+    for (auto& thread : producer_threads) thread.join();
+    close();
+    for (auto& thread : worker_threads) thread.join();
+}
+
+} // namespace
+
+/**
+ * @brief Mutex + condition variable queue, one message per pop
+ */
+static void BM_LockedQueue(benchmark::State& state) {
+    const int producers = static_cast<int>(state.range(0));
+    const int workers = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        LockedQueue queue;
+        std::atomic<int64_t> consumed{0};
+        run_pipeline(producers, workers,
+            [&queue](const fusion::L1MessagePtr& message) { queue.push(message); },
+            [&queue, &consumed] {
+                fusion::L1MessagePtr message;
+                while (queue.pop(message)) {
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                }
+            },
+            [&queue] { queue.close(); });
+        benchmark::DoNotOptimize(consumed.load());
+    }
+    state.SetItemsProcessed(state.iterations() * (kMessagesPerRun / producers) * producers);
+}
+
+/**
+ * @brief Lock-free ring with batch dequeue, blocking backpressure
+ */
+static void BM_MpmcQueue(benchmark::State& state) {
+    const int producers = static_cast<int>(state.range(0));
+    const int workers = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        core::MpmcQueue<fusion::L1MessagePtr> queue(kQueueCapacity, core::OverflowPolicy::Block);
+        std::atomic<int64_t> consumed{0};
+        run_pipeline(producers, workers,
+            [&queue](const fusion::L1MessagePtr& message) { queue.push(message); },
+            [&queue, &consumed] {
+                std::vector<fusion::L1MessagePtr> batch;
+                while (queue.pop_batch_wait(batch, 32) > 0) {
+                    consumed.fetch_add(static_cast<int64_t>(batch.size()), std::memory_order_relaxed);
+                    batch.clear();
+                }
+            },
+            [&queue] { queue.close(); });
+        benchmark::DoNotOptimize(consumed.load());
+    }
+    state.SetItemsProcessed(state.iterations() * (kMessagesPerRun / producers) * producers);
+}
+
+// Args: producers, workers. Items/s is the ingest throughput.
+#define INGEST_QUEUE_ARGS \
+    ArgsProduct({{1, 2, 4}, {1, 2, 4}})->UseRealTime()->Unit(benchmark::kMillisecond)
+
+BENCHMARK(BM_LockedQueue)->INGEST_QUEUE_ARGS;
+BENCHMARK(BM_MpmcQueue)->INGEST_QUEUE_ARGS;
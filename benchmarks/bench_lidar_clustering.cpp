@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include "point_cloud_clustering.h"
+#include <array>
+#include <cmath>
+#include <queue>
+#include <random>
+#include <vector>
+
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+// A scan of N points: 40 dense objects (80% of returns) plus sparse clutter,
+// laid out as x, y, z, intensity
+std::vector<float> make_scan(size_t num_points) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> center(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> clutter(-150.0f, 150.0f);
+    std::normal_distribution<float> spread(0.0f, 1.0f);
+
+    std::vector<std::array<float, 3>> centers(40);
+    for (auto& c : centers) {
+        c = {center(rng), center(rng), center(rng) * 0.05f};
+    }
+
+    std::vector<float> points;
+    points.reserve(num_points * 4);
+    for (size_t i = 0; i < num_points; ++i) {
+        if (i % 5 != 0) {
+            const auto& c = centers[i % centers.size()];
+            points.insert(points.end(), {c[0] + spread(rng), c[1] + spread(rng), c[2] + 0.5f * spread(rng), 0.8f});
+        } else {
+            points.insert(points.end(), {clutter(rng), clutter(rng), 0.1f * clutter(rng), 0.2f});
+        }
+    }
+    return points;
+}
+
+// Legacy breadth-first clustering: every visited point scans every point
+size_t legacy_cluster_count(const std::vector<float>& points, float distance) {
+    const size_t n = points.size() / 4;
+    std::vector<bool> visited(n, false);
+    size_t clusters = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (visited[i]) continue;
+        std::vector<size_t> cluster;
+        std::queue<size_t> to_visit;
+        to_visit.push(i);
+        visited[i] = true;
+        while (!to_visit.empty()) {
+            size_t current = to_visit.front();
+            to_visit.pop();
+            cluster.push_back(current);
+            for (size_t j = 0; j < n; ++j) {
+                if (visited[j]) continue;
+                float dx = points[current * 4] - points[j * 4];
+                float dy = points[current * 4 + 1] - points[j * 4 + 1];
+                float dz = points[current * 4 + 2] - points[j * 4 + 2];
+                if (std::sqrt(dx*dx + dy*dy + dz*dz) < distance) {
+                    visited[j] = true;
+                    to_visit.push(j);
+                }
+            }
+        }
+        if (cluster.size() > 10) ++clusters;
+    }
+    return clusters;
+}
+
+} // namespace
+
+/**
+ * @brief Legacy O(n^2) BFS clustering (small scans only)
+ */
+static void BM_LidarClusterBruteForce(benchmark::State& state) {
+    auto points = make_scan(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(legacy_cluster_count(points, 1.0f));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LidarClusterBruteForce)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Voxel-grid Euclidean cluster extraction up to a full 64k-point scan
+ */
+static void BM_LidarClusterVoxelGrid(benchmark::State& state) {
+    auto points = make_scan(static_cast<size_t>(state.range(0)));
+    EuclideanClusterExtractor extractor(1.0f, 11);
+    std::vector<PointCluster> clusters;
+    for (auto _ : state) {
+        extractor.extract(points.data(), points.size() / 4, 4, clusters);
+        benchmark::DoNotOptimize(clusters.data());
+    }
+    state.counters["clusters"] = static_cast<double>(clusters.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LidarClusterVoxelGrid)->Arg(1024)->Arg(4096)->Arg(16384)->Arg(65536)->Unit(benchmark::kMillisecond);
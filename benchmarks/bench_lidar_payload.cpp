@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include "packed_point_cloud.h"
+#include "messages/l1_to_l2.pb.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dp_aero_l2;
+using algorithms::packed_point_cloud::append_point;
+using algorithms::packed_point_cloud::unpack;
+
+namespace {
+
+// Serialized L1ToL2Message carrying an N-point lidar scan in either encoding
+std::string make_scan_message(size_t num_points, bool packed) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> intensity(0.1f, 1.0f);
+
+    messages::L1ToL2Message message;
+    message.mutable_sender()->set_node_id("lidar_bench");
+    auto* lidar = message.mutable_sensor_data()->mutable_lidar();
+    lidar->set_num_points(static_cast<int32_t>(num_points));
+    if (packed) {
+        lidar->mutable_packed_points()->reserve(num_points * 16);
+    }
+    for (size_t i = 0; i < num_points; ++i) {
+        float x = position(rng), y = position(rng), z = 0.1f * position(rng), w = intensity(rng);
+        if (packed) {
+            append_point(*lidar->mutable_packed_points(), x, y, z, w);
+        } else {
+            auto* point = lidar->add_points();
+            point->set_x(x);
+            point->set_y(y);
+            point->set_z(z);
+            point->set_intensity(w);
+        }
+    }
+    return message.SerializeAsString();
+}
+
+} // namespace
+
+/**
+ * @brief Parse a scan sent as repeated Point sub-messages and flatten it
+ */
+static void BM_ParseRepeatedPoints(benchmark::State& state) {
+    const std::string wire = make_scan_message(static_cast<size_t>(state.range(0)), false);
+    std::vector<float> points;
+    for (auto _ : state) {
+        messages::L1ToL2Message message;
+        message.ParseFromString(wire);
+        const auto& lidar = message.sensor_data().lidar();
+        points.clear();
+        for (const auto& point : lidar.points()) {
+            points.insert(points.end(), {point.x(), point.y(), point.z(), point.intensity()});
+        }
+        benchmark::DoNotOptimize(points.data());
+    }
+    state.counters["wire_bytes"] = static_cast<double>(wire.size());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(wire.size()));
+}
+BENCHMARK(BM_ParseRepeatedPoints)->Arg(4096)->Arg(65536)->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Parse a scan sent as packed_points and decode it
+ */
+static void BM_ParsePackedPoints(benchmark::State& state) {
+    const std::string wire = make_scan_message(static_cast<size_t>(state.range(0)), true);
+    std::vector<float> points;
+    for (auto _ : state) {
+        messages::L1ToL2Message message;
+        message.ParseFromString(wire);
+        unpack(message.sensor_data().lidar().packed_points(), points);
+        benchmark::DoNotOptimize(points.data());
+    }
+    state.counters["wire_bytes"] = static_cast<double>(wire.size());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(wire.size()));
+}
+BENCHMARK(BM_ParsePackedPoints)->Arg(4096)->Arg(65536)->Unit(benchmark::kMicrosecond);
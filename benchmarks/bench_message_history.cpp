@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include "algorithm_framework.h"
+#include "messages/l1_to_l2.pb.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+constexpr size_t kMessages = 256;  // Distinct messages cycled through, as from a live node
+
+std::vector<fusion::L1MessagePtr> make_messages(int detections) {
+    std::vector<fusion::L1MessagePtr> messages;
+    for (size_t i = 0; i < kMessages; ++i) {
+        messages::L1ToL2Message message;
+        message.set_message_id("radar_0_" + std::to_string(i));
+        message.mutable_sender()->set_node_id("radar_0");
+        message.set_sequence_number(static_cast<int32_t>(i + 1));
+        auto* radar = message.mutable_sensor_data()->mutable_radar();
+        for (int d = 0; d < detections; ++d) {
+            auto* detection = radar->add_detections();
+            detection->set_range(100.0f + d);
+            detection->set_azimuth(0.01f * d);
+        }
+        messages.push_back(std::make_shared<const messages::L1ToL2Message>(std::move(message)));
+    }
+    return messages;
+}
+
+// Bytes a node's history holds: its slots plus the messages it keeps alive
+template<typename Slots, typename MessageOf>
+double bytes_retained(const Slots& slots, size_t slot_bytes, MessageOf message_of) {
+    double bytes = static_cast<double>(slot_bytes);
+    for (const auto& slot : slots) {
+        if (const auto& message = message_of(slot)) {
+            bytes += static_cast<double>(message->SpaceUsedLong());
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+/**
+ * @brief Previous history: per node, a vector grown to 100 whose older half is erased
+ */
+static void BM_HistoryVector(benchmark::State& state) {
+    const auto messages = make_messages(static_cast<int>(state.range(0)));
+    std::unordered_map<std::string, fusion::L1MessagePtr> latest;
+    std::unordered_map<std::string, std::vector<fusion::L1MessagePtr>> histories;
+    const std::string node_id = "radar_0";
+    size_t next = 0;
+    for (auto _ : state) {
+        const auto& message = messages[next++ % kMessages];
+        latest[node_id] = message;
+        auto& history = histories[node_id];
+        history.push_back(message);
+        if (history.size() > 100) {
+            history.erase(history.begin(), history.begin() + history.size() / 2);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    const auto& history = histories[node_id];
+    state.counters["bytes_per_node"] = bytes_retained(
+        history, history.capacity() * sizeof(fusion::L1MessagePtr), [](const auto& slot) { return slot; });
+}
+BENCHMARK(BM_HistoryVector)->Arg(20);
+
+/**
+ * @brief Ring history through AlgorithmContext, with full messages or summaries only
+ *
+ * One receive time per batch of 32, as the manager's workers add them.
+ */
+static void BM_HistoryRing(benchmark::State& state) {
+    const auto messages = make_messages(static_cast<int>(state.range(0)));
+    fusion::AlgorithmContext context;
+    context.history_summaries_only = state.range(1) != 0;
+    const auto node = core::intern_node("radar_0");
+    auto received = std::chrono::steady_clock::now();
+    size_t next = 0;
+    for (auto _ : state) {
+        if (next % 32 == 0) {
+            received = std::chrono::steady_clock::now();
+        }
+        context.add_message_to_history(node, messages[next++ % kMessages], received);
+    }
+    state.SetItemsProcessed(state.iterations());
+    const auto& history = context.get_message_history(node);
+    state.counters["bytes_per_node"] = bytes_retained(
+        history, history.capacity() * sizeof(fusion::HistoryEntry), [](const auto& entry) { return entry.message; });
+}
+BENCHMARK(BM_HistoryRing)->Args({20, 0})->Args({20, 1});
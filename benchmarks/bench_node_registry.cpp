@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "node_registry.h"
+#include <string>
+#include <vector>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+common::NodeIdentity make_node(int i) {
+    common::NodeIdentity node;
+    node.set_node_id("node_" + std::to_string(i));
+    node.set_node_type("radar");
+    node.set_location("mast");
+    return node;
+}
+
+} // namespace
+
+/**
+ * @brief Timeout check over N live nodes; only due nodes are visited
+ */
+static void BM_TimeoutCheck(benchmark::State& state) {
+    core::NodeRegistry registry;
+    for (int i = 0; i < state.range(0); ++i) {
+        registry.register_node(make_node(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.check_and_remove_timed_out_nodes(std::chrono::seconds(30)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimeoutCheck)->Arg(100)->Arg(10000);
+
+/**
+ * @brief Per-message sender handling: parse and register (previous ingest path)
+ */
+static void BM_ParseAndRegister(benchmark::State& state) {
+    core::NodeRegistry registry;
+    const std::string wire = make_node(0).SerializeAsString();
+    for (auto _ : state) {
+        common::NodeIdentity sender;
+        sender.ParseFromArray(wire.data(), static_cast<int>(wire.size()));
+        registry.register_node(sender);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseAndRegister)->ThreadRange(1, 4);
+
+/**
+ * @brief Per-message sender handling: touch the node's record with the unparsed sender
+ */
+static void BM_Touch(benchmark::State& state) {
+    static core::NodeRegistry registry;
+    const std::string wire = make_node(0).SerializeAsString();
+    if (state.thread_index() == 0) {
+        registry.register_node(make_node(0), wire);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.touch_node("node_0", wire));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Touch)->ThreadRange(1, 4);
+
+/**
+ * @brief Active node count taken by the stats reader over N nodes
+ */
+static void BM_CountActive(benchmark::State& state) {
+    core::NodeRegistry registry;
+    for (int i = 0; i < state.range(0); ++i) {
+        registry.register_node(make_node(i));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.count_active_nodes(std::chrono::seconds(30)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CountActive)->Arg(100)->Arg(10000);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+#include "pipelined_publisher.h"
+#include "messages/l2_to_l1.pb.h"
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::redis_utils;
+
+namespace {
+
+// Stand-in for a Redis round trip on a local network
+constexpr auto kRoundTrip = std::chrono::microseconds(100);
+
+// The outputs of one algorithm update: gimbal commands for a set of tracks
+std::vector<messages::L2ToL1Message> make_outputs(size_t count) {
+    std::vector<messages::L2ToL1Message> outputs(count);
+    for (size_t i = 0; i < count; ++i) {
+        outputs[i].set_message_id("L2_" + std::to_string(i));
+        outputs[i].set_target_node_id("gimbal_" + std::to_string(i % 4));
+    }
+    return outputs;
+}
+
+/**
+ * @brief Previous publish path: serialize under the connection mutex, one round trip each
+ */
+class SynchronousPublisher {
+    std::mutex redis_mutex_;
+
+public:
+    void publish(const std::string& channel, const messages::L2ToL1Message& message) {
+        std::lock_guard lock(redis_mutex_);
+        std::string serialized;
+        message.SerializeToString(&serialized);
+        benchmark::DoNotOptimize(channel.size() + serialized.size());
+        std::this_thread::sleep_for(kRoundTrip);
+    }
+};
+
+} // namespace
+
+/**
+ * @brief One synchronous PUBLISH per output
+ */
+static void BM_SynchronousPublish(benchmark::State& state) {
+    const auto outputs = make_outputs(static_cast<size_t>(state.range(0)));
+    SynchronousPublisher publisher;
+    for (auto _ : state) {
+        for (const auto& message : outputs) {
+            publisher.publish("l2_to_l1", message);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SynchronousPublish)->Arg(1)->Arg(8)->Arg(32)->Arg(128)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+/**
+ * @brief Queued outputs coalesced into pipelines, one round trip per batch
+ */
+static void BM_PipelinedPublish(benchmark::State& state) {
+    const auto outputs = make_outputs(static_cast<size_t>(state.range(0)));
+    PipelinedPublisher publisher([](std::span<const OutboundMessage> batch) {
+        benchmark::DoNotOptimize(batch.size());
+        std::this_thread::sleep_for(kRoundTrip);
+    });
+    for (auto _ : state) {
+        for (const auto& message : outputs) {
+            publisher.publish("l2_to_l1", message);
+        }
+        publisher.flush();
+    }
+    auto stats = publisher.get_stats();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["avg_batch"] = stats.average_batch_size;
+    state.counters["avg_flush_us"] = static_cast<double>(stats.average_flush_latency.count());
+}
+BENCHMARK(BM_PipelinedPublish)->Arg(1)->Arg(8)->Arg(32)->Arg(128)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Stand-ins for a local Redis: a PUBLISH round trip and a BRPOP that waits for data
+constexpr auto kRoundTrip = std::chrono::microseconds(100);
+constexpr auto kBlockingPop = std::chrono::milliseconds(5);
+constexpr int kPublishesPerCaller = 200;
+
+/**
+ * @brief Previous model: one connection behind the messenger's global mutex
+ */
+class GlobalMutexClient {
+    std::mutex redis_mutex_;
+
+public:
+    explicit GlobalMutexClient(size_t) {}
+
+    template<typename Duration>
+    void call(Duration duration) {
+        std::lock_guard lock(redis_mutex_);
+        std::this_thread::sleep_for(duration);
+    }
+};
+
+/**
+ * @brief Pooled model: each call borrows one of pool_size connections
+ */
+class PooledClient {
+    std::counting_semaphore<64> connections_;
+
+public:
+    explicit PooledClient(size_t pool_size) : connections_(static_cast<std::ptrdiff_t>(pool_size)) {}
+
+    template<typename Duration>
+    void call(Duration duration) {
+        connections_.acquire();
+        std::this_thread::sleep_for(duration);
+        connections_.release();
+    }
+};
+
+// Concurrent publishers, optionally alongside a consumer looping on blocking pops
+template<typename Client>
+void run(benchmark::State& state, bool blocking_consumer) {
+    const auto callers = static_cast<size_t>(state.range(0));
+    const auto pool_size = static_cast<size_t>(state.range(1));
+
+    for (auto _ : state) {
+        Client client(pool_size);
+        std::atomic<bool> publishing{true};
+        std::thread consumer;
+        if (blocking_consumer) {
+            consumer = std::thread([&] {
+                while (publishing) {
+                    client.call(kBlockingPop);
+                }
+            });
+        }
+
+        std::vector<std::thread> publishers;
+        for (size_t c = 0; c < callers; ++c) {
+            publishers.emplace_back([&client] {
+                for (int i = 0; i < kPublishesPerCaller; ++i) {
+                    client.call(kRoundTrip);
+                }
+            });
+        }
+        for (auto& thread : publishers) thread.join();
+        publishing = false;
+        if (consumer.joinable()) consumer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(callers) * kPublishesPerCaller);
+}
+
+} // namespace
+
+static void BM_GlobalMutexPublish(benchmark::State& state) {
+    run<GlobalMutexClient>(state, false);
+}
+BENCHMARK(BM_GlobalMutexPublish)->ArgsProduct({{1, 2, 4, 8}, {1}})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_PooledPublish(benchmark::State& state) {
+    run<PooledClient>(state, false);
+}
+BENCHMARK(BM_PooledPublish)->ArgsProduct({{1, 2, 4, 8}, {4}})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Publishers alongside a consumer blocked in BRPOP
+ */
+static void BM_GlobalMutexPublishWithBlockingPop(benchmark::State& state) {
+    run<GlobalMutexClient>(state, true);
+}
+BENCHMARK(BM_GlobalMutexPublishWithBlockingPop)->ArgsProduct({{1, 4}, {1}})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_PooledPublishWithBlockingPop(benchmark::State& state) {
+    run<PooledClient>(state, true);
+}
+BENCHMARK(BM_PooledPublishWithBlockingPop)->ArgsProduct({{1, 4}, {5}})->UseRealTime()->Unit(benchmark::kMillisecond);
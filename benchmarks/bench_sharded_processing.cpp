@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "algorithms/target_tracking_algorithm.h"
+#include "bench_traffic.h"
+#include "messages/l1_to_l2.pb.h"
+#include <cmath>
+#include <iostream>
+#include <shared_mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+constexpr int kSensors = 16;
+constexpr int kFramesPerSensor = 64;
+constexpr int kObjectsPerFrame = 40;
+
+// Workers take messages round-robin by sensor, as the manager's workers would
+void run_workers(TargetTrackingAlgorithm& algorithm, fusion::AlgorithmContext& context,
+                 const std::vector<messages::L1ToL2Message>& traffic, size_t workers, bool shared) {
+    std::shared_mutex context_mutex;
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w] {
+            for (size_t i = w; i < traffic.size(); i += workers) {
+                if (shared) {
+                    std::shared_lock lock(context_mutex);
+                    algorithm.process_l1_message(context, traffic[i]);
+                } else {
+                    std::unique_lock lock(context_mutex);
+                    algorithm.process_l1_message(context, traffic[i]);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+}
+
+void run(benchmark::State& state, bool shared) {
+    const auto traffic = bench::make_sector_traffic(kSensors, kFramesPerSensor, kObjectsPerFrame, 5);
+    const auto workers = static_cast<size_t>(state.range(0));
+
+    // The algorithm logs each new track; keep that out of the measurement
+    std::ostringstream sink;
+    auto* previous = std::cout.rdbuf(sink.rdbuf());
+    for (auto _ : state) {
+        state.PauseTiming();
+        TargetTrackingAlgorithm algorithm;
+        fusion::AlgorithmContext context;
+        algorithm.initialize(context);
+        sink.str("");
+        state.ResumeTiming();
+
+        run_workers(algorithm, context, traffic, workers, shared);
+    }
+    std::cout.rdbuf(previous);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(traffic.size()));
+}
+
+} // namespace
+
+/**
+ * @brief Previous model: every worker serializes on the context lock
+ */
+static void BM_ExclusiveContext(benchmark::State& state) {
+    run(state, false);
+}
+BENCHMARK(BM_ExclusiveContext)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Sharded model: workers share the context and lock only the track shards they touch
+ */
+static void BM_ShardedContext(benchmark::State& state) {
+    run(state, true);
+}
+BENCHMARK(BM_ShardedContext)->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,176 @@
+#include <benchmark/benchmark.h>
+#include "algorithm_framework.h"
+#include "counting_allocator.h"
+#include "static_state_machine.h"
+#include "task_manager.h"
+#include <array>
+#include <memory>
+#include <string>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+// The tracking algorithm's states, as a compile-time machine
+struct TrackingStates {
+    enum class State : uint8_t { IDLE, ACQUIRING, TRACKING, LOST, Count };
+    enum class Trigger : uint8_t { DETECTION, CONFIRMED, LOST, TIMEOUT, RESET, Count };
+
+    static constexpr State initial = State::IDLE;
+    static constexpr std::array<std::string_view, 4> state_names = {"IDLE", "ACQUIRING", "TRACKING", "LOST"};
+    static constexpr std::array<std::string_view, 5> trigger_names = {"detection", "confirmed", "lost", "timeout", "reset"};
+    static constexpr std::array<fusion::StaticTransition<State, Trigger>, 8> transitions = {{
+        {State::IDLE, Trigger::DETECTION, State::ACQUIRING},
+        {State::ACQUIRING, Trigger::CONFIRMED, State::TRACKING},
+        {State::TRACKING, Trigger::LOST, State::LOST},
+        {State::LOST, Trigger::TIMEOUT, State::IDLE},
+        {State::IDLE, Trigger::RESET, State::IDLE},
+        {State::ACQUIRING, Trigger::RESET, State::IDLE},
+        {State::TRACKING, Trigger::RESET, State::IDLE},
+        {State::LOST, Trigger::RESET, State::IDLE},
+    }};
+};
+
+struct CountingHooks {
+    int entered = 0;
+    void on_enter(TrackingStates::State, fusion::AlgorithmContext&) { ++entered; }
+};
+
+// The same machine built at run time, with an on_enter per state
+void setup_dynamic(fusion::StateManager& manager, int& entered) {
+    for (const char* name : {"IDLE", "ACQUIRING", "TRACKING", "LOST"}) {
+        auto state = std::make_shared<fusion::State>(name);
+        state->on_enter = [&entered](fusion::AlgorithmContext&) { ++entered; };
+        manager.add_state(name, state);
+    }
+    manager.add_transition(fusion::Transition("IDLE", "ACQUIRING", "detection"));
+    manager.add_transition(fusion::Transition("ACQUIRING", "TRACKING", "confirmed"));
+    manager.add_transition(fusion::Transition("TRACKING", "LOST", "lost"));
+    manager.add_transition(fusion::Transition("LOST", "IDLE", "timeout"));
+    for (const char* name : {"IDLE", "ACQUIRING", "TRACKING", "LOST"}) {
+        manager.add_transition(fusion::Transition(name, "IDLE", "reset"));
+    }
+}
+
+// The task lifecycle as a run-time machine, as each Task used to build for itself
+std::shared_ptr<const fusion::TaskStateMachineDefinition> make_task_definition() {
+    auto definition = std::make_shared<fusion::TaskStateMachineDefinition>();
+    for (const char* name : {"INITIALIZING", "EXECUTING", "COMPLETING", "ERROR"}) {
+        auto state = std::make_shared<fusion::TaskState>(name);
+        state->on_enter = [](fusion::AlgorithmContext&, const std::string&) {};
+        definition->add_state(name, state);
+    }
+    definition->add_transition(fusion::TaskTransition("INITIALIZING", "EXECUTING", "start"));
+    definition->add_transition(fusion::TaskTransition("EXECUTING", "COMPLETING", "complete"));
+    definition->add_transition(fusion::TaskTransition("INITIALIZING", "ERROR", "error"));
+    definition->add_transition(fusion::TaskTransition("EXECUTING", "ERROR", "error"));
+    definition->add_transition(fusion::TaskTransition("ERROR", "INITIALIZING", "retry"));
+    return definition;
+}
+
+} // namespace
+
+/**
+ * @brief Transitions through StateManager: string triggers, linear scan, std::function hooks
+ */
+static void BM_DynamicTransitions(benchmark::State& state) {
+    fusion::StateManager manager;
+    fusion::AlgorithmContext context;
+    int entered = 0;
+    setup_dynamic(manager, entered);
+    context.current_state_name = "IDLE";
+    context.current_state = manager.get_state("IDLE");
+    const std::array<std::string, 4> cycle = {"detection", "confirmed", "lost", "timeout"};
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(manager.try_transition(context, cycle[next++ % cycle.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+    benchmark::DoNotOptimize(entered);
+}
+BENCHMARK(BM_DynamicTransitions);
+
+/**
+ * @brief The same transitions through StaticStateMachine: enum triggers, table lookup
+ */
+static void BM_StaticTransitions(benchmark::State& state) {
+    using Trigger = TrackingStates::Trigger;
+    fusion::StaticStateMachine<TrackingStates> machine;
+    fusion::AlgorithmContext context;
+    CountingHooks hooks;
+    const std::array<Trigger, 4> cycle = {Trigger::DETECTION, Trigger::CONFIRMED, Trigger::LOST, Trigger::TIMEOUT};
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(machine.fire(cycle[next++ % cycle.size()], hooks, context));
+    }
+    state.SetItemsProcessed(state.iterations());
+    benchmark::DoNotOptimize(hooks.entered);
+}
+BENCHMARK(BM_StaticTransitions);
+
+/**
+ * @brief Bytes per task: a Task with a run-time machine of its own, as every Task used to build
+ */
+static void BM_TaskWithOwnDefinition(benchmark::State& state) {
+    uint64_t heap_bytes = 0;
+    for (auto _ : state) {
+        const uint64_t before = bench::g_allocated_bytes.load(std::memory_order_relaxed);
+        fusion::Task task("task_1", "target_1", fusion::Task::Type::TRACK_TARGET, fusion::Task::Priority::NORMAL,
+                          make_task_definition());
+        heap_bytes = bench::g_allocated_bytes.load(std::memory_order_relaxed) - before;
+        benchmark::DoNotOptimize(&task);
+    }
+    state.counters["heap_bytes_per_task"] = static_cast<double>(heap_bytes);
+    state.counters["bytes_per_task"] = static_cast<double>(heap_bytes + sizeof(fusion::Task));
+}
+BENCHMARK(BM_TaskWithOwnDefinition);
+
+/**
+ * @brief Bytes per task: a Task running a run-time machine shared by its type
+ */
+static void BM_TaskWithSharedDefinition(benchmark::State& state) {
+    const auto definition = make_task_definition();
+    uint64_t heap_bytes = 0;
+    for (auto _ : state) {
+        const uint64_t before = bench::g_allocated_bytes.load(std::memory_order_relaxed);
+        fusion::Task task("task_1", "target_1", fusion::Task::Type::TRACK_TARGET, fusion::Task::Priority::NORMAL,
+                          definition);
+        heap_bytes = bench::g_allocated_bytes.load(std::memory_order_relaxed) - before;
+        benchmark::DoNotOptimize(&task);
+    }
+    state.counters["heap_bytes_per_task"] = static_cast<double>(heap_bytes);
+    state.counters["bytes_per_task"] = static_cast<double>(heap_bytes + sizeof(fusion::Task));
+}
+BENCHMARK(BM_TaskWithSharedDefinition);
+
+/**
+ * @brief Transitions of a task running a shared run-time machine
+ */
+static void BM_SharedDefinitionTransitions(benchmark::State& state) {
+    fusion::Task task("task_1", "target_1", fusion::Task::Type::TRACK_TARGET, fusion::Task::Priority::NORMAL,
+                      make_task_definition());
+    fusion::AlgorithmContext context;
+    const std::array<std::string, 3> cycle = {"start", "error", "retry"};
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(task.trigger_state_transition(context, cycle[next++ % cycle.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedDefinitionTransitions);
+
+/**
+ * @brief Bytes per task: a Task with its compile-time lifecycle
+ */
+static void BM_TaskWithStaticMachine(benchmark::State& state) {
+    uint64_t heap_bytes = 0;
+    for (auto _ : state) {
+        const uint64_t before = bench::g_allocated_bytes.load(std::memory_order_relaxed);
+        fusion::Task task("task_1", "target_1", fusion::Task::Type::TRACK_TARGET);
+        heap_bytes = bench::g_allocated_bytes.load(std::memory_order_relaxed) - before;
+        benchmark::DoNotOptimize(&task);
+    }
+    state.counters["heap_bytes_per_task"] = static_cast<double>(heap_bytes);
+    state.counters["bytes_per_task"] = static_cast<double>(heap_bytes + sizeof(fusion::Task));
+}
+BENCHMARK(BM_TaskWithStaticMachine);
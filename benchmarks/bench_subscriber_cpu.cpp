@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include "arena_message_pool.h"
+#include "algorithm_framework.h"
+#include "bench_traffic.h"
+#include "mpmc_queue.h"
+#include "messages/l1_to_l2.pb.h"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+constexpr double kTargetRate = 10000.0;
+constexpr size_t kQueueCapacity = 1024;
+constexpr size_t kDrainEvery = 512;  // Payloads queued before a (paused) worker drains them
+
+// redis++ keeps the message callback as this type and moves the channel and
+// the payload it copied out of the reply into it
+using RedisCallback = std::function<void(std::string, std::string)>;
+
+/**
+ * @brief Work of the subscription thread per message: the reply copy redis++
+ * makes, then the callback chain. A paused drain stands in for the workers
+ */
+template<typename Drain>
+void run(benchmark::State& state, const RedisCallback& on_message, Drain&& drain) {
+    const std::string wire = bench::make_radar_message(0, static_cast<int>(state.range(0)));
+    const std::string channel = "l1_to_l2";
+    size_t since_drain = 0;
+    for (auto _ : state) {
+        on_message(std::string(channel), std::string(wire.data(), wire.size()));
+        if (++since_drain == kDrainEvery) {
+            state.PauseTiming();
+            drain();
+            since_drain = 0;
+            state.ResumeTiming();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(wire.size()));
+    // Share of one core the subscription thread needs at 10k msg/s
+    state.counters["core_share_at_10k"] = benchmark::Counter(
+        static_cast<double>(state.iterations()) / kTargetRate,
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+void consume(const messages::L1ToL2Message& message) {
+    benchmark::DoNotOptimize(message.sensor_data().radar().detections_size());
+}
+
+} // namespace
+
+/**
+ * @brief Previous subscribe<T>: a fresh message per payload, ParseFromString
+ */
+static void BM_FreshMessagePerPayload(benchmark::State& state) {
+    std::function<void(const std::string&)> parse = [](const std::string& payload) {
+        messages::L1ToL2Message message;
+        if (message.ParseFromString(payload)) {
+            consume(message);
+        }
+    };
+    run(state, [parse](std::string, std::string msg) { parse(msg); }, [] {});
+}
+BENCHMARK(BM_FreshMessagePerPayload)->Arg(4)->Arg(40)->Arg(400);
+
+/**
+ * @brief subscribe<T>: one reused message, parsed in place from the payload view
+ */
+static void BM_ReusedMessage(benchmark::State& state) {
+    messages::L1ToL2Message message;
+    std::function<void(std::string_view)> parse = [&message](std::string_view payload) {
+        if (message.ParseFromArray(payload.data(), static_cast<int>(payload.size()))) {
+            consume(message);
+        }
+    };
+    run(state, [parse](std::string, std::string msg) { parse(msg); }, [] {});
+}
+BENCHMARK(BM_ReusedMessage)->Arg(4)->Arg(40)->Arg(400);
+
+/**
+ * @brief Manager, parsing on receipt: subscribe_view into the ingest arenas, then the queue
+ */
+static void BM_ParseOnReceipt(benchmark::State& state) {
+    core::ArenaMessagePool<messages::L1ToL2Message> pool;
+    core::MpmcQueue<fusion::L1MessagePtr> queue(kQueueCapacity, core::OverflowPolicy::DropOldest);
+    std::vector<fusion::L1MessagePtr> drained;
+    std::function<void(std::string_view)> ingest = [&](std::string_view payload) {
+        if (auto message = pool.parse(payload.data(), payload.size())) {
+            queue.push(std::move(message));
+        }
+    };
+    run(state, [ingest](std::string, std::string msg) { ingest(msg); }, [&] {
+        drained.clear();
+        queue.try_pop_batch(drained, kQueueCapacity);
+        drained.clear();
+    });
+}
+BENCHMARK(BM_ParseOnReceipt)->Arg(4)->Arg(40)->Arg(400);
+
+/**
+ * @brief Manager with defer_parsing: subscribe_owned moves the payload into the queue
+ */
+static void BM_DeferredParsing(benchmark::State& state) {
+    core::MpmcQueue<std::string> queue(kQueueCapacity, core::OverflowPolicy::DropOldest);
+    std::vector<std::string> drained;
+    std::function<void(std::string&&)> ingest = [&](std::string&& payload) {
+        queue.push(std::move(payload));
+    };
+    run(state, [ingest](std::string, std::string msg) { ingest(std::move(msg)); }, [&] {
+        drained.clear();
+        queue.try_pop_batch(drained, kQueueCapacity);
+        drained.clear();
+    });
+}
+BENCHMARK(BM_DeferredParsing)->Arg(4)->Arg(40)->Arg(400);
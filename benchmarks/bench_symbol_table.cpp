@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include "symbol_table.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+// Per-node state touched by each message: registry, sequence tracking, history
+struct NodeState {
+    int64_t last_seen = 0;
+    int32_t highest = 0;
+    size_t history = 0;
+};
+
+std::vector<std::string> make_ids(int count) {
+    std::vector<std::string> ids;
+    for (int i = 0; i < count; ++i) {
+        ids.push_back("radar_node_" + std::to_string(i));
+    }
+    return ids;
+}
+
+} // namespace
+
+/**
+ * @brief Per-message keying with string ids: three string-keyed map lookups
+ */
+static void BM_StringKeyed(benchmark::State& state) {
+    const auto ids = make_ids(static_cast<int>(state.range(0)));
+    std::unordered_map<std::string, int64_t> registry;
+    std::unordered_map<std::string, int32_t> sequences;
+    std::unordered_map<std::string, size_t> history;
+    size_t next = 0;
+    for (auto _ : state) {
+        const std::string_view id = ids[next++ % ids.size()];
+        registry[std::string(id)]++;
+        sequences[std::string(id)]++;
+        history[std::string(id)]++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StringKeyed)->Arg(16)->Arg(1024);
+
+/**
+ * @brief Per-message keying with symbols: one intern at ingest, three flat-array lookups
+ */
+static void BM_SymbolKeyed(benchmark::State& state) {
+    const auto ids = make_ids(static_cast<int>(state.range(0)));
+    core::SymbolMap<core::NodeTag, int64_t> registry;
+    core::SymbolMap<core::NodeTag, int32_t> sequences;
+    core::SymbolMap<core::NodeTag, size_t> history;
+    size_t next = 0;
+    for (auto _ : state) {
+        const auto node = core::intern_node(ids[next++ % ids.size()]);
+        registry[node]++;
+        sequences[node]++;
+        history[node]++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SymbolKeyed)->Arg(16)->Arg(1024);
+
+/**
+ * @brief Per-node state scan (stats, timeouts) over string-keyed and symbol-keyed maps
+ */
+static void BM_ScanStringKeyed(benchmark::State& state) {
+    std::unordered_map<std::string, NodeState> nodes;
+    for (const auto& id : make_ids(static_cast<int>(state.range(0)))) {
+        nodes[id];
+    }
+    for (auto _ : state) {
+        int64_t total = 0;
+        for (const auto& [id, node] : nodes) {
+            total += node.last_seen;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScanStringKeyed)->Arg(1024);
+
+static void BM_ScanSymbolKeyed(benchmark::State& state) {
+    core::SymbolMap<core::NodeTag, NodeState> nodes;
+    for (const auto& id : make_ids(static_cast<int>(state.range(0)))) {
+        nodes[core::intern_node(id)];
+    }
+    for (auto _ : state) {
+        int64_t total = 0;
+        nodes.for_each([&](core::NodeSymbol, const NodeState& node) { total += node.last_seen; });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScanSymbolKeyed)->Arg(1024);
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include "algorithm_framework.h"
+#include "task_manager.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace dp_aero_l2;
+
+/**
+ * @brief Create, assign and remove tasks with many tasks live on one target and device
+ */
+static void BM_TaskChurn(benchmark::State& state) {
+    fusion::TaskManager manager;
+    std::vector<std::string> live;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        live.push_back(manager.create_task("target_001", fusion::Task::Type::TRACK_TARGET));
+        manager.assign_task_to_device(live.back(), "radar_001");
+    }
+
+    for (auto _ : state) {
+        live.push_back(manager.create_task("target_001", fusion::Task::Type::TRACK_TARGET));
+        manager.assign_task_to_device(live.back(), "radar_001");
+        // Remove from the middle of the target's list, where unlinking from a vector costs most
+        std::swap(live[live.size() / 2], live.back());
+        benchmark::DoNotOptimize(manager.remove_task(live.back()));
+        live.pop_back();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TaskChurn)->Arg(16)->Arg(1024)->Arg(16384);
+
+/**
+ * @brief update_all_tasks over a pool of tasks, including its reclaim step
+ */
+static void BM_UpdateAllTasks(benchmark::State& state) {
+    fusion::TaskManager manager;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        const auto id = manager.create_task("target_" + std::to_string(i % 64), fusion::Task::Type::TRACK_TARGET);
+        manager.get_task(id)->set_status(i % 2 ? fusion::Task::Status::ACTIVE : fusion::Task::Status::COMPLETED);
+    }
+    fusion::AlgorithmContext context;
+
+    for (auto _ : state) {
+        manager.update_all_tasks(context);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UpdateAllTasks)->Arg(1024)->Arg(16384);
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+#include "algorithms/target_tracking_algorithm.h"
+#include "track_store.h"
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+using namespace dp_aero_l2;
+using algorithms::Target;
+using algorithms::TrackStore;
+
+namespace {
+
+// Tracks laid out on a 20 m grid so every detection gates onto exactly one track
+void populate(TrackStore& store, int64_t count) {
+    for (int64_t i = 0; i < count; ++i) {
+        auto& target = store.create();
+        target.x = 50.0f + 20.0f * static_cast<float>(i % 100);
+        target.y = 20.0f * static_cast<float>(i / 100);
+        target.z = 10.0f;
+        target.confidence = 0.2f;
+        target.last_update = std::chrono::steady_clock::now();
+    }
+}
+
+messages::L1ToL2Message make_radar_frame(const TrackStore& store, int detections) {
+    messages::L1ToL2Message message;
+    message.mutable_sender()->set_node_id("radar_bench");
+    auto* radar = message.mutable_sensor_data()->mutable_radar();
+
+    int added = 0;
+    for (const auto& [id, target] : store) {
+        if (added++ == detections) break;
+        float range = std::sqrt(target.x * target.x + target.y * target.y + target.z * target.z);
+        auto* detection = radar->add_detections();
+        detection->set_range(range);
+        detection->set_azimuth(std::atan2(target.y, target.x));
+        detection->set_elevation(std::asin(target.z / range));
+        detection->set_rcs(1.0f);
+    }
+    return message;
+}
+
+} // namespace
+
+/**
+ * @brief Legacy access pattern: copy the target map out of std::any and back
+ */
+static void BM_AnyMapRoundTrip(benchmark::State& state) {
+    fusion::AlgorithmContext context;
+    TrackStore store;
+    populate(store, state.range(0));
+    std::unordered_map<std::string, Target> map(store.begin(), store.end());
+    context.set_data("targets", map);
+
+    for (auto _ : state) {
+        auto targets = *context.get_data<std::unordered_map<std::string, Target>>("targets");
+        targets.begin()->second.confidence += 0.0f;
+        context.set_data("targets", targets);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_AnyMapRoundTrip)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+
+/**
+ * @brief Typed slot access: the store is mutated in place
+ */
+static void BM_TrackStoreSlot(benchmark::State& state) {
+    fusion::AlgorithmContext context;
+    populate(context.emplace_data<TrackStore>("targets"), state.range(0));
+
+    for (auto _ : state) {
+        auto* targets = context.get_data_ptr<TrackStore>("targets");
+        targets->begin()->second.confidence += 0.0f;
+        benchmark::DoNotOptimize(targets);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_TrackStoreSlot)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+
+/**
+ * @brief End-to-end radar frame (5 detections) against N live tracks
+ */
+static void BM_RadarFrame(benchmark::State& state) {
+    algorithms::TargetTrackingAlgorithm algorithm;
+    fusion::AlgorithmContext context;
+    algorithm.initialize(context);
+    auto* store = context.get_data_ptr<TrackStore>("targets");
+    populate(*store, state.range(0));
+    auto frame = make_radar_frame(*store, 5);
+
+    for (auto _ : state) {
+        algorithm.process_l1_message(context, frame);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_RadarFrame)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+
+/**
+ * @brief Periodic update() cycle against N live tracks
+ */
+static void BM_TrackingUpdate(benchmark::State& state) {
+    algorithms::TargetTrackingAlgorithm algorithm;
+    fusion::AlgorithmContext context;
+    algorithm.initialize(context);
+    populate(*context.get_data_ptr<TrackStore>("targets"), state.range(0));
+
+    for (auto _ : state) {
+        algorithm.update(context);
+        context.pending_outputs.clear();
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_TrackingUpdate)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+#include "track_table.h"
+#include "track_store.h"
+#include <random>
+#include <vector>
+
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+void populate(TrackStore& store, int64_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-5000.0f, 5000.0f);
+    std::uniform_real_distribution<float> velocity(-50.0f, 50.0f);
+    auto now = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < count; ++i) {
+        auto& target = store.create();
+        target.x = position(rng);
+        target.y = position(rng);
+        target.z = position(rng) / 10.0f;
+        target.vx = velocity(rng);
+        target.vy = velocity(rng);
+        target.vz = velocity(rng) / 10.0f;
+        target.confidence = 0.5f;
+        target.last_update = now - std::chrono::seconds(i % 20);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Constant-velocity prediction
+// ============================================================================
+
+static void BM_PredictAoS(benchmark::State& state) {
+    TrackStore store;
+    populate(store, state.range(0));
+    for (auto _ : state) {
+        for (auto& [id, target] : store) {
+            target.x += target.vx * 0.1f;
+            target.y += target.vy * 0.1f;
+            target.z += target.vz * 0.1f;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PredictAoS)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_PredictSoA(benchmark::State& state) {
+    TrackStore store;
+    populate(store, state.range(0));
+    auto table = TrackTable::from_store(store);
+    for (auto _ : state) {
+        table.predict(0.1f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PredictSoA)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// ============================================================================
+// Confidence decay
+// ============================================================================
+
+static void BM_DecayAoS(benchmark::State& state) {
+    TrackStore store;
+    populate(store, state.range(0));
+    auto now = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        for (auto& [id, target] : store) {
+            if (now - target.last_update > std::chrono::seconds(10)) {
+                target.confidence *= 0.9999f;
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecayAoS)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_DecaySoA(benchmark::State& state) {
+    TrackStore store;
+    populate(store, state.range(0));
+    auto table = TrackTable::from_store(store);
+    auto now = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        table.decay_confidence(now, std::chrono::seconds(10), 0.9999f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DecaySoA)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// ============================================================================
+// Distance gating (one query against every track)
+// ============================================================================
+
+static void BM_GateAoS(benchmark::State& state) {
+    TrackStore store;
+    populate(store, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(store.find_closest(10.0f, 20.0f, 5.0f, 50.0f));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GateAoS)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_GateSoA(benchmark::State& state) {
+    TrackStore store;
+    populate(store, state.range(0));
+    auto table = TrackTable::from_store(store);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.nearest(10.0f, 20.0f, 5.0f, 50.0f));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GateSoA)->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "messages/l1_to_l2.pb.h"
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * L1 traffic shared by the benchmarks, so the ones comparing ingest paths
+ * measure the same messages.
+ */
+
+namespace dp_aero_l2::bench {
+
+// Serialized radar message with N detections, as published by L1 node
+// radar_<node>
+inline std::string make_radar_message(size_t node, int detections) {
+    messages::L1ToL2Message message;
+    message.set_message_id("radar_" + std::to_string(node) + "_msg");
+    message.mutable_sender()->set_node_id("radar_" + std::to_string(node));
+    message.mutable_sender()->set_node_type("radar");
+    message.set_sequence_number(1);
+    auto* radar = message.mutable_sensor_data()->mutable_radar();
+    radar->set_max_range(5000.0f);
+    for (int i = 0; i < detections; ++i) {
+        auto* detection = radar->add_detections();
+        detection->set_range(100.0f + i);
+        detection->set_azimuth(0.01f * i);
+        detection->set_velocity(12.0f);
+        detection->set_rcs(1.5f);
+    }
+    return message.SerializeAsString();
+}
+
+// Frames of radars placed one per sector, each watching its own group of
+// objects, interleaved by sensor as they would arrive
+inline std::vector<messages::L1ToL2Message> make_sector_traffic(int sensors, int frames_per_sensor,
+                                                                int objects_per_frame, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> jitter(0.0f, 0.3f);
+    std::vector<messages::L1ToL2Message> traffic;
+    traffic.reserve(static_cast<size_t>(sensors) * frames_per_sensor);
+    for (int frame = 0; frame < frames_per_sensor; ++frame) {
+        for (int sensor = 0; sensor < sensors; ++sensor) {
+            messages::L1ToL2Message message;
+            message.mutable_sender()->set_node_id("radar_" + std::to_string(sensor));
+            auto* radar = message.mutable_sensor_data()->mutable_radar();
+            float sector = 2.0f * 3.14159265f * sensor / sensors;
+            for (int object = 0; object < objects_per_frame; ++object) {
+                auto* detection = radar->add_detections();
+                detection->set_range(500.0f + 25.0f * object + jitter(rng));
+                detection->set_azimuth(sector + 0.001f * jitter(rng));
+                detection->set_rcs(1.0f);
+            }
+            traffic.push_back(std::move(message));
+        }
+    }
+    return traffic;
+}
+
+} // namespace dp_aero_l2::bench
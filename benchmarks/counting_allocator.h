@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Replaces the global operator new and delete with malloc/free wrappers
+ * that count every heap allocation in the process, for benchmarks that
+ * report allocations. Include it from one source file of a benchmark
+ * executable only.
+ */
+
+namespace dp_aero_l2::bench {
+
+inline std::atomic<uint64_t> g_allocations{0};
+inline std::atomic<uint64_t> g_allocated_bytes{0};
+
+// Out of line, so the compiler never pairs a new expression with free()
+[[gnu::noinline]] inline void* counted_malloc(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] inline void counted_free(void* p) noexcept {
+    std::free(p);
+}
+
+} // namespace dp_aero_l2::bench
+
+void* operator new(size_t size) { return dp_aero_l2::bench::counted_malloc(size); }
+void* operator new[](size_t size) { return dp_aero_l2::bench::counted_malloc(size); }
+void operator delete(void* p) noexcept { dp_aero_l2::bench::counted_free(p); }
+void operator delete[](void* p) noexcept { dp_aero_l2::bench::counted_free(p); }
+void operator delete(void* p, size_t) noexcept { dp_aero_l2::bench::counted_free(p); }
+void operator delete[](void* p, size_t) noexcept { dp_aero_l2::bench::counted_free(p); }
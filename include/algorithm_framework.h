@@ -6,14 +6,19 @@
 #include <vector>
 #include <functional>
 #include <any>
+#include <atomic>
 #include <chrono>
 #include <concepts>
 #include <shared_mutex>
 #include <optional>
 #include <queue>
+#include <span>
 
 #include "messages/l1_to_l2.pb.h"
 #include "messages/l2_to_l1.pb.h"
+#include "messages/l2_to_l2.pb.h"
+#include "message_history.h"
+#include "partition_map.h"
 #include "task_manager.h"
 
 namespace dp_aero_l2::fusion {
@@ -22,6 +27,14 @@ namespace dp_aero_l2::fusion {
 class AlgorithmContext;
 class StateManager;
 
+/**
+ * @brief Shared, immutable handle to an ingested L1 message
+ *
+ * Ingest parses each message once (see core::ArenaMessagePool); the queue,
+ * latest_l1_messages and message_history then share that single instance.
+ */
+using L1MessagePtr = std::shared_ptr<const messages::L1ToL2Message>;
+
 /**
  * @brief State machine state representation
  */
@@ -59,8 +72,11 @@ public:
     std::shared_ptr<State> current_state;
     
     // Input data from L1 nodes
-    std::unordered_map<std::string, messages::L1ToL2Message> latest_l1_messages;
-    std::unordered_map<std::string, std::vector<messages::L1ToL2Message>> message_history;
+    core::SymbolMap<core::NodeTag, L1MessagePtr> latest_l1_messages;
+    core::SymbolMap<core::NodeTag, MessageRing> message_history;
+    size_t max_history_per_node = 100;
+    std::chrono::milliseconds history_retention{0};  // Entries older than this are dropped; 0: kept until overwritten
+    bool history_summaries_only = false;             // Keep only each message's summary, not the message
     
     // Algorithm-specific data storage
     std::unordered_map<std::string, std::any> algorithm_data;
@@ -69,10 +85,23 @@ public:
     std::chrono::steady_clock::time_point last_update;
     std::chrono::milliseconds update_interval{100};
     
+    // Raised by request_update() when update() should run now rather than
+    // at the next tick (e.g. for a new high-priority target)
+    std::atomic<bool> update_requested{false};
+    
     // Output messages to be sent to L1 nodes
     std::vector<messages::L2ToL1Message> pending_outputs;
     
     // Helper methods
+    void request_update() {
+        update_requested.store(true, std::memory_order_relaxed);
+    }
+    
+    bool take_update_request() {
+        return update_requested.load(std::memory_order_relaxed) &&
+               update_requested.exchange(false, std::memory_order_relaxed);
+    }
+    
     template<typename T>
     void set_data(const std::string& key, const T& value) {
         algorithm_data[key] = value;
@@ -90,14 +119,121 @@ public:
         }
         return std::nullopt;
     }
-    
+
+    /**
+     * @brief Construct a value in place and return a reference to it
+     *
+     * Replaces any existing value stored under the key. The returned
+     * reference stays valid until the key is overwritten or erased.
+     */
+    template<typename T, typename... Args>
+    T& emplace_data(const std::string& key, Args&&... args) {
+        return algorithm_data[key].template emplace<T>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Access stored data in place, without copying it out
+     * @return Pointer to the stored value, or nullptr if missing or of another type
+     */
+    template<typename T>
+    T* get_data_ptr(const std::string& key) {
+        auto it = algorithm_data.find(key);
+        return (it != algorithm_data.end()) ? std::any_cast<T>(&it->second) : nullptr;
+    }
+
+    template<typename T>
+    const T* get_data_ptr(const std::string& key) const {
+        auto it = algorithm_data.find(key);
+        return (it != algorithm_data.end()) ? std::any_cast<T>(&it->second) : nullptr;
+    }
+
     void add_output_message(const messages::L2ToL1Message& message) {
         pending_outputs.push_back(message);
     }
     
+    /**
+     * @brief Record a message as the node's latest and append it to its history
+     *
+     * Each node's history is a ring of the max_history_per_node most recent
+     * messages; once full, the oldest entry is overwritten. Callers adding a
+     * batch can pass one receive time for all of it.
+     */
+    void add_message_to_history(core::NodeSymbol node, L1MessagePtr message,
+                                std::chrono::steady_clock::time_point received = std::chrono::steady_clock::now()) {
+        auto& history = message_history[node];
+        if (history.capacity() != max_history_per_node) {
+            history.set_capacity(max_history_per_node);
+        }
+        if (history_retention.count() > 0) {
+            history.expire(received - history_retention);
+        }
+        history.push(HistoryEntry{.summary = summarize_l1_message(*message, received),
+                                  .message = history_summaries_only ? nullptr : message});
+        latest_l1_messages[node] = std::move(message);
+    }
+    
+    void add_message_to_history(const std::string& node_id, L1MessagePtr message) {
+        add_message_to_history(core::intern_node(node_id), std::move(message));
+    }
+    
+    void add_message_to_history(const std::string& node_id, const messages::L1ToL2Message& message) {
+        add_message_to_history(node_id, std::make_shared<const messages::L1ToL2Message>(message));
+    }
+    
+    /**
+     * @brief The latest message of a node, or null if none was received
+     */
+    L1MessagePtr get_latest_message(const std::string& node_id) const {
+        const auto* message = latest_l1_messages.find(core::SymbolTable<core::NodeTag>::global().find(node_id));
+        return message ? *message : nullptr;
+    }
+    
+    /**
+     * @brief Drop history entries older than history_retention, and nodes left without any
+     */
+    void expire_message_history() {
+        if (history_retention.count() <= 0) {
+            return;
+        }
+        const auto cutoff = std::chrono::steady_clock::now() - history_retention;
+        message_history.erase_if([cutoff](core::NodeSymbol, MessageRing& history) {
+            history.expire(cutoff);
+            return history.empty();
+        });
+    }
+    
+    /**
+     * @brief A node's recent messages (oldest first), read in place
+     *
+     * The reference is valid while the caller holds the context. The
+     * manager appends to the history under a shared context lock when the
+     * algorithm processes concurrently, so such algorithms read it only from
+     * update() or handle_trigger(), which run exclusively.
+     */
+    const MessageRing& get_message_history(core::NodeSymbol node) const {
+        static const MessageRing empty;
+        const auto* history = message_history.find(node);
+        return history ? *history : empty;
+    }
+    
+    const MessageRing& get_message_history(const std::string& node_id) const {
+        return get_message_history(core::SymbolTable<core::NodeTag>::global().find(node_id));
+    }
+    
+    /**
+     * @brief Copies of a node's recent messages (oldest first)
+     *
+     * Prefer get_message_history(), which does not copy. Empty when only
+     * summaries are kept.
+     */
     std::vector<messages::L1ToL2Message> get_messages_from_node(const std::string& node_id) const {
-        auto it = message_history.find(node_id);
-        return (it != message_history.end()) ? it->second : std::vector<messages::L1ToL2Message>{};
+        std::vector<messages::L1ToL2Message> messages;
+        for (const auto& entry : get_message_history(node_id)) {
+            if (entry.message) {
+                messages.push_back(*entry.message);
+            }
+        }
+        return messages;
     }
 };
 
@@ -187,6 +323,65 @@ public:
     virtual void process_l1_message(AlgorithmContext& context, 
                                    const messages::L1ToL2Message& message) = 0;
     
+    /**
+     * @brief Process a burst of messages from L1 nodes, in arrival order
+     *
+     * The manager hands over everything a worker dequeued at once. The
+     * default processes the messages one by one; algorithms override it to
+     * share lookups, locks and buffers across the burst.
+     *
+     * @param context Algorithm execution context
+     * @param messages Incoming messages, oldest first
+     */
+    virtual void process_l1_batch(AlgorithmContext& context,
+                                  std::span<const L1MessagePtr> messages) {
+        for (const auto& message : messages) {
+            process_l1_message(context, *message);
+        }
+    }
+    
+    /**
+     * @brief Whether process_l1_message may run on several workers at once
+     *
+     * If true, the manager calls process_l1_batch concurrently under a
+     * shared context lock. The algorithm must then confine message-driven
+     * mutations to its own sharded state (see ShardedTrackStore) and leave
+     * the context's maps (including the message history), outputs and
+     * state machine alone, deferring transitions to update(). update(), handle_trigger() and shutdown()
+     * always run exclusively and are the merge point for global state.
+     */
+    virtual bool supports_concurrent_processing() const {
+        return false;
+    }
+    
+    /**
+     * @brief Add the tracks another L2 partition may also hold to an exchange
+     *
+     * Called exclusively, every boundary_exchange_interval, when the system
+     * runs as several partitions. The default shares nothing.
+     *
+     * @param context Algorithm execution context
+     * @param partitions Partition map of this process
+     * @param exchange Message to append tracks to
+     */
+    virtual void export_boundary_tracks(AlgorithmContext& /*context*/,
+                                        const core::PartitionMap& /*partitions*/,
+                                        messages::TrackExchange& /*exchange*/) {}
+    
+    /**
+     * @brief Reconcile local tracks with those exported by a peer partition
+     *
+     * Called exclusively for every exchange received from another
+     * partition. The default ignores them.
+     *
+     * @param context Algorithm execution context
+     * @param partitions Partition map of this process
+     * @param exchange Tracks exported by the peer
+     */
+    virtual void merge_peer_tracks(AlgorithmContext& /*context*/,
+                                   const core::PartitionMap& /*partitions*/,
+                                   const messages::TrackExchange& /*exchange*/) {}
+    
     /**
      * @brief Periodic update call (based on update_interval)
      * @param context Algorithm execution context
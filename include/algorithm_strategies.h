@@ -4,7 +4,9 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <utility>
 #include "target.h"
+#include "track_table.h"
 
 // Forward declarations
 namespace dp_aero_l2::fusion {
@@ -45,7 +47,21 @@ public:
      * @return Pointer to highest priority target, or nullptr if none
      */
     virtual Target* select_highest_priority_target(const std::vector<Target*>& targets,
-                                                  const fusion::AlgorithmContext& context) const = 0;    /**
+                                                  const fusion::AlgorithmContext& context) const = 0;
+    
+    /**
+     * @brief Select the highest priority row of a track table
+     * @param table Tracks to choose from
+     * @param context Algorithm context for additional data
+     * @return Row index, or TrackTable::npos if the table is empty
+     *
+     * The default scores each row through calculate_priority(); built-in
+     * prioritizers override it with loops over the table's columns.
+     */
+    virtual TrackTable::Index select_highest_priority_row(const TrackTable& table,
+                                                          const fusion::AlgorithmContext& context) const;
+    
+    /**
      * @brief Get prioritizer name for logging/debugging
      */
     virtual std::string get_name() const = 0;
@@ -101,6 +117,36 @@ public:
     virtual std::string get_name() const = 0;
 };
 
+/**
+ * @brief Gated association candidates for one sensor frame
+ *
+ * Entry i lists the (track, squared distance) pairs inside the gate of
+ * measurement i, as produced by TrackStore::find_within.
+ */
+using GatedCandidates = std::vector<std::vector<std::pair<Target*, float>>>;
+
+/**
+ * @brief Abstract interface for measurement-to-track association strategies
+ */
+class AssociationStrategy {
+public:
+    virtual ~AssociationStrategy() = default;
+    
+    /**
+     * @brief Assign the measurements of one sensor frame to tracks
+     * @param candidates Gated candidates per measurement (cost = squared distance)
+     * @param miss_cost Cost of leaving a measurement unassigned (typically gate^2)
+     * @return Track per measurement, or nullptr where a new track should be started
+     */
+    virtual std::vector<Target*> associate(const GatedCandidates& candidates,
+                                           float miss_cost) const = 0;
+    
+    /**
+     * @brief Get strategy name for logging/debugging
+     */
+    virtual std::string get_name() const = 0;
+};
+
 // ============================================================================
 // DEFAULT IMPLEMENTATIONS
 // ============================================================================
@@ -118,6 +164,9 @@ public:
     Target* select_highest_priority_target(const std::vector<Target*>& targets,
                                          const fusion::AlgorithmContext& context) const override;
     
+    TrackTable::Index select_highest_priority_row(const TrackTable& table,
+                                                  const fusion::AlgorithmContext& context) const override;
+    
     std::string get_name() const override { return "ConfidenceBasedPrioritizer"; }
 };
 
@@ -204,10 +253,44 @@ public:
     Target* select_highest_priority_target(const std::vector<Target*>& targets,
                                          const fusion::AlgorithmContext& context) const override;
     
+    TrackTable::Index select_highest_priority_row(const TrackTable& table,
+                                                  const fusion::AlgorithmContext& context) const override;
+    
     std::string get_name() const override { return "ThreatBasedPrioritizer"; }
     
     void set_parameters(const ThreatParameters& params) { params_ = params; }
     const ThreatParameters& get_parameters() const { return params_; }
 };
 
+/**
+ * @brief Greedy nearest-neighbour association (legacy behaviour)
+ *
+ * Each measurement independently takes its closest gated track, so several
+ * measurements of one frame may update the same track.
+ */
+class NearestNeighbourAssociation : public AssociationStrategy {
+public:
+    std::vector<Target*> associate(const GatedCandidates& candidates,
+                                   float miss_cost) const override;
+    
+    std::string get_name() const override { return "NearestNeighbourAssociation"; }
+};
+
+/**
+ * @brief Global nearest-neighbour association
+ *
+ * Finds the one-to-one assignment minimizing total squared distance plus
+ * miss_cost per unassigned measurement. The gating graph is split into
+ * connected components and each is solved with a shortest augmenting path
+ * (Jonker-Volgenant style) solver over sparse rows, so cost grows with
+ * cluster size rather than frame size.
+ */
+class GlobalNearestNeighbourAssociation : public AssociationStrategy {
+public:
+    std::vector<Target*> associate(const GatedCandidates& candidates,
+                                   float miss_cost) const override;
+    
+    std::string get_name() const override { return "GlobalNearestNeighbourAssociation"; }
+};
+
 } // namespace dp_aero_l2::algorithms
\ No newline at end of file
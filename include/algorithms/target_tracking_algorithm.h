@@ -1,12 +1,21 @@
 #pragma once
 
 #include "strategy_based_fusion_algorithm.h"
+#include "static_state_machine.h"
 #include "target.h"
+#include "sharded_track_store.h"
+#include "track_table.h"
+#include "point_cloud_clustering.h"
+#include "packed_point_cloud.h"
 #include <unordered_map>
 #include <vector>
 #include <cmath>
 #include <numeric>
+#include <optional>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <span>
 
 namespace dp_aero_l2::algorithms {
 
@@ -21,6 +30,23 @@ namespace dp_aero_l2::algorithms {
  * - ACQUIRING: Potential target detected, gathering more data
  * - TRACKING: Actively tracking confirmed target(s)
  * - LOST: Target lost, searching for reacquisition
+ *
+ * The states and their transitions are fixed, so they are a compile-time
+ * StaticStateMachine rather than the StateManager plugins build at run time.
+ *
+ * Messages are processed concurrently: tracks live in a ShardedTrackStore
+ * and each message only locks the shards around its measurements. Detection
+ * events are recorded and turned into state transitions by update().
+ *
+ * A batch of messages is associated under a single lock of the shards
+ * around all of its measurements, frame by frame in arrival order, so a
+ * burst pays for locking and buffer setup once.
+ *
+ * When L2 runs as several partitions, tracks a peer may also hold are
+ * exported to it. A local track matching a peer's is handed over if the
+ * peer owns it (it keeps being updated here but is no longer tasked or
+ * exported), and a peer's track entering this partition's sectors
+ * unmatched is adopted with its state.
  */
 class TargetTrackingAlgorithm : public fusion::StrategyBasedFusionAlgorithm {
 private:
@@ -36,11 +62,132 @@ private:
         std::chrono::seconds target_timeout{10};
         float position_noise = 0.1f;
         float velocity_alpha = 0.8f;   // Velocity smoothing factor
+        float association_gate = 5.0f; // Max measurement-to-track distance (m)
+        size_t processing_shards = 16;  // Track shards processed concurrently
+        float shard_region_size = 250.0f; // Side of the square regions mapped to shards (m)
+        std::chrono::milliseconds peer_track_hold{2000}; // A handed over track stays with the peer this long after its last exchange
+    };
+    
+    // Position measurement extracted from one sensor frame
+    struct Measurement {
+        float x, y, z;
+    };
+    
+    // Measurements of one sensor frame, as a range of the batch buffer
+    struct Frame {
+        core::NodeSymbol sensor;
+        float confidence_boost;
+        size_t first, last;
+    };
+    
+    // Per-thread buffers for the frames of a batch
+    struct BatchScratch {
+        std::vector<Measurement> measurements;
+        std::vector<Frame> frames;
+        GatedCandidates candidates;
+        std::vector<Target*> assignment;
+        bool radar_detections = false;
+        
+        void clear() {
+            measurements.clear();
+            frames.clear();
+            radar_detections = false;
+        }
+    };
+    
+    // Per-thread lidar clustering buffers (1 m link distance, objects need more than 10 points)
+    struct LidarScratch {
+        EuclideanClusterExtractor clusterer{1.0f, 11};
+        std::vector<float> points;
+        std::vector<PointCluster> clusters;
+    };
+    
+    // Algorithm states and the triggers between them
+    struct TrackingStates {
+        enum class State : uint8_t { IDLE, ACQUIRING, TRACKING, LOST, Count };
+        enum class Trigger : uint8_t { DETECTION, CONFIRMED, FALSE_POSITIVE, LOST, REACQUIRED, TIMEOUT, RESET, Count };
+        
+        static constexpr State initial = State::IDLE;
+        static constexpr std::array<std::string_view, 4> state_names = {"IDLE", "ACQUIRING", "TRACKING", "LOST"};
+        static constexpr std::array<std::string_view, 7> trigger_names = {
+            "detection", "confirmed", "false_positive", "lost", "reacquired", "timeout", "reset"};
+        static constexpr std::array<fusion::StaticTransition<State, Trigger>, 10> transitions = {{
+            {State::IDLE, Trigger::DETECTION, State::ACQUIRING},
+            {State::ACQUIRING, Trigger::CONFIRMED, State::TRACKING},
+            {State::ACQUIRING, Trigger::FALSE_POSITIVE, State::IDLE},
+            {State::TRACKING, Trigger::LOST, State::LOST},
+            {State::LOST, Trigger::REACQUIRED, State::TRACKING},
+            {State::LOST, Trigger::TIMEOUT, State::IDLE},
+            // Reset from any state
+            {State::IDLE, Trigger::RESET, State::IDLE},
+            {State::ACQUIRING, Trigger::RESET, State::IDLE},
+            {State::TRACKING, Trigger::RESET, State::IDLE},
+            {State::LOST, Trigger::RESET, State::IDLE},
+        }};
+    };
+    
+    using TrackingStateMachine = fusion::StaticStateMachine<TrackingStates>;
+    using TrackingState = TrackingStates::State;
+    using TrackingTrigger = TrackingStates::Trigger;
+    
+    // What each state does on entry and on every update
+    struct StateHooks {
+        TargetTrackingAlgorithm& algorithm;
+        
+        void on_enter(TrackingState state, fusion::AlgorithmContext& ctx) {
+            ctx.current_state_name = std::string(TrackingStateMachine::name(state));
+            algorithm.log_info("Entered " + ctx.current_state_name + " state");
+            switch (state) {
+                case TrackingState::IDLE:
+                    ctx.set_data<bool>("scanning", true);
+                    break;
+                case TrackingState::ACQUIRING:
+                    ctx.set_data<std::chrono::steady_clock::time_point>("acquisition_start",
+                        std::chrono::steady_clock::now());
+                    break;
+                case TrackingState::TRACKING:
+                    algorithm.send_gimbal_commands(ctx);
+                    break;
+                case TrackingState::LOST:
+                    ctx.set_data<std::chrono::steady_clock::time_point>("lost_start",
+                        std::chrono::steady_clock::now());
+                    break;
+                default:
+                    break;
+            }
+        }
+        
+        void on_update(TrackingState state, fusion::AlgorithmContext& ctx) {
+            switch (state) {
+                case TrackingState::IDLE:
+                    algorithm.scan_for_targets(ctx);  // Look for potential targets
+                    break;
+                case TrackingState::ACQUIRING:
+                    algorithm.evaluate_target_candidates(ctx);  // Gather more data on potential targets
+                    break;
+                case TrackingState::TRACKING:
+                    algorithm.update_tracking(ctx);  // Update target positions and send tracking commands
+                    break;
+                case TrackingState::LOST:
+                    algorithm.search_for_lost_targets(ctx);
+                    break;
+                default:
+                    break;
+            }
+        }
     };
     
     Parameters params_;
+    TrackingStateMachine tracking_state_;
     std::chrono::steady_clock::time_point last_status_time_{};  // Instance-specific timing
     
+    // Set by concurrent message processing, consumed by update()
+    std::atomic<bool> detection_pending_{false};
+    
+    // Tracks created by message processing, awaiting their task in update()
+    std::mutex new_targets_mutex_;
+    std::vector<std::string> new_targets_;
+    
 public:
     std::string get_name() const override {
         return "TargetTrackingAlgorithm";
@@ -58,11 +205,13 @@ public:
         setup_state_machine();
         
         // Set initial state
-        context.current_state_name = state_manager_.get_initial_state();
-        context.current_state = state_manager_.get_state(context.current_state_name);
+        tracking_state_.reset();
+        context.current_state_name = std::string(tracking_state_.state_name());
+        context.current_state = nullptr;
         
         // Initialize algorithm data
-        context.set_data<std::unordered_map<std::string, Target>>("targets", {});
+        context.emplace_data<ShardedTrackStore>("targets", params_.processing_shards,
+                                                params_.shard_region_size, params_.association_gate);
         context.set_data<int>("detection_count", 0);
         context.set_data<Parameters>("parameters", params_);
         
@@ -79,47 +228,137 @@ public:
         if (!get_device_assignment_strategy()) {
             set_device_assignment_strategy(std::make_unique<SingleDeviceAssignmentStrategy>(default_device_id));
         }
+        if (!get_association_strategy()) {
+            set_association_strategy(std::make_unique<GlobalNearestNeighbourAssociation>());
+        }
         
         // Enter initial state
-        if (context.current_state && context.current_state->on_enter) {
-            context.current_state->on_enter(context);
-        }
+        StateHooks{*this}.on_enter(tracking_state_.state(), context);
         
         log_info("TargetTrackingAlgorithm initialized in state: " + context.current_state_name);
     }
     
     void process_l1_message(fusion::AlgorithmContext& context, 
                            const messages::L1ToL2Message& message) override {
-        
-        // Store message in history
-        const std::string& node_id = message.sender().node_id();
-        context.latest_l1_messages[node_id] = message;
-        context.message_history[node_id].push_back(message);
-        
-        // Keep only recent messages (last 100)
-        if (context.message_history[node_id].size() > 100) {
-            context.message_history[node_id].erase(
-                context.message_history[node_id].begin(),
-                context.message_history[node_id].begin() + 50);
+        thread_local BatchScratch batch;
+        batch.clear();
+        collect_message(context, message, batch);
+        associate_frames(context, batch);
+    }
+    
+    void process_l1_batch(fusion::AlgorithmContext& context,
+                          std::span<const fusion::L1MessagePtr> messages) override {
+        thread_local BatchScratch batch;
+        batch.clear();
+        for (const auto& message : messages) {
+            collect_message(context, *message, batch);
         }
+        associate_frames(context, batch);
+    }
+    
+    bool supports_concurrent_processing() const override {
+        return true;
+    }
+    
+    void export_boundary_tracks(fusion::AlgorithmContext& context,
+                                const core::PartitionMap& partitions,
+                                messages::TrackExchange& exchange) override {
+        const auto* targets = track_store(context);
+        if (!targets) return;
         
-        // Process sensor data
-        if (message.has_sensor_data()) {
-            process_sensor_data(context, node_id, message.sensor_data());
+        const auto& params = parameters(context);
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto& [id, target] : *targets) {
+            // Handed over tracks are the peer's to report
+            if (held_by_peer(target, now) || target.confidence <= params.lost_threshold ||
+                !partitions.near_boundary(target.x, target.y)) {
+                continue;
+            }
+            
+            auto* track = exchange.add_tracks();
+            track->set_track_id(id);
+            track->set_x(target.x);
+            track->set_y(target.y);
+            track->set_z(target.z);
+            track->set_vx(target.vx);
+            track->set_vy(target.vy);
+            track->set_vz(target.vz);
+            track->set_confidence(target.confidence);
+            for (const auto& [sensor, count] : target.sensor_detections) {
+                track->add_sensor_ids(core::symbol_name(sensor));
+            }
+        }
+    }
+    
+    void merge_peer_tracks(fusion::AlgorithmContext& context,
+                           const core::PartitionMap& partitions,
+                           const messages::TrackExchange& exchange) override {
+        auto* targets = track_store(context);
+        if (!targets) return;
+        
+        const auto& params = parameters(context);
+        const float gate = params.association_gate;
+        const size_t peer = exchange.partition();
+        const auto now = std::chrono::steady_clock::now();
+        std::vector<std::pair<Target*, float>> candidates;
+        size_t handed_over = 0;
+        size_t adopted = 0;
+        
+        for (const auto& track : exchange.tracks()) {
+            // Peer coordinates index the shards and spatial grids; never let non-finite ones in
+            if (!finite(track.x(), track.y(), track.z()) || !finite(track.vx(), track.vy(), track.vz()) ||
+                !std::isfinite(track.confidence())) {
+                continue;
+            }
+            auto region = targets->lock(targets->shards_near(track.x(), track.y(), gate));
+            region.find_within(track.x(), track.y(), track.z(), gate, candidates);
+            
+            if (!candidates.empty()) {
+                Target& local = *std::min_element(candidates.begin(), candidates.end(),
+                    [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+                if (partitions.track_owner(local.x, local.y, track.x(), track.y(), peer) == peer) {
+                    if (!held_by_peer(local, now)) {
+                        ++handed_over;
+                    }
+                    local.peer_owned_until = now + params.peer_track_hold;
+                }
+            } else if (partitions.scheme() == core::PartitionScheme::Sector &&
+                       partitions.partition_of_position(track.x(), track.y()) == partitions.index()) {
+                // Entered our airspace before our own sensors picked it up
+                Target& target = create_target(context, region, {track.x(), track.y(), track.z()});
+                target.vx = track.vx();
+                target.vy = track.vy();
+                target.vz = track.vz();
+                target.confidence = track.confidence();
+                target.last_update = now;
+                for (const auto& sensor_id : track.sensor_ids()) {
+                    target.sensor_detections[core::intern_node(sensor_id)] = 1;
+                }
+                ++adopted;
+            }
         }
         
-        // Process capability advertisements
-        if (message.has_capability()) {
-            process_capability_advertisement(context, node_id, message.capability());
+        if (adopted > 0) {
+            detection_pending_ = true;
+        }
+        if (handed_over > 0 || adopted > 0) {
+            log_info("Partition " + std::to_string(peer) + ": handed over " + std::to_string(handed_over) +
+                     " tracks, adopted " + std::to_string(adopted));
         }
     }
     
     void update(fusion::AlgorithmContext& context) override {
-        // Update current state
-        if (context.current_state && context.current_state->on_update) {
-            context.current_state->on_update(context);
+        // Task the tracks created since the last update
+        assign_new_targets(context);
+        
+        // Apply detections reported by message processing since the last update
+        if (detection_pending_.exchange(false)) {
+            handle_trigger(context, "target_detected");
         }
         
+        // Update current state
+        tracking_state_.update(StateHooks{*this}, context);
+        
         // Update all active tasks
         update_all_tasks(context);
         
@@ -139,9 +378,11 @@ public:
         
         if (trigger_name == "reset") {
             log_info("Resetting algorithm");
-            context.set_data<std::unordered_map<std::string, Target>>("targets", {});
+            if (auto* targets = track_store(context)) {
+                targets->clear();
+            }
             context.set_data<int>("detection_count", 0);
-            trigger_transition(context, "reset");
+            fire(context, TrackingTrigger::RESET);
             
         } else if (trigger_name == "node_timeout") {
             std::string node_id;
@@ -154,14 +395,16 @@ public:
             }
             
         } else if (trigger_name == "target_detected") {
-            trigger_transition(context, "detection");
+            fire(context, TrackingTrigger::DETECTION);
             
         } else if (trigger_name == "target_lost") {
-            trigger_transition(context, "lost");
+            fire(context, TrackingTrigger::LOST);
             
         } else {
             // Try to trigger state transition
-            trigger_transition(context, trigger_name);
+            if (auto trigger = TrackingStateMachine::parse_trigger(trigger_name)) {
+                fire(context, *trigger);
+            }
         }
     }
     
@@ -185,195 +428,109 @@ public:
 
 protected:
     void setup_state_machine() override {
-        // Create states
-        auto idle_state = std::make_shared<fusion::State>("IDLE");
-        idle_state->on_enter = [this](fusion::AlgorithmContext& ctx) {
-            log_info("Entered IDLE state");
-            ctx.set_data<bool>("scanning", true);
-        };
-        idle_state->on_update = [this](fusion::AlgorithmContext& ctx) {
-            // Look for potential targets
-            scan_for_targets(ctx);
-        };
-        
-        auto acquiring_state = std::make_shared<fusion::State>("ACQUIRING");
-        acquiring_state->on_enter = [this](fusion::AlgorithmContext& ctx) {
-            log_info("Entered ACQUIRING state");
-            ctx.set_data<std::chrono::steady_clock::time_point>("acquisition_start", 
-                std::chrono::steady_clock::now());
-        };
-        acquiring_state->on_update = [this](fusion::AlgorithmContext& ctx) {
-            // Gather more data on potential targets
-            evaluate_target_candidates(ctx);
-        };
-        
-        auto tracking_state = std::make_shared<fusion::State>("TRACKING");
-        tracking_state->on_enter = [this](fusion::AlgorithmContext& ctx) {
-            log_info("Entered TRACKING state");
-            send_gimbal_commands(ctx);
-        };
-        tracking_state->on_update = [this](fusion::AlgorithmContext& ctx) {
-            // Update target positions and send tracking commands
-            update_tracking(ctx);
-        };
-        
-        auto lost_state = std::make_shared<fusion::State>("LOST");
-        lost_state->on_enter = [this](fusion::AlgorithmContext& ctx) {
-            log_info("Entered LOST state");
-            ctx.set_data<std::chrono::steady_clock::time_point>("lost_start", 
-                std::chrono::steady_clock::now());
-        };
-        lost_state->on_update = [this](fusion::AlgorithmContext& ctx) {
-            // Search for lost targets
-            search_for_lost_targets(ctx);
-        };
-        
-        // Add states to state machine
-        add_state("IDLE", idle_state);
-        add_state("ACQUIRING", acquiring_state);
-        add_state("TRACKING", tracking_state);
-        add_state("LOST", lost_state);
-        
-        // Set initial state
-        set_initial_state("IDLE");
-        
-        // Define transitions
-        add_transition(fusion::Transition("IDLE", "ACQUIRING", "detection"));
-        add_transition(fusion::Transition("ACQUIRING", "TRACKING", "confirmed"));
-        add_transition(fusion::Transition("ACQUIRING", "IDLE", "false_positive"));
-        add_transition(fusion::Transition("TRACKING", "LOST", "lost"));
-        add_transition(fusion::Transition("LOST", "TRACKING", "reacquired"));
-        add_transition(fusion::Transition("LOST", "IDLE", "timeout"));
-        
-        // Add reset transitions from any state
-        add_transition(fusion::Transition("IDLE", "IDLE", "reset"));
-        add_transition(fusion::Transition("ACQUIRING", "IDLE", "reset"));
-        add_transition(fusion::Transition("TRACKING", "IDLE", "reset"));
-        add_transition(fusion::Transition("LOST", "IDLE", "reset"));
+        // The states are compile-time (TrackingStates); the StateManager stays empty
     }
 
 private:
+    bool fire(fusion::AlgorithmContext& context, TrackingTrigger trigger) {
+        return tracking_state_.fire(trigger, StateHooks{*this}, context);
+    }
+    
+    /**
+     * @brief Handle one message, appending its measurements to the batch
+     *
+     * History and latest-message bookkeeping is done by the ingest path
+     * (AlgorithmContext::add_message_to_history), which shares the parsed
+     * message instead of copying it here. The message must outlive the batch.
+     */
+    void collect_message(fusion::AlgorithmContext& context,
+                         const messages::L1ToL2Message& message, BatchScratch& batch) {
+        const std::string& node_id = message.sender().node_id();
+        
+        // Process sensor data
+        if (message.has_sensor_data()) {
+            process_sensor_data(context, node_id, message.sensor_data(), batch);
+        }
+        
+        // Process capability advertisements
+        if (message.has_capability()) {
+            process_capability_advertisement(context, node_id, message.capability());
+        }
+    }
+    
     void process_sensor_data(fusion::AlgorithmContext& context, 
                            const std::string& node_id,
-                           const data_streams::SensorData& sensor_data) {
+                           const data_streams::SensorData& sensor_data,
+                           BatchScratch& batch) {
         
         // Extract detection information based on sensor type
         if (sensor_data.has_radar()) {
-            process_radar_detections(context, node_id, sensor_data.radar());
+            process_radar_detections(node_id, sensor_data.radar(), batch);
         } else if (sensor_data.has_lidar()) {
-            process_lidar_data(context, node_id, sensor_data.lidar());
+            process_lidar_data(node_id, sensor_data.lidar(), batch);
         } else if (sensor_data.has_image()) {
             process_image_data(context, node_id, sensor_data.image());
         }
     }
     
-    void process_radar_detections(fusion::AlgorithmContext& context,
-                                 const std::string& node_id,
-                                 const data_streams::RadarData& radar_data) {
-        
-        auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-        if (!targets_opt) return;
-        
-        auto targets = *targets_opt;
+    void process_radar_detections(const std::string& node_id,
+                                 const data_streams::RadarData& radar_data,
+                                 BatchScratch& batch) {
         
+        const size_t first = batch.measurements.size();
         for (const auto& detection : radar_data.detections()) {
             if (detection.rcs() > 0.1f) {  // Filter small objects
                 // Convert polar to cartesian
                 float x = detection.range() * std::cos(detection.azimuth()) * std::cos(detection.elevation());
                 float y = detection.range() * std::sin(detection.azimuth()) * std::cos(detection.elevation());
                 float z = detection.range() * std::sin(detection.elevation());
-                
-                // Find or create target
-                std::string target_id = find_closest_target(targets, x, y, z);
-                if (target_id.empty()) {
-                    target_id = "target_" + std::to_string(targets.size());
-                    targets[target_id] = Target(target_id);
-                    
-                    // Create task for new target and assign using strategy
-                    std::string task_id = create_task_for_target(target_id, fusion::Task::Type::TRACK_TARGET, fusion::Task::Priority::HIGH);
-                    
-                    // Use device assignment strategy to select device
-                    if (get_device_assignment_strategy()) {
-                        std::string assigned_device = get_device_assignment_strategy()->select_device_for_target(
-                            targets[target_id], get_task_manager(), context);
-                        if (!assigned_device.empty()) {
-                            assign_task_to_device(task_id, assigned_device);
-                            log_info("Created tracking task " + task_id + " for new target " + target_id + 
-                                   " assigned to device " + assigned_device);
-                        } else {
-                            log_warning("No suitable device found for target " + target_id);
-                        }
-                    }
+                if (finite(x, y, z)) {
+                    batch.measurements.push_back({x, y, z});
                 }
-                
-                // Update target
-                update_target_position(targets[target_id], x, y, z, 0.8f, node_id);
             }
         }
         
-        context.set_data("targets", targets);
+        add_frame(batch, node_id, 0.8f, first);
         
-        if (!targets.empty()) {
-            handle_trigger(context, "target_detected");
+        // State transitions are left to update(), which runs exclusively
+        if (batch.measurements.size() > first) {
+            batch.radar_detections = true;
         }
     }
     
-    void process_lidar_data(fusion::AlgorithmContext& context,
-                           const std::string& node_id,
-                           const data_streams::LidarData& lidar_data) {
-        // Simple clustering algorithm for object detection
-        // This is a simplified example - real implementation would be more sophisticated
-        
-        auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-        if (!targets_opt) return;
-        
-        auto targets = *targets_opt;
-        
-        // Basic clustering - group points that are close together
-        std::vector<std::vector<data_streams::LidarData::Point>> clusters;
-        cluster_lidar_points(lidar_data.points(), clusters, 1.0f); // 1m cluster distance
-        
-        for (const auto& cluster : clusters) {
-            if (cluster.size() > 10) {  // Minimum points for object
-                // Calculate cluster centroid
-                float x = 0, y = 0, z = 0;
-                for (const auto& point : cluster) {
-                    x += point.x();
-                    y += point.y();
-                    z += point.z();
-                }
-                x /= cluster.size();
-                y /= cluster.size();
-                z /= cluster.size();
-                
-                // Find or create target
-                std::string target_id = find_closest_target(targets, x, y, z);
-                if (target_id.empty()) {
-                    target_id = "target_" + std::to_string(targets.size());
-                    targets[target_id] = Target(target_id);
-                    
-                    // Create task for new target and assign using strategy
-                    std::string task_id = create_task_for_target(target_id, fusion::Task::Type::TRACK_TARGET, fusion::Task::Priority::HIGH);
-                    
-                    // Use device assignment strategy to select device
-                    if (get_device_assignment_strategy()) {
-                        std::string assigned_device = get_device_assignment_strategy()->select_device_for_target(
-                            targets[target_id], get_task_manager(), context);
-                        if (!assigned_device.empty()) {
-                            assign_task_to_device(task_id, assigned_device);
-                            log_info("Created tracking task " + task_id + " for new target " + target_id + 
-                                   " assigned to device " + assigned_device);
-                        } else {
-                            log_warning("No suitable device found for target " + target_id);
-                        }
-                    }
-                }
-                
-                update_target_position(targets[target_id], x, y, z, 0.6f, node_id);
+    void process_lidar_data(const std::string& node_id,
+                           const data_streams::LidarData& lidar_data,
+                           BatchScratch& batch) {
+        // Flatten to x, y, z, intensity (packed scans decode straight into the
+        // buffer) and extract object clusters
+        thread_local LidarScratch scratch;
+        size_t num_points = 0;
+        if (!lidar_data.packed_points().empty()) {
+            num_points = packed_point_cloud::unpack(lidar_data.packed_points(), scratch.points);
+        } else {
+            scratch.points.clear();
+            scratch.points.reserve(static_cast<size_t>(lidar_data.points_size()) * 4);
+            for (const auto& point : lidar_data.points()) {
+                scratch.points.insert(scratch.points.end(), {point.x(), point.y(), point.z(), point.intensity()});
             }
+            num_points = lidar_data.points_size();
+        }
+        scratch.clusterer.extract(scratch.points.data(), num_points, packed_point_cloud::kFloatsPerPoint,
+                                  scratch.clusters);
+        
+        const size_t first = batch.measurements.size();
+        for (const auto& cluster : scratch.clusters) {
+            batch.measurements.push_back({cluster.x, cluster.y, cluster.z});
         }
         
-        context.set_data("targets", targets);
+        add_frame(batch, node_id, 0.6f, first);
+    }
+    
+    void add_frame(BatchScratch& batch, const std::string& sensor_id,
+                   float confidence_boost, size_t first) {
+        if (batch.measurements.size() > first) {
+            batch.frames.push_back({core::intern_node(sensor_id), confidence_boost, first, batch.measurements.size()});
+        }
     }
     
     void process_image_data(fusion::AlgorithmContext& context,
@@ -404,14 +561,13 @@ private:
     }
     
     void evaluate_target_candidates(fusion::AlgorithmContext& context) {
-        auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-        if (!targets_opt) return;
+        auto* targets = track_store(context);
+        if (!targets) return;
         
-        auto targets = *targets_opt;
-        auto params = context.get_data<Parameters>("parameters").value_or(params_);
+        const auto& params = parameters(context);
         
         bool confirmed_target = false;
-        for (auto& [id, target] : targets) {
+        for (auto& [id, target] : *targets) {
             if (target.confidence > params.acquisition_threshold && 
                 target.sensor_detections.size() >= params.min_sensor_consensus) {
                 target.confidence = std::min(1.0f, target.confidence + 0.1f);
@@ -422,24 +578,25 @@ private:
             }
         }
         
-        context.set_data("targets", targets);
-        
         if (confirmed_target) {
             handle_trigger(context, "confirmed");
         }
     }
     
     void update_tracking(fusion::AlgorithmContext& context) {
-        auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-        if (!targets_opt) return;
+        auto* targets = track_store(context);
+        if (!targets) return;
         
-        auto targets = *targets_opt;
-        auto params = context.get_data<Parameters>("parameters").value_or(params_);
+        const auto& params = parameters(context);
         
         bool has_valid_targets = false;
         auto now = std::chrono::steady_clock::now();
         
-        for (auto& [id, target] : targets) {
+        for (auto& [id, target] : *targets) {
+            if (held_by_peer(target, now)) {
+                continue;
+            }
+            
             // Check if target is still valid
             if (now - target.last_update > params.target_timeout) {
                 target.confidence *= 0.9f;  // Decay confidence
@@ -451,8 +608,6 @@ private:
             }
         }
         
-        context.set_data("targets", targets);
-        
         if (!has_valid_targets) {
             handle_trigger(context, "lost");
         }
@@ -471,33 +626,29 @@ private:
     
     void update_target_tracking(fusion::AlgorithmContext& context) {
         // Prediction and update cycle for all targets
-        auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-        if (!targets_opt) return;
+        auto* targets = track_store(context);
+        if (!targets) return;
         
-        auto targets = *targets_opt;
-        auto params = context.get_data<Parameters>("parameters").value_or(params_);
+        const auto& params = parameters(context);
         
         // Remove old targets
         auto now = std::chrono::steady_clock::now();
-        std::erase_if(targets, [&](const auto& target_pair) {
-            bool should_remove = now - target_pair.second.last_update > params.target_timeout * 2;
+        targets->erase_if([&](const std::string& id, const Target& target) {
+            bool should_remove = now - target.last_update > params.target_timeout * 2;
             if (should_remove) {
-                log_info("Removing old target: " + target_pair.first);
+                log_info("Removing old target: " + id);
             }
             return should_remove;
         });
-        
-        context.set_data("targets", targets);
     }
     
     void check_state_transitions(fusion::AlgorithmContext& context) {
-        auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-        if (!targets_opt) return;
+        const auto* targets = track_store(context);
+        if (!targets) return;
         
-        auto targets = *targets_opt;
         int detection_count = 0;
         
-        for (const auto& [id, target] : targets) {
+        for (const auto& [id, target] : *targets) {
             if (target.confidence > 0.3f) {
                 detection_count++;
             }
@@ -512,43 +663,46 @@ private:
         
         if (last_status_time_ == std::chrono::steady_clock::time_point{} || 
             now - last_status_time_ > std::chrono::seconds(5)) {
-            auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-            if (targets_opt) {
-                send_fusion_results(context, *targets_opt);
+            if (const auto* targets = track_store(context)) {
+                send_fusion_results(context, *targets);
             }
             last_status_time_ = now;
         }
     }
     
     void send_gimbal_commands(fusion::AlgorithmContext& context) {
-        auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-        if (!targets_opt) return;
-        
-        auto targets = *targets_opt;
-        
-        // Convert to vector of pointers for prioritizer
-        std::vector<Target*> target_pointers;
-        for (auto& [id, target] : targets) {
-            target_pointers.push_back(&target);
+        auto* targets = track_store(context);
+        if (!targets) return;
+        
+        // Load the tracks into a table for the prioritizer, leaving out tracks a peer partition owns
+        const auto now = std::chrono::steady_clock::now();
+        TrackTable table;
+        table.reserve(targets->size());
+        for (const auto& [id, target] : *targets) {
+            if (!held_by_peer(target, now)) {
+                table.add(target);
+            }
         }
         
         // Use target prioritizer to select highest priority target (thread-safe)
-        Target* best_target = nullptr;
-        if (!target_pointers.empty()) {
+        TrackTable::Index best_row = TrackTable::npos;
+        if (!table.empty()) {
             try {
-                best_target = with_target_prioritizer([&](const auto& prioritizer) {
+                best_row = with_target_prioritizer([&](const auto& prioritizer) {
                     log_info("Selected target using " + prioritizer.get_name() + " prioritizer");
-                    return prioritizer.select_highest_priority_target(target_pointers, context);
+                    return prioritizer.select_highest_priority_row(table, context);
                 });
             } catch (const std::runtime_error&) {
                 // Fallback to first target if no prioritizer
-                best_target = target_pointers[0];
+                best_row = 0;
                 log_warning("No target prioritizer available, using first target");
             }
         }
         
-        if (best_target) {
-            send_gimbal_command_for_target(context, *best_target);
+        if (best_row != TrackTable::npos) {
+            if (const Target* best_target = targets->find(table.id_of(best_row))) {
+                send_gimbal_command_for_target(context, *best_target);
+            }
         }
     }
     
@@ -583,7 +737,7 @@ private:
     }
     
     void send_fusion_results(fusion::AlgorithmContext& context, 
-                            const std::unordered_map<std::string, Target>& targets) {
+                            const ShardedTrackStore& targets) {
         messages::L2ToL1Message result_msg;
         result_msg.set_message_id("fusion_result_" + std::to_string(
             std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -607,44 +761,166 @@ private:
     
     void handle_node_timeout(fusion::AlgorithmContext& context, const std::string& node_id) {
         // Handle node timeout - might affect target confidence
-        auto targets_opt = context.get_data<std::unordered_map<std::string, Target>>("targets");
-        if (!targets_opt) return;
+        auto* targets = track_store(context);
+        const auto node = core::SymbolTable<core::NodeTag>::global().find(node_id);
+        if (!targets || !node) return;
         
-        auto targets = *targets_opt;
-        
-        for (auto& [id, target] : targets) {
-            if (target.sensor_detections.count(node_id) > 0) {
+        for (auto& [id, target] : *targets) {
+            if (target.sensor_detections.erase(node) > 0) {
                 target.confidence *= 0.8f;  // Reduce confidence for targets detected by timed-out node
-                target.sensor_detections.erase(node_id);
             }
         }
-        
-        context.set_data("targets", targets);
     }
     
     // Helper functions
-    std::string find_closest_target(const std::unordered_map<std::string, Target>& targets,
-                                   float x, float y, float z, float max_distance = 5.0f) {
-        std::string closest_id;
-        float min_distance = max_distance;
-        
-        for (const auto& [id, target] : targets) {
-            float dx = target.x - x;
-            float dy = target.y - y;
-            float dz = target.z - z;
-            float distance = std::sqrt(dx*dx + dy*dy + dz*dz);
-            
-            if (distance < min_distance) {
-                min_distance = distance;
-                closest_id = id;
+    static bool finite(float x, float y, float z) {
+        return std::isfinite(x) && std::isfinite(y) && std::isfinite(z);
+    }
+    
+    static bool held_by_peer(const Target& target, std::chrono::steady_clock::time_point now) {
+        return now < target.peer_owned_until;
+    }
+    
+    ShardedTrackStore* track_store(fusion::AlgorithmContext& context) {
+        return context.get_data_ptr<ShardedTrackStore>("targets");
+    }
+    
+    const ShardedTrackStore* track_store(const fusion::AlgorithmContext& context) const {
+        return context.get_data_ptr<ShardedTrackStore>("targets");
+    }
+    
+    const Parameters& parameters(const fusion::AlgorithmContext& context) const {
+        const auto* params = context.get_data_ptr<Parameters>("parameters");
+        return params ? *params : params_;
+    }
+    
+    /**
+     * @brief Associate the collected frames in order and update tracks
+     *
+     * Each frame locks the shards within the gate of its measurements, so
+     * workers handling disjoint regions run in parallel and tracks can only
+     * move between locked shards (an updated track lies between its old
+     * position and the measurement). Consecutive frames whose shards are
+     * already locked reuse the lock. Within a frame, gated candidates come
+     * from the shards' spatial indexes and the association strategy resolves
+     * conflicts so that no two measurements update the same track.
+     * Unassigned measurements start new tracks at their position.
+     */
+    void associate_frames(fusion::AlgorithmContext& context, BatchScratch& batch) {
+        if (batch.frames.empty()) return;
+        
+        auto* targets = track_store(context);
+        if (!targets) return;
+        
+        const float gate = parameters(context).association_gate;
+        std::optional<ShardedTrackStore::Lock> region;
+        for (const auto& frame : batch.frames) {
+            ShardedTrackStore::ShardMask shards = 0;
+            for (size_t i = frame.first; i < frame.last; ++i) {
+                shards |= targets->shards_near(batch.measurements[i].x, batch.measurements[i].y, gate);
             }
+            if (!region || (shards & ~region->mask()) != 0) {
+                region.reset();
+                region.emplace(targets->lock(shards));
+            }
+            associate_frame(context, *region, batch, frame, gate);
         }
         
-        return closest_id;
+        if (batch.radar_detections) {
+            detection_pending_ = true;
+        }
+    }
+    
+    void associate_frame(fusion::AlgorithmContext& context, ShardedTrackStore::Lock& region,
+                         BatchScratch& batch, const Frame& frame, float gate) {
+        const std::span<const Measurement> measurements(batch.measurements.data() + frame.first,
+                                                        frame.last - frame.first);
+        
+        auto& candidates = batch.candidates;
+        candidates.resize(measurements.size());
+        for (size_t i = 0; i < measurements.size(); ++i) {
+            const auto& m = measurements[i];
+            region.find_within(m.x, m.y, m.z, gate, candidates[i]);
+        }
+        
+        try {
+            batch.assignment = with_association_strategy([&](const auto& strategy) {
+                return strategy.associate(candidates, gate * gate);
+            });
+        } catch (const std::runtime_error&) {
+            batch.assignment = NearestNeighbourAssociation().associate(candidates, gate * gate);
+        }
+        
+        for (size_t i = 0; i < measurements.size(); ++i) {
+            const auto& m = measurements[i];
+            Target* target = batch.assignment[i];
+            if (!target) {
+                target = &create_target(context, region, m);
+            }
+            
+            update_target_position(*target, m.x, m.y, m.z, frame.confidence_boost, frame.sensor);
+            region.relocate(*target);
+        }
+    }
+    
+    Target& create_target(fusion::AlgorithmContext& context, ShardedTrackStore::Lock& region,
+                          const Measurement& m) {
+        Target& target = region.create(m.x, m.y, m.z);
+        
+        // Tasks and device assignment touch shared state, so they are left
+        // to update(); a new target gets its task and gimbal command without
+        // waiting for the next tick
+        {
+            std::lock_guard<std::mutex> lock(new_targets_mutex_);
+            new_targets_.push_back(target.target_id);
+        }
+        context.request_update();
+        
+        return target;
+    }
+    
+    /**
+     * @brief Create and assign a tracking task for each track created since the last update
+     */
+    void assign_new_targets(fusion::AlgorithmContext& context) {
+        std::vector<std::string> created;
+        {
+            std::lock_guard<std::mutex> lock(new_targets_mutex_);
+            created.swap(new_targets_);
+        }
+        
+        auto* targets = track_store(context);
+        if (!targets) return;
+        
+        for (const auto& target_id : created) {
+            // Removed (e.g. by a reset) before it could be tasked
+            const Target* target = targets->find(target_id);
+            if (!target) continue;
+            
+            std::string task_id = create_task_for_target(target_id, fusion::Task::Type::TRACK_TARGET, fusion::Task::Priority::HIGH);
+            
+            // Use device assignment strategy to select device
+            std::string assigned_device;
+            try {
+                assigned_device = with_device_assignment_strategy([&](auto& strategy) {
+                    return strategy.select_device_for_target(*target, get_task_manager(), context);
+                });
+            } catch (const std::runtime_error&) {
+                continue;  // No device assignment strategy
+            }
+            
+            if (!assigned_device.empty()) {
+                assign_task_to_device(task_id, assigned_device);
+                log_info("Created tracking task " + task_id + " for new target " + target_id + 
+                       " assigned to device " + assigned_device);
+            } else {
+                log_warning("No suitable device found for target " + target_id);
+            }
+        }
     }
     
     void update_target_position(Target& target, float x, float y, float z, 
-                               float confidence_boost, const std::string& sensor_id) {
+                               float confidence_boost, core::NodeSymbol sensor) {
         auto now = std::chrono::steady_clock::now();
         
         // Simple position filtering
@@ -669,50 +945,10 @@ private:
         
         target.confidence = std::min(1.0f, target.confidence + confidence_boost);
         target.last_update = now;
-        target.sensor_detections[sensor_id]++;
-    }
-    
-    void cluster_lidar_points(const google::protobuf::RepeatedPtrField<data_streams::LidarData::Point>& points,
-                             std::vector<std::vector<data_streams::LidarData::Point>>& clusters,
-                             float cluster_distance) {
-        // Simple clustering algorithm
-        std::vector<bool> visited(points.size(), false);
-        
-        for (int i = 0; i < points.size(); ++i) {
-            if (visited[i]) continue;
-            
-            std::vector<data_streams::LidarData::Point> cluster;
-            std::queue<int> to_visit;
-            to_visit.push(i);
-            visited[i] = true;
-            
-            while (!to_visit.empty()) {
-                int current = to_visit.front();
-                to_visit.pop();
-                cluster.push_back(points[current]);
-                
-                for (int j = 0; j < points.size(); ++j) {
-                    if (visited[j]) continue;
-                    
-                    float dx = points[current].x() - points[j].x();
-                    float dy = points[current].y() - points[j].y();
-                    float dz = points[current].z() - points[j].z();
-                    float distance = std::sqrt(dx*dx + dy*dy + dz*dz);
-                    
-                    if (distance < cluster_distance) {
-                        visited[j] = true;
-                        to_visit.push(j);
-                    }
-                }
-            }
-            
-            if (cluster.size() > 5) {  // Minimum cluster size
-                clusters.push_back(cluster);
-            }
-        }
+        target.sensor_detections[sensor]++;
     }
     
-    float calculate_overall_confidence(const std::unordered_map<std::string, Target>& targets) {
+    float calculate_overall_confidence(const ShardedTrackStore& targets) {
         if (targets.empty()) return 0.0f;
         
         float total_confidence = std::accumulate(targets.begin(), targets.end(), 0.0f,
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <google/protobuf/arena.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief Parses protobuf messages into pooled, recyclable arenas
+ *
+ * Messages are parsed into the current arena and handed out as
+ * shared_ptr<const T> that share ownership of that arena, so a message is
+ * allocated once and every later holder (queue, context, history) only
+ * bumps a reference count. After a batch of messages (or bytes) the pool
+ * moves on to a fresh arena; an arena is Reset() and returned to the pool
+ * once its last message is released.
+ *
+ * Each arena owns a fixed initial block that survives Reset(), so in
+ * steady state parsing a message needs no heap allocation at all. Messages
+ * retained for a long time (e.g. in history) keep their whole arena alive.
+ *
+ * parse() may be called from any thread and only holds the pool's lock
+ * while picking an arena, not while parsing; handles may be released from
+ * any thread, including after the pool itself is destroyed.
+ */
+template<typename T>
+class ArenaMessagePool {
+public:
+    using Ptr = std::shared_ptr<const T>;
+
+    struct Options {
+        size_t messages_per_arena = 64;          // Batch size before moving to a new arena
+        size_t max_arena_bytes = 4 * 1024 * 1024; // Also move on once an arena grows past this
+        size_t initial_block_bytes = 64 * 1024;  // Reused across resets
+        size_t max_pooled_arenas = 16;           // Idle arenas kept for reuse
+    };
+
+    struct Stats {
+        uint64_t messages_parsed;
+        uint64_t arenas_created;
+        uint64_t arenas_recycled;
+    };
+
+private:
+    struct PooledArena {
+        std::unique_ptr<char[]> initial_block;
+        google::protobuf::Arena arena;
+        size_t messages = 0;
+
+        explicit PooledArena(size_t initial_block_bytes)
+            : initial_block(new char[initial_block_bytes]),
+              arena(initial_block.get(), initial_block_bytes) {}
+    };
+
+    // Outlives the pool while any handed-out message is alive
+    struct Shared {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<PooledArena>> idle;
+        size_t max_pooled = 0;
+        std::atomic<uint64_t> arenas_created{0};
+        std::atomic<uint64_t> arenas_recycled{0};
+    };
+
+    Options options_;
+    std::shared_ptr<Shared> shared_;
+
+    std::mutex current_mutex_;
+    std::shared_ptr<PooledArena> current_;
+    std::atomic<uint64_t> messages_parsed_{0};
+
+public:
+    explicit ArenaMessagePool(Options options = Options{})
+        : options_(options), shared_(std::make_shared<Shared>()) {
+        shared_->max_pooled = options_.max_pooled_arenas;
+    }
+
+    ArenaMessagePool(const ArenaMessagePool&) = delete;
+    ArenaMessagePool& operator=(const ArenaMessagePool&) = delete;
+
+    /**
+     * @brief Parse a serialized message into the current arena
+     * @return Message sharing ownership of its arena, or nullptr if parsing failed
+     */
+    Ptr parse(const void* data, size_t size) {
+        // Only choosing the arena is serialized; Arena allocation is thread-safe,
+        // so concurrent parses into the same arena run in parallel
+        std::shared_ptr<PooledArena> arena;
+        {
+            std::lock_guard<std::mutex> lock(current_mutex_);
+            if (!current_ || current_->messages >= options_.messages_per_arena ||
+                current_->arena.SpaceAllocated() >= options_.max_arena_bytes) {
+                current_ = acquire();
+            }
+            ++current_->messages;
+            arena = current_;
+        }
+
+        T* message = google::protobuf::Arena::CreateMessage<T>(&arena->arena);
+        if (!message->ParseFromArray(data, static_cast<int>(size))) {
+            return nullptr;
+        }
+
+        messages_parsed_++;
+        return Ptr(std::move(arena), message);
+    }
+
+    Stats get_stats() const {
+        return Stats{
+            .messages_parsed = messages_parsed_.load(),
+            .arenas_created = shared_->arenas_created.load(),
+            .arenas_recycled = shared_->arenas_recycled.load()
+        };
+    }
+
+private:
+    std::shared_ptr<PooledArena> acquire() {
+        std::unique_ptr<PooledArena> arena;
+        {
+            std::lock_guard<std::mutex> lock(shared_->mutex);
+            if (!shared_->idle.empty()) {
+                arena = std::move(shared_->idle.back());
+                shared_->idle.pop_back();
+            }
+        }
+        if (!arena) {
+            arena = std::make_unique<PooledArena>(options_.initial_block_bytes);
+            shared_->arenas_created++;
+        }
+
+        // Recycle instead of delete when the last message is released
+        return std::shared_ptr<PooledArena>(arena.release(), [shared = shared_](PooledArena* released) {
+            released->arena.Reset();
+            released->messages = 0;
+            shared->arenas_recycled++;
+
+            std::unique_ptr<PooledArena> owned(released);
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            if (shared->idle.size() < shared->max_pooled) {
+                shared->idle.push_back(std::move(owned));
+            }
+        });
+    }
+};
+
+} // namespace dp_aero_l2::core
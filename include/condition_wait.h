@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief Block on a condition variable until ready() holds
+ *
+ * Equivalent to cv.wait(lock, ready). The untimed wait is a GLIBCXX_3.4.30
+ * symbol, which the older libstdc++ bundled with some protobuf
+ * distributions lacks (see BUILD_INSTRUCTIONS.md), so this waits in
+ * bounded slices instead. Notifications still wake it at once.
+ */
+template<typename Predicate>
+void wait_until_ready(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, Predicate ready) {
+    while (!cv.wait_for(lock, std::chrono::milliseconds(100), ready)) {
+    }
+}
+
+} // namespace dp_aero_l2::core
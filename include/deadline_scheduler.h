@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief Tick timing of one DeadlineScheduler task
+ *
+ * Jitter is how long after its deadline a tick started, over the most
+ * recent DeadlineScheduler::kJitterSamples ticks.
+ */
+struct TickStats {
+    std::string name;
+    uint64_t ticks = 0;      // Runs on the task's cadence
+    uint64_t triggered = 0;  // Extra runs requested through trigger()
+    uint64_t missed = 0;     // Ticks skipped because the scheduler fell a whole interval behind
+    std::chrono::microseconds jitter_p50{0};
+    std::chrono::microseconds jitter_p99{0};
+    std::chrono::microseconds jitter_max{0};
+};
+
+/**
+ * @brief Runs periodic tasks on one thread at fixed, drift-free deadlines
+ *
+ * Each task's next deadline is its previous deadline plus its interval, so
+ * run time and wake-up latency do not accumulate into the cadence. A task
+ * that falls a whole interval behind skips the ticks it missed instead of
+ * running them back to back. trigger() runs a task as soon as the thread
+ * is free without moving its cadence, and stop() wakes the thread at once.
+ *
+ * Tasks are registered before start() and run one at a time; they must
+ * not throw.
+ */
+class DeadlineScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TaskId = size_t;
+
+    static constexpr size_t kJitterSamples = 1024;
+
+    DeadlineScheduler() = default;
+    DeadlineScheduler(const DeadlineScheduler&) = delete;
+    DeadlineScheduler& operator=(const DeadlineScheduler&) = delete;
+
+    ~DeadlineScheduler() {
+        stop();
+    }
+
+    /**
+     * @brief Register a task to run every interval, the first time one interval after start()
+     */
+    TaskId add_periodic(std::string name, Clock::duration interval, std::function<void()> run) {
+        if (interval <= Clock::duration::zero()) {
+            throw std::invalid_argument("Task " + name + " needs a positive interval");
+        }
+        std::lock_guard lock(mutex_);
+        if (thread_.joinable()) {
+            throw std::logic_error("Cannot add tasks while the scheduler is running");
+        }
+        tasks_.push_back(Task{.name = std::move(name), .interval = interval, .run = std::move(run)});
+        return tasks_.size() - 1;
+    }
+
+    void start() {
+        std::lock_guard lock(mutex_);
+        if (thread_.joinable()) {
+            return;
+        }
+        const auto now = Clock::now();
+        for (auto& task : tasks_) {
+            task.deadline = now + task.interval;
+            task.trigger_pending = false;
+        }
+        stopping_ = false;
+        thread_ = std::thread(&DeadlineScheduler::run, this);
+    }
+
+    /**
+     * @brief Wake the thread and wait for the task running now, if any, to finish
+     */
+    void stop() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    /**
+     * @brief Run a task as soon as possible, in addition to its ticks
+     *
+     * Triggers made before the task gets to run coalesce into one run.
+     */
+    void trigger(TaskId id) {
+        {
+            std::lock_guard lock(mutex_);
+            if (tasks_.at(id).trigger_pending) {
+                return;
+            }
+            tasks_[id].trigger_pending = true;
+        }
+        wake_.notify_all();
+    }
+
+    std::vector<TickStats> stats() const {
+        std::lock_guard lock(mutex_);
+        std::vector<TickStats> stats;
+        for (const auto& task : tasks_) {
+            TickStats task_stats{.name = task.name, .ticks = task.ticks, .triggered = task.triggered,
+                                 .missed = task.missed};
+            const size_t samples = std::min<uint64_t>(task.ticks, kJitterSamples);
+            if (samples > 0) {
+                std::vector<int64_t> jitter(task.jitter_us.begin(), task.jitter_us.begin() + samples);
+                std::sort(jitter.begin(), jitter.end());
+                task_stats.jitter_p50 = std::chrono::microseconds(jitter[(samples - 1) / 2]);
+                task_stats.jitter_p99 = std::chrono::microseconds(jitter[(samples - 1) * 99 / 100]);
+                task_stats.jitter_max = std::chrono::microseconds(jitter.back());
+            }
+            stats.push_back(std::move(task_stats));
+        }
+        return stats;
+    }
+
+private:
+    struct Task {
+        std::string name;
+        Clock::duration interval;
+        std::function<void()> run;
+        Clock::time_point deadline{};
+        bool trigger_pending = false;
+        uint64_t ticks = 0;
+        uint64_t triggered = 0;
+        uint64_t missed = 0;
+        std::array<int64_t, kJitterSamples> jitter_us{};  // Ring of the latest ticks' jitter
+    };
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::vector<Task> tasks_;
+    std::thread thread_;
+
+    void run() {
+        std::unique_lock lock(mutex_);
+        while (!stopping_) {
+            if (tasks_.empty()) {
+                wake_.wait_for(lock, std::chrono::seconds(1));
+                continue;
+            }
+
+            // Triggered tasks first, then the earliest deadline
+            Task* next = &tasks_.front();
+            for (auto& task : tasks_) {
+                if (task.trigger_pending) {
+                    next = &task;
+                    break;
+                }
+                if (task.deadline < next->deadline) {
+                    next = &task;
+                }
+            }
+
+            const auto now = Clock::now();
+            if (next->trigger_pending) {
+                next->trigger_pending = false;
+                ++next->triggered;
+            } else if (now < next->deadline) {
+                wake_.wait_until(lock, next->deadline);
+                continue;
+            } else {
+                const auto behind = now - next->deadline;
+                if (behind >= next->interval) {
+                    const auto skipped = behind / next->interval;
+                    next->missed += static_cast<uint64_t>(skipped);
+                    next->deadline += skipped * next->interval;
+                }
+                const auto jitter = std::chrono::duration_cast<std::chrono::microseconds>(now - next->deadline);
+                next->jitter_us[next->ticks % kJitterSamples] = jitter.count();
+                ++next->ticks;
+                next->deadline += next->interval;
+            }
+
+            // Tasks are only added while stopped, so the reference stays valid
+            auto& run = next->run;
+            lock.unlock();
+            run();
+            lock.lock();
+        }
+    }
+};
+
+} // namespace dp_aero_l2::core
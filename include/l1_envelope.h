@@ -0,0 +1,130 @@
+#pragma once
+
+#include "messages/l1_to_l2.pb.h"
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief Routing fields of a serialized L1ToL2Message, read without decoding it
+ *
+ * Views point into the serialized buffer and are valid as long as it is.
+ * sender and payload are the serialized NodeIdentity and payload
+ * sub-message, for callers that only need one of them decoded.
+ */
+struct L1Envelope {
+    std::string_view node_id;   // sender.node_id
+    std::string_view sender;    // Serialized sender (NodeIdentity)
+    std::string_view payload;   // Serialized payload sub-message
+    messages::L1ToL2Message::PayloadCase payload_case = messages::L1ToL2Message::PAYLOAD_NOT_SET;
+    data_streams::SensorData::DataTypeCase sensor_case = data_streams::SensorData::DATA_TYPE_NOT_SET;
+    int32_t sequence_number = 0;
+};
+
+namespace envelope_detail {
+
+using google::protobuf::internal::WireFormatLite;
+
+inline std::string_view view_of(std::string_view buffer, const google::protobuf::io::CodedInputStream& input,
+                                uint32_t length) {
+    return buffer.substr(static_cast<size_t>(input.CurrentPosition()), length);
+}
+
+// Number of the last length-delimited field numbered within [first, last],
+// with its view in out; 0 if there is none or the buffer is malformed
+inline uint32_t find_field(std::string_view buffer, uint32_t first, uint32_t last, std::string_view* out) {
+    google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(buffer.data()),
+                                                 static_cast<int>(buffer.size()));
+    uint32_t found = 0;
+    while (uint32_t tag = input.ReadTag()) {
+        const uint32_t field = WireFormatLite::GetTagFieldNumber(tag);
+        if (field >= first && field <= last &&
+            WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+            uint32_t length = 0;
+            if (!input.ReadVarint32(&length) || length > buffer.size() - input.CurrentPosition()) {
+                return 0;
+            }
+            if (out) {
+                *out = view_of(buffer, input, length);
+            }
+            found = field;  // Later occurrences win, as when parsing
+            input.Skip(static_cast<int>(length));
+        } else if (!WireFormatLite::SkipField(&input, tag)) {
+            return 0;
+        }
+    }
+    return input.CurrentPosition() == static_cast<int>(buffer.size()) ? found : 0;
+}
+
+} // namespace envelope_detail
+
+/**
+ * @brief Read the envelope of a serialized L1ToL2Message
+ *
+ * Walks the top-level fields and skips over the payload, so the cost
+ * depends on the number of fields rather than the payload size. For
+ * sensor data only the first level of SensorData is read, to get the
+ * sensor type.
+ *
+ * @return The envelope, or nullopt if the buffer is not a well-formed message
+ */
+inline std::optional<L1Envelope> peek_l1_envelope(std::string_view buffer) {
+    using envelope_detail::WireFormatLite;
+    constexpr uint32_t kSenderField = messages::L1ToL2Message::kSenderFieldNumber;
+    constexpr uint32_t kFirstPayloadField = messages::L1ToL2Message::kSensorDataFieldNumber;
+    constexpr uint32_t kLastPayloadField = messages::L1ToL2Message::kCapabilityFieldNumber;
+    constexpr uint32_t kSequenceField = messages::L1ToL2Message::kSequenceNumberFieldNumber;
+
+    L1Envelope envelope;
+    google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t*>(buffer.data()),
+                                                 static_cast<int>(buffer.size()));
+    while (uint32_t tag = input.ReadTag()) {
+        const uint32_t field = WireFormatLite::GetTagFieldNumber(tag);
+        const auto wire_type = WireFormatLite::GetTagWireType(tag);
+
+        if (wire_type == WireFormatLite::WIRETYPE_LENGTH_DELIMITED &&
+            (field == kSenderField || (field >= kFirstPayloadField && field <= kLastPayloadField))) {
+            uint32_t length = 0;
+            if (!input.ReadVarint32(&length) || length > buffer.size() - input.CurrentPosition()) {
+                return std::nullopt;
+            }
+            const auto view = envelope_detail::view_of(buffer, input, length);
+            if (field == kSenderField) {
+                envelope.sender = view;
+            } else {
+                envelope.payload = view;
+                envelope.payload_case = static_cast<messages::L1ToL2Message::PayloadCase>(field);
+            }
+            input.Skip(static_cast<int>(length));
+        } else if (field == kSequenceField && wire_type == WireFormatLite::WIRETYPE_VARINT) {
+            uint32_t sequence = 0;
+            if (!input.ReadVarint32(&sequence)) {
+                return std::nullopt;
+            }
+            envelope.sequence_number = static_cast<int32_t>(sequence);
+        } else if (!WireFormatLite::SkipField(&input, tag)) {
+            return std::nullopt;
+        }
+    }
+    if (input.CurrentPosition() != static_cast<int>(buffer.size())) {
+        return std::nullopt;  // Stopped at a malformed tag
+    }
+
+    if (!envelope.sender.empty() &&
+        envelope_detail::find_field(envelope.sender, common::NodeIdentity::kNodeIdFieldNumber,
+                                    common::NodeIdentity::kNodeIdFieldNumber, &envelope.node_id) == 0) {
+        envelope.node_id = {};
+    }
+    if (envelope.payload_case == messages::L1ToL2Message::kSensorData) {
+        envelope.sensor_case = static_cast<data_streams::SensorData::DataTypeCase>(
+            envelope_detail::find_field(envelope.payload, data_streams::SensorData::kImageFieldNumber,
+                                        data_streams::SensorData::kRawDataFieldNumber, nullptr));
+    }
+    return envelope;
+}
+
+} // namespace dp_aero_l2::core
@@ -2,146 +2,158 @@
 
 #include "algorithm_framework.h"
 #include "redis_utils.h"
+#include "arena_message_pool.h"
+#include "deadline_scheduler.h"
+#include "l1_envelope.h"
+#include "mpmc_queue.h"
+#include "node_registry.h"
+#include "partition_map.h"
+#include "sequence_tracker.h"
+#include "weighted_fair_queue.h"
+#include <algorithm>
+#include <array>
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
-#include <condition_variable>
-#include <queue>
+#include <unordered_map>
 #include <unordered_set>
+#include <unistd.h>
 
 namespace dp_aero_l2::core {
 
+/**
+ * @brief How L1 messages reach the L2 system
+ */
+enum class IngestMode {
+    PubSub,  // Fire-and-forget Pub/Sub on l1_to_l2_topic
+    Stream   // Consumer group on l1_to_l2_stream: acknowledged after processing, replayed after a restart
+};
+
+/**
+ * @brief One class of ingest traffic with its own slice of the ingest queue
+ *
+ * A message belongs to the first class listing its payload type (or, for
+ * sensor data, its sensor type); the last class takes everything else.
+ */
+struct IngestClassConfig {
+    std::string name{};
+    std::vector<messages::L1ToL2Message::PayloadCase> payload_types{};
+    std::vector<data_streams::SensorData::DataTypeCase> sensor_types{};
+    float queue_share = 0.0f;                  // Fraction of message_queue_size
+    uint32_t weight = 1;                       // Dequeue share while classes compete
+    std::optional<OverflowPolicy> overflow{};  // Default: message_queue_overflow
+};
+
+/**
+ * @brief Ingest classes that keep radar and node capabilities flowing while bulk sensor data is shed
+ */
+inline std::vector<IngestClassConfig> default_ingest_classes() {
+    using Sensor = data_streams::SensorData;
+    return {
+        {.name = "control", .payload_types = {messages::L1ToL2Message::kCapability}, .queue_share = 0.1f, .weight = 4},
+        {.name = "radar", .sensor_types = {Sensor::kRadar}, .queue_share = 0.3f, .weight = 8},
+        {.name = "navigation", .sensor_types = {Sensor::kImu, Sensor::kGps}, .queue_share = 0.1f, .weight = 4},
+        {.name = "lidar", .sensor_types = {Sensor::kLidar}, .queue_share = 0.3f, .weight = 2},
+        {.name = "bulk", .queue_share = 0.2f, .weight = 1, .overflow = OverflowPolicy::DropNewest},
+    };
+}
+
 /**
  * @brief Configuration for L2 fusion system
  */
 struct L2Config {
     std::string redis_connection = "tcp://127.0.0.1:6379";
+    size_t redis_pool_size = 4;  // Pooled connections shared by publisher, heartbeat and queue calls
     std::string l1_to_l2_topic = "l1_to_l2";
     std::string l2_to_l1_topic = "l2_to_l1";
     std::string heartbeat_topic = "l2_heartbeat";
     
-    // Node management
+    // Stream ingest: L2 processes sharing stream_group split the stream
+    // between them. The consumer name must be unique per process and stable
+    // across restarts (empty: "l2_<hostname>")
+    IngestMode ingest_mode = IngestMode::PubSub;
+    std::string l1_to_l2_stream = "l1_to_l2_stream";
+    std::string stream_group = "l2_fusion";
+    std::string stream_consumer;
+    size_t stream_read_count = 64;                       // Entries per XREADGROUP
+    std::chrono::milliseconds stream_block_timeout{200};
+    std::chrono::milliseconds stream_claim_idle{30000};  // Take over other consumers' entries pending this long
+    
+    // Partitioning: several L2 processes split the L1 nodes (and, with the
+    // Sector scheme, the airspace) between them. Each ingests only its own
+    // partition's topic or stream ("<name>.p<index>") and exchanges the tracks
+    // near its boundaries with the others on boundary_exchange_topic
+    PartitionMap partitions;
+    std::string boundary_exchange_topic = "l2_boundary_tracks";
+    std::chrono::milliseconds boundary_exchange_interval{500};
+    
+    // Node management. Node ids are interned for good once a sender has
+    // identified itself, so at most max_l1_nodes distinct ids are admitted;
+    // messages from further unknown ids are rejected
     std::chrono::seconds node_timeout{30};
     std::chrono::seconds heartbeat_interval{5};
+    size_t max_l1_nodes = 4096;
     
     // Algorithm configuration
     std::string algorithm_name = "default";
     std::chrono::milliseconds algorithm_update_interval{100};
     
+    // Message history: the most recent history_depth messages of each node,
+    // dropped after history_retention (0: kept until overwritten). With
+    // history_summaries_only, only each message's summary is kept
+    size_t history_depth = 100;
+    std::chrono::milliseconds history_retention{0};
+    bool history_summaries_only = false;
+    
     // Threading
     size_t worker_threads = 2;
     size_t message_queue_size = 1000;
+    OverflowPolicy message_queue_overflow = OverflowPolicy::DropOldest;  // Stream ingest always blocks
     
-    // Logging
-    bool enable_debug_logging = false;
-    std::string log_level = "INFO";
-};
-
-/**
- * @brief Node registry for tracking L1 nodes
- */
-class NodeRegistry {
-private:
-    mutable std::shared_mutex mutex_;
-    std::unordered_map<std::string, common::NodeIdentity> nodes_;
-    std::unordered_map<std::string, std::chrono::steady_clock::time_point> last_seen_;
-    std::unordered_map<std::string, common::NodeStatus> node_status_;
-    
-public:
-    void register_node(const common::NodeIdentity& node) {
-        std::unique_lock lock(mutex_);
-        nodes_[node.node_id()] = node;
-        last_seen_[node.node_id()] = std::chrono::steady_clock::now();
-    }
-    
-    void update_node_heartbeat(const std::string& node_id) {
-        std::unique_lock lock(mutex_);
-        last_seen_[node_id] = std::chrono::steady_clock::now();
-    }
+    // The ingest queue is split into these classes, each bounded and
+    // dropping on its own, and workers dequeue them by weight. Empty: one
+    // FIFO class of message_queue_size
+    std::vector<IngestClassConfig> ingest_classes = default_ingest_classes();
     
-    void update_node_status(const std::string& node_id, const common::NodeStatus& status) {
-        std::unique_lock lock(mutex_);
-        node_status_[node_id] = status;
-        last_seen_[node_id] = std::chrono::steady_clock::now();
-    }
+    // Ordering: each node's messages go to one worker, so they are processed
+    // in the order received (the ingest queue is split between the workers).
+    // Sequence gaps, duplicates, late arrivals and restarts are counted; with
+    // drop_duplicates, messages already seen are dropped. Late arrivals are
+    // always kept: they are new data, e.g. stream entries claimed from a
+    // dead consumer. A node restarting its numbering close to its last
+    // number looks like duplicates, so only enable this for senders that
+    // never restart
+    bool ordered_per_node = true;
+    bool drop_duplicates = false;
+    size_t worker_batch_size = 32;  // Messages a worker dequeues and hands to process_l1_batch at once
     
-    std::vector<std::string> get_active_nodes(std::chrono::seconds timeout) const {
-        std::shared_lock lock(mutex_);
-        std::vector<std::string> active_nodes;
-        auto now = std::chrono::steady_clock::now();
-        
-        for (const auto& [node_id, last_seen] : last_seen_) {
-            if (now - last_seen < timeout) {
-                active_nodes.push_back(node_id);
-            }
-        }
-        return active_nodes;
-    }
-    
-    std::vector<std::string> get_timed_out_nodes(std::chrono::seconds timeout) const {
-        std::shared_lock lock(mutex_);
-        std::vector<std::string> timed_out_nodes;
-        auto now = std::chrono::steady_clock::now();
-        
-        for (const auto& [node_id, last_seen] : last_seen_) {
-            if (now - last_seen >= timeout) {
-                timed_out_nodes.push_back(node_id);
-            }
-        }
-        return timed_out_nodes;
-    }
+    // Ingest: inbound messages are parsed into pooled arenas, this many per arena
+    size_t ingest_messages_per_arena = 64;
+    size_t ingest_arena_block_bytes = 64 * 1024;
     
-    std::optional<common::NodeIdentity> get_node(const std::string& node_id) const {
-        std::shared_lock lock(mutex_);
-        auto it = nodes_.find(node_id);
-        return (it != nodes_.end()) ? std::make_optional(it->second) : std::nullopt;
-    }
+    // Pub/Sub ingest: queue the received payloads as they are and leave
+    // parsing and node bookkeeping to the workers, so the subscription
+    // thread only reads from the socket
+    bool defer_parsing = false;
     
-    std::vector<common::NodeIdentity> get_all_nodes() const {
-        std::shared_lock lock(mutex_);
-        std::vector<common::NodeIdentity> all_nodes;
-        for (const auto& [id, node] : nodes_) {
-            all_nodes.push_back(node);
-        }
-        return all_nodes;
-    }
+    // Load shedding: once the ingest queue is shed_queue_fraction full,
+    // sensor data of these types is dropped after reading its envelope,
+    // before it is parsed. Heartbeats and node status are never shed
+    std::vector<data_streams::SensorData::DataTypeCase> shed_sensor_types = {
+        data_streams::SensorData::kImage, data_streams::SensorData::kRawData};
+    float shed_queue_fraction = 0.75f;
     
-    void remove_node(const std::string& node_id) {
-        std::unique_lock lock(mutex_);
-        nodes_.erase(node_id);
-        last_seen_.erase(node_id);
-        node_status_.erase(node_id);
-    }
+    // Publishing: outputs are coalesced into pipelines of up to this many
+    // messages, each waiting at most publish_max_delay for its batch to fill
+    size_t publish_batch_size = 64;
+    std::chrono::microseconds publish_max_delay{500};
+    size_t publish_queue_size = 4096;
     
-    /**
-     * @brief Atomically check and remove timed-out nodes
-     * @param timeout Timeout duration
-     * @return List of node IDs that were actually removed
-     */
-    std::vector<std::string> check_and_remove_timed_out_nodes(std::chrono::seconds timeout) {
-        std::unique_lock lock(mutex_);
-        std::vector<std::string> removed_nodes;
-        auto now = std::chrono::steady_clock::now();
-        
-        // Find timed-out nodes
-        auto it = last_seen_.begin();
-        while (it != last_seen_.end()) {
-            if (now - it->second >= timeout) {
-                const std::string& node_id = it->first;
-                removed_nodes.push_back(node_id);
-                
-                // Remove from all maps
-                nodes_.erase(node_id);
-                node_status_.erase(node_id);
-                it = last_seen_.erase(it);  // erase returns next iterator
-            } else {
-                ++it;
-            }
-        }
-        
-        return removed_nodes;
-    }
+    // Logging
+    bool enable_debug_logging = false;
+    std::string log_level = "INFO";
 };
 
 /**
@@ -151,6 +163,7 @@ class L2FusionManager {
 private:
     L2Config config_;
     std::unique_ptr<redis_utils::RedisMessenger> redis_messenger_;
+    std::unique_ptr<redis_utils::PipelinedPublisher> publisher_;
     std::unique_ptr<fusion::FusionAlgorithm> algorithm_;
     fusion::AlgorithmContext algorithm_context_;
     NodeRegistry node_registry_;
@@ -159,30 +172,91 @@ private:
     std::atomic<bool> running_{false};
     std::atomic<bool> subscription_running_{false};
     std::vector<std::thread> worker_threads_;
-    std::thread algorithm_thread_;
-    std::thread heartbeat_thread_;
-    std::thread node_monitor_thread_;
     std::thread subscription_thread_;
+    std::thread exchange_subscription_thread_;
+    
+    // Algorithm updates and boundary exchange take the context lock, so they
+    // get their own scheduler; heartbeats and node timeouts never wait behind them
+    DeadlineScheduler algorithm_scheduler_;
+    DeadlineScheduler::TaskId update_task_ = 0;
+    DeadlineScheduler scheduler_;
     
-    // Message queue
-    std::queue<messages::L1ToL2Message> message_queue_;
-    mutable std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
+    // Ingest arenas and classed message queues (queued messages are shared,
+    // not copied), one per worker with ordered_per_node. With defer_parsing,
+    // received payloads wait in payload_queues_ instead
+    ArenaMessagePool<messages::L1ToL2Message> ingest_pool_;
+    std::vector<QueueClassOptions> ingest_classes_;
+    std::array<size_t, messages::L1ToL2Message::kCapability + 1> class_of_payload_{};
+    std::array<size_t, data_streams::SensorData::kRawData + 1> class_of_sensor_{};
+    std::vector<std::unique_ptr<WeightedFairQueue<fusion::L1MessagePtr>>> message_queues_;
+    std::vector<std::unique_ptr<WeightedFairQueue<std::string>>> payload_queues_;
+    SequenceTracker sequences_;
     
     // Algorithm synchronization
+    // Workers hold context_mutex_ shared while the algorithm supports
+    // concurrent processing; everything else holds it exclusively
     mutable std::shared_mutex algorithm_mutex_;
-    mutable std::mutex context_mutex_;
+    mutable std::shared_mutex context_mutex_;
+    std::mutex history_mutex_;  // Serializes workers appending to the history under a shared context lock
+    
+    // Stream ingest: entry id of each queued message, acknowledged once processed
+    std::string stream_consumer_;
+    std::mutex stream_ids_mutex_;
+    std::unordered_map<const messages::L1ToL2Message*, std::string> stream_ids_;
+    
+    // Ingest topic and stream of this process's partition
+    std::string ingest_topic_;
+    std::string ingest_stream_;
+    
+    // Queue depth from which low-priority sensor data is shed
+    size_t shed_threshold_;
     
     // Statistics
     std::atomic<uint64_t> messages_processed_{0};
     std::atomic<uint64_t> messages_sent_{0};
+    std::atomic<uint64_t> messages_acked_{0};
+    std::atomic<uint64_t> boundary_tracks_sent_{0};
+    std::atomic<uint64_t> peer_tracks_received_{0};
+    std::atomic<uint64_t> messages_shed_{0};
+    std::atomic<uint64_t> nodes_rejected_{0};
+    std::atomic<uint64_t> bytes_received_{0};
+    std::atomic<uint64_t> bytes_parsed_{0};
     std::atomic<uint64_t> message_counter_{0};  // Instance-specific message counter
     std::chrono::steady_clock::time_point start_time_;
     
 public:
     explicit L2FusionManager(const L2Config& config = L2Config{})
-        : config_(config), start_time_(std::chrono::steady_clock::now()) {
-        redis_messenger_ = std::make_unique<redis_utils::RedisMessenger>(config_.redis_connection);
+        : config_(config),
+          ingest_pool_(ArenaMessagePool<messages::L1ToL2Message>::Options{
+              .messages_per_arena = config.ingest_messages_per_arena,
+              .initial_block_bytes = config.ingest_arena_block_bytes}),
+          ingest_classes_(make_ingest_classes(config)),
+          ingest_topic_(config.partitions.channel(config.l1_to_l2_topic)),
+          ingest_stream_(config.partitions.channel(config.l1_to_l2_stream)),
+          shed_threshold_(static_cast<size_t>(config.shed_queue_fraction *
+                                              static_cast<float>(config.message_queue_size))),
+          start_time_(std::chrono::steady_clock::now()) {
+        map_ingest_classes();
+        schedule_periodic_tasks();
+        algorithm_context_.max_history_per_node = config_.history_depth;
+        algorithm_context_.history_retention = config_.history_retention;
+        algorithm_context_.history_summaries_only = config_.history_summaries_only;
+        for (size_t lane = 0; lane < ingest_lanes(config_); ++lane) {
+            message_queues_.push_back(std::make_unique<WeightedFairQueue<fusion::L1MessagePtr>>(ingest_classes_));
+            if (defers_parsing(config_)) {
+                payload_queues_.push_back(std::make_unique<WeightedFairQueue<std::string>>(ingest_classes_));
+            }
+        }
+        redis_messenger_ = std::make_unique<redis_utils::RedisMessenger>(config_.redis_connection,
+                                                                   config_.redis_pool_size);
+        publisher_ = std::make_unique<redis_utils::PipelinedPublisher>(
+            [messenger = redis_messenger_.get()](std::span<const redis_utils::OutboundMessage> batch) {
+                messenger->publish_batch(batch);
+            },
+            redis_utils::PipelinedPublisher::Options{
+                .max_batch = config.publish_batch_size,
+                .max_delay = config.publish_max_delay,
+                .queue_capacity = config.publish_queue_size});
     }
     
     ~L2FusionManager() {
@@ -213,30 +287,41 @@ public:
         }
         
         running_ = true;
+        for (auto& queue : message_queues_) {
+            queue->reopen();
+        }
+        for (auto& queue : payload_queues_) {
+            queue->reopen();
+        }
         
         // Initialize algorithm
         {
             std::unique_lock algorithm_lock(algorithm_mutex_);
-            std::lock_guard<std::mutex> context_lock(context_mutex_);
+            std::unique_lock context_lock(context_mutex_);
             algorithm_->initialize(algorithm_context_);
         }
         
         // Start worker threads
         for (size_t i = 0; i < config_.worker_threads; ++i) {
-            worker_threads_.emplace_back(&L2FusionManager::worker_thread_func, this);
+            worker_threads_.emplace_back(&L2FusionManager::worker_thread_func, this, i % message_queues_.size());
         }
         
-        // Start algorithm thread
-        algorithm_thread_ = std::thread(&L2FusionManager::algorithm_thread_func, this);
-        
-        // Start heartbeat thread
-        heartbeat_thread_ = std::thread(&L2FusionManager::heartbeat_thread_func, this);
+        // Start periodic tasks; the first heartbeat goes out right away
+        send_heartbeat();
+        scheduler_.start();
+        algorithm_scheduler_.start();
         
-        // Start node monitor thread
-        node_monitor_thread_ = std::thread(&L2FusionManager::node_monitor_thread_func, this);
+        // Start Redis ingest
+        if (config_.ingest_mode == IngestMode::Stream) {
+            start_stream_ingest();
+        } else {
+            start_redis_subscription();
+        }
         
-        // Start Redis subscription
-        start_redis_subscription();
+        // Start boundary track exchange with the other partitions
+        if (config_.partitions.partitioned()) {
+            start_boundary_exchange();
+        }
         
         log_info("L2 Fusion Manager started with algorithm: " + algorithm_->get_name());
     }
@@ -251,7 +336,12 @@ public:
         
         running_ = false;
         subscription_running_ = false;
-        queue_cv_.notify_all();
+        for (auto& queue : message_queues_) {
+            queue->close();
+        }
+        for (auto& queue : payload_queues_) {
+            queue->close();
+        }
         
         // Wait for all threads to complete
         for (auto& thread : worker_threads_) {
@@ -260,40 +350,55 @@ public:
             }
         }
         
-        if (algorithm_thread_.joinable()) {
-            algorithm_thread_.join();
-        }
+        algorithm_scheduler_.stop();
+        scheduler_.stop();
         
-        if (heartbeat_thread_.joinable()) {
-            heartbeat_thread_.join();
+        if (subscription_thread_.joinable()) {
+            subscription_thread_.join();
         }
         
-        if (node_monitor_thread_.joinable()) {
-            node_monitor_thread_.join();
+        if (exchange_subscription_thread_.joinable()) {
+            exchange_subscription_thread_.join();
         }
         
-        if (subscription_thread_.joinable()) {
-            subscription_thread_.join();
+        // Stream entries still queued stay pending in Redis and are replayed
+        // on restart, so drop their queued copies
+        if (config_.ingest_mode == IngestMode::Stream) {
+            std::vector<fusion::L1MessagePtr> unprocessed;
+            for (auto& queue : message_queues_) {
+                queue->try_pop_batch(unprocessed, queue->capacity());
+            }
+            std::lock_guard lock(stream_ids_mutex_);
+            stream_ids_.clear();
         }
         
         // Shutdown algorithm
         {
             std::unique_lock algorithm_lock(algorithm_mutex_);
-            std::lock_guard<std::mutex> context_lock(context_mutex_);
+            std::unique_lock context_lock(context_mutex_);
             if (algorithm_) {
                 algorithm_->shutdown(algorithm_context_);
             }
         }
         
+        // Outputs still queued go out before stop() returns
+        publisher_->flush();
+        
         log_info("L2 Fusion Manager stopped");
     }
     
     /**
      * @brief Send message to specific L1 node or broadcast
+     *
+     * Serializes on the calling thread and queues the message for the
+     * pipelined publisher, which sends it with the next batch.
      */
     void send_to_l1(const messages::L2ToL1Message& message) {
         try {
-            redis_messenger_->publish(config_.l2_to_l1_topic, message);
+            if (!publisher_->publish(config_.l2_to_l1_topic, message)) {
+                log_warning("Publish queue full, dropped message to L1");
+                return;
+            }
             messages_sent_++;
             
             std::string target = message.target_node_id().empty() ? "BROADCAST" : message.target_node_id();
@@ -310,6 +415,18 @@ public:
     struct SystemStats {
         uint64_t messages_processed;
         uint64_t messages_sent;
+        uint64_t messages_dropped;
+        uint64_t messages_acked;  // Stream entries acknowledged
+        uint64_t boundary_tracks_sent;   // Tracks exported to peer partitions
+        uint64_t peer_tracks_received;   // Tracks merged from peer partitions
+        uint64_t messages_shed;          // Sensor data dropped unparsed under load
+        uint64_t nodes_rejected;         // Messages from unidentified or excess node ids
+        uint64_t bytes_received;         // Serialized L1 messages received
+        uint64_t bytes_parsed;           // Of which fully deserialized
+        std::vector<QueueClassStats> ingest_classes;  // Summed over the workers' queues
+        SequenceStats sequence;
+        std::vector<TickStats> ticks;  // Periodic tasks: cadence jitter and triggered runs
+        redis_utils::PipelinedPublisher::Stats publisher;
         size_t active_nodes;
         std::chrono::seconds uptime;
         std::string current_algorithm_state;
@@ -321,19 +438,49 @@ public:
         
         std::string current_state;
         {
-            std::lock_guard<std::mutex> context_lock(context_mutex_);
+            std::shared_lock context_lock(context_mutex_);
             current_state = algorithm_context_.current_state_name;
         }
         
         return SystemStats{
             .messages_processed = messages_processed_.load(),
             .messages_sent = messages_sent_.load(),
-            .active_nodes = node_registry_.get_active_nodes(config_.node_timeout).size(),
+            .messages_dropped = dropped_count(message_queues_) + dropped_count(payload_queues_),
+            .messages_acked = messages_acked_.load(),
+            .boundary_tracks_sent = boundary_tracks_sent_.load(),
+            .peer_tracks_received = peer_tracks_received_.load(),
+            .messages_shed = messages_shed_.load(),
+            .nodes_rejected = nodes_rejected_.load(),
+            .bytes_received = bytes_received_.load(),
+            .bytes_parsed = bytes_parsed_.load(),
+            .ingest_classes = defers_parsing(config_) ? class_stats(payload_queues_) : class_stats(message_queues_),
+            .sequence = sequences_.stats(),
+            .ticks = tick_stats(),
+            .publisher = publisher_->get_stats(),
+            .active_nodes = node_registry_.count_active_nodes(config_.node_timeout),
             .uptime = uptime,
             .current_algorithm_state = current_state
         };
     }
     
+    /**
+     * @brief Ingest one serialized L1 message the way the subscription does
+     *
+     * For messages arriving other than through Redis, e.g. replayed from a
+     * recording. Node bookkeeping happens right away.
+     *
+     * @return True if the message was queued for the algorithm
+     */
+    bool ingest_l1_message(std::string_view payload) {
+        auto message = ingest_payload(payload, ingest_depth());
+        if (!message) {
+            return false;
+        }
+        auto& queue = *message_queues_[lane_of(message->sender().node_id())];
+        const size_t ingest_class = ingest_class_of(*message);
+        return enqueue(queue, ingest_class, std::move(message));
+    }
+    
     /**
      * @brief Get node registry (read-only access)
      */
@@ -346,7 +493,7 @@ public:
      */
     void trigger_algorithm_event(const std::string& trigger_name, const std::any& data = {}) {
         std::shared_lock algorithm_lock(algorithm_mutex_);
-        std::lock_guard<std::mutex> context_lock(context_mutex_);
+        std::unique_lock context_lock(context_mutex_);
         if (algorithm_) {
             algorithm_->handle_trigger(algorithm_context_, trigger_name, data);
         }
@@ -357,11 +504,31 @@ private:
         subscription_running_ = true;
         subscription_thread_ = std::thread([this]() {
             try {
-                redis_messenger_->subscribe<messages::L1ToL2Message>(
-                    config_.l1_to_l2_topic,
-                    [this](const messages::L1ToL2Message& message) {
+                if (defers_parsing(config_)) {
+                    redis_messenger_->subscribe_owned(
+                        ingest_topic_,
+                        [this](std::string&& payload) {
+                            if (!subscription_running_) {
+                                return;
+                            }
+                            const auto envelope = peek_l1_envelope(payload);
+                            if (!envelope) {
+                                log_error("Failed to deserialize L1 message");
+                                return;
+                            }
+                            enqueue(*payload_queues_[lane_of(envelope->node_id)],
+                                    ingest_class_of(envelope->payload_case, envelope->sensor_case),
+                                    std::move(payload));
+                        },
+                        &subscription_running_
+                    );
+                    return;
+                }
+                redis_messenger_->subscribe_view(
+                    ingest_topic_,
+                    [this](std::string_view payload) {
                         if (subscription_running_) {
-                            handle_l1_message(message);
+                            ingest_l1_message(payload);
                         }
                     },
                     &subscription_running_
@@ -373,124 +540,592 @@ private:
         });
     }
     
-    void handle_l1_message(const messages::L1ToL2Message& message) {
-        // Update node registry
-        if (message.has_sender()) {
-            node_registry_.register_node(message.sender());
+    void start_stream_ingest() {
+        stream_consumer_ = config_.stream_consumer.empty() ? default_stream_consumer() : config_.stream_consumer;
+        subscription_running_ = true;
+        subscription_thread_ = std::thread(&L2FusionManager::stream_ingest_thread_func, this);
+    }
+    
+    void stream_ingest_thread_func() {
+        const auto& stream = ingest_stream_;
+        const auto& group = config_.stream_group;
+        std::vector<redis_utils::StreamEntry> entries;
+        entries.reserve(config_.stream_read_count);
+        
+        try {
+            redis_messenger_->create_consumer_group(stream, group);
+            
+            // Entries this consumer read but never acknowledged before a restart
+            size_t replayed = 0;
+            std::string after = "0";
+            while (subscription_running_) {
+                entries.clear();
+                if (redis_messenger_->read_group(stream, group, stream_consumer_, after,
+                                                 config_.stream_read_count, {}, entries) == 0) {
+                    break;
+                }
+                after = entries.back().id;
+                replayed += entries.size();
+                ingest_stream_entries(entries);
+            }
+            log_info("Stream ingest on " + stream + " as " + group + "/" + stream_consumer_ +
+                     " (" + std::to_string(replayed) + " pending entries replayed)");
+        } catch (const std::exception& e) {
+            log_error("Stream ingest setup failed: " + std::string(e.what()));
+        }
+        
+        auto next_claim = std::chrono::steady_clock::now();
+        while (subscription_running_) {
+            try {
+                // Periodically take over entries abandoned by other consumers
+                if (std::chrono::steady_clock::now() >= next_claim) {
+                    entries.clear();
+                    if (redis_messenger_->claim_idle_entries(stream, group, stream_consumer_, config_.stream_claim_idle,
+                                                             config_.stream_read_count, entries) > 0) {
+                        log_info("Claimed " + std::to_string(entries.size()) + " idle stream entries");
+                        ingest_stream_entries(entries);
+                    }
+                    next_claim = std::chrono::steady_clock::now() + config_.stream_claim_idle / 2;
+                }
+                
+                entries.clear();
+                if (redis_messenger_->read_group(stream, group, stream_consumer_, ">", config_.stream_read_count,
+                                                 config_.stream_block_timeout, entries) > 0) {
+                    ingest_stream_entries(entries);
+                }
+            } catch (const std::exception& e) {
+                log_error("Stream ingest error: " + std::string(e.what()));
+                std::this_thread::sleep_for(config_.stream_block_timeout);
+            }
+        }
+        log_info("Stream ingest thread stopped");
+    }
+    
+    // Queue the entries' messages; entries that never reach the queue
+    // (node bookkeeping, unparsable or trimmed) are acknowledged right away
+    void ingest_stream_entries(std::vector<redis_utils::StreamEntry>& entries) {
+        std::vector<std::string> done;
+        for (auto& entry : entries) {
+            // Unreadable entries, heartbeats, status and shed data are done once ingested
+            fusion::L1MessagePtr message;
+            if (entry.payload) {
+                message = ingest_payload(*entry.payload, ingest_depth());
+            }
+            if (!message) {
+                done.push_back(std::move(entry.id));
+                continue;
+            }
+            
+            // Registered before queuing so a worker can always find it
+            {
+                std::lock_guard lock(stream_ids_mutex_);
+                stream_ids_[message.get()] = entry.id;
+            }
+            auto& queue = *message_queues_[lane_of(message->sender().node_id())];
+            if (!enqueue(queue, ingest_class_of(*message), message)) {
+                std::lock_guard lock(stream_ids_mutex_);
+                stream_ids_.erase(message.get());
+                if (!queue.is_closed()) {
+                    done.push_back(std::move(entry.id));
+                }
+            }
+        }
+        acknowledge_stream_entries(done);
+    }
+    
+    void acknowledge_processed(const std::vector<fusion::L1MessagePtr>& batch) {
+        std::vector<std::string> done;
+        done.reserve(batch.size());
+        {
+            std::lock_guard lock(stream_ids_mutex_);
+            for (const auto& message : batch) {
+                auto it = stream_ids_.find(message.get());
+                if (it != stream_ids_.end()) {
+                    done.push_back(std::move(it->second));
+                    stream_ids_.erase(it);
+                }
+            }
+        }
+        acknowledge_stream_entries(done);
+    }
+    
+    void acknowledge_stream_entries(const std::vector<std::string>& ids) {
+        if (ids.empty()) {
+            return;
+        }
+        try {
+            messages_acked_ += redis_messenger_->acknowledge(ingest_stream_, config_.stream_group, ids);
+        } catch (const std::exception& e) {
+            // Left pending; replayed or claimed later
+            log_error("Failed to acknowledge " + std::to_string(ids.size()) + " stream entries: " + e.what());
+        }
+    }
+    
+    void start_boundary_exchange() {
+        exchange_subscription_thread_ = std::thread([this]() {
+            try {
+                redis_messenger_->subscribe_view(
+                    config_.boundary_exchange_topic,
+                    [this](std::string_view payload) {
+                        if (!subscription_running_) {
+                            return;
+                        }
+                        messages::TrackExchange exchange;
+                        if (!exchange.ParseFromArray(payload.data(), static_cast<int>(payload.size()))) {
+                            log_error("Failed to deserialize track exchange");
+                            return;
+                        }
+                        merge_peer_exchange(exchange);
+                    },
+                    &subscription_running_
+                );
+            } catch (const std::exception& e) {
+                log_error("Track exchange subscription error: " + std::string(e.what()));
+            }
+            log_info("Track exchange subscription stopped");
+        });
+        log_info("Partition " + std::to_string(config_.partitions.index()) + " of " +
+                 std::to_string(config_.partitions.count()) + ", exchanging boundary tracks on " +
+                 config_.boundary_exchange_topic);
+    }
+    
+    void send_boundary_tracks() {
+        const auto& partitions = config_.partitions;
+        messages::TrackExchange exchange;
+        exchange.set_partition(static_cast<uint32_t>(partitions.index()));
+        exchange.set_partition_count(static_cast<uint32_t>(partitions.count()));
+        exchange.mutable_timestamp()->set_timestamp_ms(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        
+        try {
+            std::shared_lock algorithm_lock(algorithm_mutex_);
+            std::unique_lock context_lock(context_mutex_);
+            if (algorithm_) {
+                algorithm_->export_boundary_tracks(algorithm_context_, partitions, exchange);
+            }
+        } catch (const std::exception& e) {
+            log_error("Boundary track export error: " + std::string(e.what()));
+            return;
+        }
+        
+        if (exchange.tracks_size() > 0) {
+            try {
+                if (publisher_->publish(config_.boundary_exchange_topic, exchange)) {
+                    boundary_tracks_sent_ += exchange.tracks_size();
+                }
+            } catch (const std::exception& e) {
+                log_error("Failed to send boundary tracks: " + std::string(e.what()));
+            }
+        }
+    }
+    
+    void merge_peer_exchange(const messages::TrackExchange& exchange) {
+        const auto& partitions = config_.partitions;
+        if (exchange.partition() == partitions.index()) {
+            return;  // Our own export
+        }
+        if (exchange.partition_count() != partitions.count() || exchange.partition() >= partitions.count()) {
+            log_warning("Ignoring track exchange from partition " + std::to_string(exchange.partition()) +
+                        " of " + std::to_string(exchange.partition_count()) + ", expected " +
+                        std::to_string(partitions.count()) + " partitions");
+            return;
+        }
+        
+        try {
+            std::shared_lock algorithm_lock(algorithm_mutex_);
+            std::unique_lock context_lock(context_mutex_);
+            if (algorithm_) {
+                algorithm_->merge_peer_tracks(algorithm_context_, partitions, exchange);
+            }
+            peer_tracks_received_ += exchange.tracks_size();
+        } catch (const std::exception& e) {
+            log_error("Failed to merge tracks of partition " + std::to_string(exchange.partition()) +
+                      ": " + e.what());
+        }
+    }
+    
+    // Stream ingest keys acknowledgements by the parsed message, so it always parses on receipt
+    static bool defers_parsing(const L2Config& config) {
+        return config.defer_parsing && config.ingest_mode == IngestMode::PubSub;
+    }
+    
+    static std::string default_stream_consumer() {
+        char hostname[256] = {};
+        if (gethostname(hostname, sizeof(hostname) - 1) != 0 || hostname[0] == '\0') {
+            return "l2_" + std::to_string(getpid());
+        }
+        return "l2_" + std::string(hostname);
+    }
+    
+    /**
+     * @brief Route one serialized L1 message on its envelope
+     *
+     * Node bookkeeping only needs the sender, heartbeats and status are
+     * applied from their own sub-message, and low-priority sensor data is
+     * shed while queue_depth is past the threshold; none of these pay for
+     * a full parse.
+     *
+     * @return The parsed message if it is for the algorithm, otherwise null
+     */
+    /**
+     * @brief Register or refresh a sender from its serialized identity
+     *
+     * Registering interns the node id, which is permanent, so a new id is
+     * only admitted while fewer than max_l1_nodes are known.
+     *
+     * @param node The sender's symbol, invalid if its id was never seen
+     * @return The sender's symbol, invalid if it was rejected
+     */
+    NodeSymbol register_sender(NodeSymbol node, std::string_view serialized) {
+        if (!node && SymbolTable<NodeTag>::global().size() >= config_.max_l1_nodes) {
+            return node;
+        }
+        common::NodeIdentity sender;
+        if (!sender.ParseFromArray(serialized.data(), static_cast<int>(serialized.size())) ||
+            sender.node_id().empty()) {
+            return node;
+        }
+        bytes_parsed_.fetch_add(serialized.size(), std::memory_order_relaxed);
+        node_registry_.register_node(sender, serialized);
+        return SymbolTable<NodeTag>::global().find(sender.node_id());
+    }
+    
+    fusion::L1MessagePtr ingest_payload(std::string_view payload, size_t queue_depth) {
+        bytes_received_.fetch_add(payload.size(), std::memory_order_relaxed);
+        const auto envelope = peek_l1_envelope(payload);
+        if (!envelope) {
+            log_error("Failed to deserialize L1 message");
+            return nullptr;
+        }
+        
+        // Update node registry; the sender is only parsed when it is new or changed
+        NodeSymbol node = SymbolTable<NodeTag>::global().find(envelope->node_id);
+        if (!envelope->sender.empty() && !node_registry_.touch_node(node, envelope->sender)) {
+            node = register_sender(node, envelope->sender);
+        }
+        if (!node) {
+            nodes_rejected_.fetch_add(1, std::memory_order_relaxed);
+            log_debug("Rejected message from unregistered L1 node: " + std::string(envelope->node_id));
+            return nullptr;
+        }
+        log_debug("Received message from L1 node: " + symbol_name(node));
+        
+        if (!in_sequence(node, envelope->sequence_number)) {
+            return nullptr;
         }
         
         // Handle different message types
-        switch (message.payload_case()) {
-            case messages::L1ToL2Message::kNodeStatus:
-                node_registry_.update_node_status(message.sender().node_id(), message.node_status());
-                break;
+        switch (envelope->payload_case) {
+            case messages::L1ToL2Message::kNodeStatus: {
+                common::NodeStatus status;
+                if (status.ParseFromArray(envelope->payload.data(), static_cast<int>(envelope->payload.size()))) {
+                    bytes_parsed_.fetch_add(envelope->payload.size(), std::memory_order_relaxed);
+                    node_registry_.update_node_status(node, status);
+                }
+                return nullptr;
+            }
             case messages::L1ToL2Message::kHeartbeat:
-                node_registry_.update_node_heartbeat(message.sender().node_id());
+                node_registry_.update_node_heartbeat(node);
+                return nullptr;
+            case messages::L1ToL2Message::kSensorData:
+                if (queue_depth >= shed_threshold_ && sheds(envelope->sensor_case)) {
+                    messages_shed_.fetch_add(1, std::memory_order_relaxed);
+                    return nullptr;
+                }
                 break;
             default:
-                // Queue message for algorithm processing
-                enqueue_message(message);
                 break;
         }
         
-        log_debug("Received message from L1 node: " + message.sender().node_id());
+        auto message = ingest_pool_.parse(payload.data(), payload.size());
+        if (!message) {
+            log_error("Failed to deserialize L1 message");
+            return nullptr;
+        }
+        bytes_parsed_.fetch_add(payload.size(), std::memory_order_relaxed);
+        return message;
     }
     
-    void enqueue_message(const messages::L1ToL2Message& message) {
-        std::unique_lock lock(queue_mutex_);
-        
-        if (message_queue_.size() >= config_.message_queue_size) {
-            log_warning("Message queue full, dropping oldest message");
-            message_queue_.pop();
+    bool in_sequence(NodeSymbol node, int32_t sequence) {
+        switch (sequences_.observe(node, sequence)) {
+            case SequenceVerdict::Duplicate:
+                log_debug("Duplicate message " + std::to_string(sequence) + " from " + symbol_name(node));
+                return !config_.drop_duplicates;
+            case SequenceVerdict::Late:
+                log_debug("Late message " + std::to_string(sequence) + " from " + symbol_name(node));
+                return true;
+            default:
+                return true;
+        }
+    }
+    
+    bool sheds(data_streams::SensorData::DataTypeCase sensor_case) const {
+        return std::find(config_.shed_sensor_types.begin(), config_.shed_sensor_types.end(), sensor_case) !=
+               config_.shed_sensor_types.end();
+    }
+    
+    // Ingest queues: one per worker when each node is pinned to a worker
+    static size_t ingest_lanes(const L2Config& config) {
+        return config.ordered_per_node ? std::max<size_t>(config.worker_threads, 1) : 1;
+    }
+    
+    size_t lane_of(std::string_view node_id) const {
+        return message_queues_.size() == 1 ? 0 : std::hash<std::string_view>{}(node_id) % message_queues_.size();
+    }
+    
+    // Messages or payloads waiting in all ingest queues
+    size_t ingest_depth() const {
+        size_t depth = 0;
+        for (const auto& queue : message_queues_) {
+            depth += queue->size_approx();
+        }
+        for (const auto& queue : payload_queues_) {
+            depth += queue->size_approx();
+        }
+        return depth;
+    }
+    
+    template<typename T>
+    static uint64_t dropped_count(const std::vector<std::unique_ptr<WeightedFairQueue<T>>>& queues) {
+        uint64_t dropped = 0;
+        for (const auto& queue : queues) {
+            dropped += queue->dropped_count();
+        }
+        return dropped;
+    }
+    
+    template<typename T>
+    static std::vector<QueueClassStats> class_stats(const std::vector<std::unique_ptr<WeightedFairQueue<T>>>& queues) {
+        std::vector<QueueClassStats> total = queues.front()->class_stats();
+        for (size_t lane = 1; lane < queues.size(); ++lane) {
+            auto stats = queues[lane]->class_stats();
+            for (size_t i = 0; i < stats.size(); ++i) {
+                total[i].depth += stats[i].depth;
+                total[i].capacity += stats[i].capacity;
+                total[i].dequeued += stats[i].dequeued;
+                total[i].dropped += stats[i].dropped;
+            }
+        }
+        return total;
+    }
+    
+    std::vector<TickStats> tick_stats() const {
+        auto ticks = algorithm_scheduler_.stats();
+        auto light = scheduler_.stats();
+        ticks.insert(ticks.end(), light.begin(), light.end());
+        return ticks;
+    }
+    
+    // Queue share and policy of each ingest class in one worker's queue
+    static std::vector<QueueClassOptions> make_ingest_classes(const L2Config& config) {
+        // A full queue stalls stream reads instead of dropping entries, which stay in Redis
+        auto policy_of = [&config](const std::optional<OverflowPolicy>& overflow) {
+            return config.ingest_mode == IngestMode::Stream ? OverflowPolicy::Block
+                                                            : overflow.value_or(config.message_queue_overflow);
+        };
+        const size_t lane_size = config.message_queue_size / ingest_lanes(config);
+        if (config.ingest_classes.empty()) {
+            return {{.name = "all", .capacity = std::max<size_t>(lane_size, 2),
+                     .policy = policy_of(std::nullopt), .weight = 1}};
         }
         
-        message_queue_.push(message);
-        queue_cv_.notify_one();
+        std::vector<QueueClassOptions> classes;
+        for (const auto& ingest_class : config.ingest_classes) {
+            const auto capacity = static_cast<size_t>(ingest_class.queue_share * static_cast<float>(lane_size));
+            classes.push_back({.name = ingest_class.name, .capacity = std::max<size_t>(capacity, 2),
+                               .policy = policy_of(ingest_class.overflow), .weight = ingest_class.weight});
+        }
+        return classes;
+    }
+    
+    // Lookup tables from payload and sensor type to ingest class
+    void map_ingest_classes() {
+        const size_t fallback = ingest_classes_.size() - 1;
+        class_of_payload_.fill(fallback);
+        class_of_sensor_.fill(fallback);
+        for (size_t i = config_.ingest_classes.size(); i-- > 0;) {
+            for (auto payload_type : config_.ingest_classes[i].payload_types) {
+                class_of_payload_.at(payload_type) = i;
+            }
+            for (auto sensor_type : config_.ingest_classes[i].sensor_types) {
+                class_of_sensor_.at(sensor_type) = i;
+            }
+        }
+    }
+    
+    size_t ingest_class_of(messages::L1ToL2Message::PayloadCase payload_case,
+                           data_streams::SensorData::DataTypeCase sensor_case) const {
+        if (payload_case == messages::L1ToL2Message::kSensorData) {
+            return sensor_case < class_of_sensor_.size() ? class_of_sensor_[sensor_case] : ingest_classes_.size() - 1;
+        }
+        return payload_case < class_of_payload_.size() ? class_of_payload_[payload_case] : ingest_classes_.size() - 1;
     }
     
-    void worker_thread_func() {
+    size_t ingest_class_of(const messages::L1ToL2Message& message) const {
+        return ingest_class_of(message.payload_case(), message.sensor_data().data_type_case());
+    }
+    
+    template<typename T>
+    bool enqueue(WeightedFairQueue<T>& queue, size_t ingest_class, T item) {
+        switch (queue.push(ingest_class, std::move(item))) {
+            case PushResult::EnqueuedDroppedOldest:
+                log_warning("Ingest queue full, dropping oldest " + queue.class_name(ingest_class) + " message");
+                return true;
+            case PushResult::DroppedNewest:
+                log_warning("Ingest queue full, dropping newest " + queue.class_name(ingest_class) + " message");
+                return false;
+            case PushResult::Closed:
+                return false;
+            default:
+                return true;
+        }
+    }
+    
+    void worker_thread_func(size_t lane) {
+        std::vector<fusion::L1MessagePtr> batch;
+        std::vector<std::string> payloads;
+        batch.reserve(config_.worker_batch_size);
+        
         while (running_) {
-            messages::L1ToL2Message message;
+            batch.clear();
+            if (next_batch(lane, batch, payloads) == 0 || !running_) {
+                continue;
+            }
             
+            bool concurrent = false;
             {
-                std::unique_lock lock(queue_mutex_);
-                queue_cv_.wait(lock, [this] { return !message_queue_.empty() || !running_; });
-                
-                if (!running_) break;
+                std::shared_lock algorithm_lock(algorithm_mutex_);
+                if (!algorithm_) {
+                    continue;
+                }
                 
-                message = message_queue_.front();
-                message_queue_.pop();
+                // Process the batch under one lock; shared if the algorithm
+                // shards its own state, so workers run side by side
+                concurrent = algorithm_->supports_concurrent_processing();
+                if (concurrent) {
+                    std::shared_lock context_lock(context_mutex_);
+                    process_batch(batch);
+                } else {
+                    std::unique_lock context_lock(context_mutex_);
+                    process_batch(batch);
+                }
             }
             
-            // Process message with algorithm
-            try {
-                std::shared_lock algorithm_lock(algorithm_mutex_);
-                std::lock_guard<std::mutex> context_lock(context_mutex_);
-                if (algorithm_) {
-                    algorithm_->process_l1_message(algorithm_context_, message);
-                    messages_processed_++;
-                }
-            } catch (const std::exception& e) {
-                log_error("Algorithm processing error: " + std::string(e.what()));
+            // A high-priority detection runs the next update now instead of at its tick
+            if (algorithm_context_.take_update_request()) {
+                algorithm_scheduler_.trigger(update_task_);
             }
             
-            // Send any pending output messages (outside the lock)
-            send_pending_outputs();
+            // Acknowledge stream entries outside the lock; a failed batch is
+            // not retried, so it is acknowledged as well
+            if (config_.ingest_mode == IngestMode::Stream) {
+                acknowledge_processed(batch);
+            }
+            
+            // Send any pending output messages (outside the lock). Concurrent
+            // algorithms only emit from update(), which the algorithm thread flushes
+            if (!concurrent) {
+                send_pending_outputs();
+            }
         }
     }
     
-    void algorithm_thread_func() {
-        while (running_) {
-            try {
-                {
-                    std::shared_lock algorithm_lock(algorithm_mutex_);
-                    std::lock_guard<std::mutex> context_lock(context_mutex_);
-                    if (algorithm_) {
-                        algorithm_->update(algorithm_context_);
-                    }
+    // Wait for the next messages for the algorithm. Deferred payloads are
+    // routed and parsed here, on the worker
+    size_t next_batch(size_t lane, std::vector<fusion::L1MessagePtr>& batch, std::vector<std::string>& payloads) {
+        if (!defers_parsing(config_)) {
+            return message_queues_[lane]->pop_batch_wait(batch, config_.worker_batch_size);
+        }
+        
+        // The backlog left behind this batch decides whether it is shed
+        payloads.clear();
+        payload_queues_[lane]->pop_batch_wait(payloads, config_.worker_batch_size);
+        const size_t backlog = ingest_depth();
+        for (const auto& payload : payloads) {
+            if (auto message = ingest_payload(payload, backlog)) {
+                batch.push_back(std::move(message));
+            }
+        }
+        return batch.size();
+    }
+    
+    void process_batch(const std::vector<fusion::L1MessagePtr>& batch) {
+        {
+            std::lock_guard<std::mutex> history_lock(history_mutex_);
+            const auto received = std::chrono::steady_clock::now();
+            for (const auto& message : batch) {
+                // Interned when ingest_payload() registered the sender
+                if (const auto node = SymbolTable<NodeTag>::global().find(message->sender().node_id())) {
+                    algorithm_context_.add_message_to_history(node, message, received);
                 }
-                // Send any pending output messages (outside the lock)
-                send_pending_outputs();
-            } catch (const std::exception& e) {
-                log_error("Algorithm update error: " + std::string(e.what()));
             }
-            
-            std::this_thread::sleep_for(config_.algorithm_update_interval);
+        }
+        
+        try {
+            algorithm_->process_l1_batch(algorithm_context_, batch);
+            messages_processed_ += batch.size();
+        } catch (const std::exception& e) {
+            log_error("Algorithm processing error (batch of " + std::to_string(batch.size()) +
+                      "): " + std::string(e.what()));
         }
     }
     
-    void heartbeat_thread_func() {
-        while (running_) {
-            send_heartbeat();
-            std::this_thread::sleep_for(config_.heartbeat_interval);
+    void schedule_periodic_tasks() {
+        update_task_ = algorithm_scheduler_.add_periodic("algorithm_update", config_.algorithm_update_interval,
+                                               [this] { run_algorithm_update(); });
+        scheduler_.add_periodic("heartbeat", config_.heartbeat_interval, [this] { send_heartbeat(); });
+        scheduler_.add_periodic("node_monitor",
+                                std::max(std::chrono::milliseconds(config_.node_timeout) / 4,
+                                         std::chrono::milliseconds(1)),
+                                [this] { check_node_timeouts(); });
+        if (config_.partitions.partitioned()) {
+            algorithm_scheduler_.add_periodic("boundary_exchange", config_.boundary_exchange_interval,
+                                    [this] { send_boundary_tracks(); });
         }
     }
     
-    void node_monitor_thread_func() {
-        while (running_) {
-            // Atomically check and remove timed-out nodes
-            auto removed_nodes = node_registry_.check_and_remove_timed_out_nodes(config_.node_timeout);
-            
-            // Process each removed node
-            for (const auto& node_id : removed_nodes) {
-                log_warning("Node timeout detected: " + node_id);
-                {
-                    std::shared_lock algorithm_lock(algorithm_mutex_);
-                    std::lock_guard<std::mutex> context_lock(context_mutex_);
-                    if (algorithm_) {
-                        algorithm_->handle_trigger(algorithm_context_, "node_timeout", node_id);
-                    }
+    void run_algorithm_update() {
+        try {
+            {
+                std::shared_lock algorithm_lock(algorithm_mutex_);
+                std::unique_lock context_lock(context_mutex_);
+                // Exclusive, so no algorithm holds a reference into the history
+                algorithm_context_.expire_message_history();
+                if (algorithm_) {
+                    algorithm_->update(algorithm_context_);
                 }
             }
-            
-            std::this_thread::sleep_for(config_.node_timeout / 4);
+            // Send any pending output messages (outside the lock)
+            send_pending_outputs();
+        } catch (const std::exception& e) {
+            log_error("Algorithm update error: " + std::string(e.what()));
+        }
+    }
+    
+    void check_node_timeouts() {
+        // Atomically check and remove timed-out nodes
+        auto removed_nodes = node_registry_.check_and_remove_timed_out_nodes(config_.node_timeout);
+        
+        // Process each removed node
+        for (const auto& node_id : removed_nodes) {
+            log_warning("Node timeout detected: " + node_id);
+            try {
+                std::shared_lock algorithm_lock(algorithm_mutex_);
+                std::unique_lock context_lock(context_mutex_);
+                if (algorithm_) {
+                    algorithm_->handle_trigger(algorithm_context_, "node_timeout", node_id);
+                }
+            } catch (const std::exception& e) {
+                log_error("Node timeout handling error: " + std::string(e.what()));
+            }
         }
     }
     
     void send_pending_outputs() {
         std::vector<messages::L2ToL1Message> messages_to_send;
         {
-            std::lock_guard<std::mutex> context_lock(context_mutex_);
+            std::unique_lock context_lock(context_mutex_);
             messages_to_send = std::move(algorithm_context_.pending_outputs);
             algorithm_context_.pending_outputs.clear();
         }
@@ -512,7 +1147,7 @@ private:
         system_cmd->set_command_type(messages::SystemCommand::SYNC_TIME);
         
         try {
-            redis_messenger_->publish(config_.heartbeat_topic, heartbeat);
+            publisher_->publish(config_.heartbeat_topic, heartbeat);
         } catch (const std::exception& e) {
             log_error("Failed to send heartbeat: " + std::string(e.what()));
         }
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "messages/l1_to_l2.pb.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace dp_aero_l2::fusion {
+
+/**
+ * @brief The routing facts of a message, kept in its history entry
+ */
+struct L1MessageSummary {
+    std::chrono::steady_clock::time_point received;
+    int64_t timestamp_ms = 0;  // Sender's timestamp
+    int32_t sequence_number = 0;
+    messages::L1ToL2Message::PayloadCase payload_case = messages::L1ToL2Message::PAYLOAD_NOT_SET;
+    data_streams::SensorData::DataTypeCase sensor_case = data_streams::SensorData::DATA_TYPE_NOT_SET;
+};
+
+inline L1MessageSummary summarize_l1_message(const messages::L1ToL2Message& message,
+                                             std::chrono::steady_clock::time_point received) {
+    return L1MessageSummary{
+        .received = received,
+        .timestamp_ms = message.timestamp().timestamp_ms(),
+        .sequence_number = message.sequence_number(),
+        .payload_case = message.payload_case(),
+        .sensor_case = message.has_sensor_data() ? message.sensor_data().data_type_case()
+                                                 : data_streams::SensorData::DATA_TYPE_NOT_SET};
+}
+
+/**
+ * @brief One message of a node's history
+ */
+struct HistoryEntry {
+    L1MessageSummary summary;
+    std::shared_ptr<const messages::L1ToL2Message> message;  // Null when only summaries are kept
+};
+
+/**
+ * @brief Fixed-capacity ring of a node's most recent messages, oldest first
+ *
+ * Once full, each push overwrites the oldest entry in place, so insertion
+ * costs the same whatever the depth. Entries are read in place through
+ * iterators, indexing or spans(); nothing is copied out.
+ */
+class MessageRing {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = HistoryEntry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const HistoryEntry*;
+        using reference = const HistoryEntry&;
+
+        const_iterator() = default;
+        const_iterator(const MessageRing* ring, size_t index) : ring_(ring), index_(index) {}
+
+        reference operator*() const { return (*ring_)[index_]; }
+        pointer operator->() const { return &(*ring_)[index_]; }
+
+        const_iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto previous = *this;
+            ++index_;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+
+    private:
+        const MessageRing* ring_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    MessageRing() = default;
+    explicit MessageRing(size_t capacity) : slots_(capacity) {}
+
+    /**
+     * @brief Append an entry, overwriting the oldest once full (a no-op at capacity 0)
+     */
+    void push(HistoryEntry entry) {
+        if (slots_.empty()) {
+            return;
+        }
+        slot(size_) = std::move(entry);
+        if (size_ < slots_.size()) {
+            ++size_;
+        } else {
+            head_ = wrap(head_ + 1);
+        }
+    }
+
+    /**
+     * @brief Drop the entries received at or before cutoff
+     * @return Number of entries dropped
+     */
+    size_t expire(std::chrono::steady_clock::time_point cutoff) {
+        size_t dropped = 0;
+        while (size_ > 0 && slots_[head_].summary.received <= cutoff) {
+            slots_[head_] = HistoryEntry{};  // Release the message now
+            head_ = wrap(head_ + 1);
+            --size_;
+            ++dropped;
+        }
+        return dropped;
+    }
+
+    /**
+     * @brief Change the capacity, keeping the most recent entries
+     */
+    void set_capacity(size_t capacity) {
+        std::vector<HistoryEntry> slots(capacity);
+        const size_t kept = std::min(size_, capacity);
+        for (size_t i = 0; i < kept; ++i) {
+            slots[i] = std::move(slot(size_ - kept + i));
+        }
+        slots_ = std::move(slots);
+        head_ = 0;
+        size_ = kept;
+    }
+
+    void clear() {
+        for (auto& slot : slots_) {
+            slot = HistoryEntry{};
+        }
+        head_ = 0;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Entry i, counting from the oldest
+     */
+    const HistoryEntry& operator[](size_t i) const { return slots_[wrap(head_ + i)]; }
+
+    const HistoryEntry& front() const { return (*this)[0]; }
+    const HistoryEntry& back() const { return (*this)[size_ - 1]; }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size_}; }
+
+    /**
+     * @brief The entries as two contiguous runs: the older one, then the newer one (possibly empty)
+     */
+    std::pair<std::span<const HistoryEntry>, std::span<const HistoryEntry>> spans() const {
+        const std::span<const HistoryEntry> slots(slots_);
+        const size_t first = std::min(size_, slots_.size() - head_);
+        return {slots.subspan(head_, first), slots.first(size_ - first)};
+    }
+
+private:
+    HistoryEntry& slot(size_t i) { return slots_[wrap(head_ + i)]; }
+
+    // Slot index of position i < 2 * capacity, without a division
+    size_t wrap(size_t i) const { return i < slots_.size() ? i : i - slots_.size(); }
+
+    std::vector<HistoryEntry> slots_;
+    size_t head_ = 0;  // Slot of the oldest entry
+    size_t size_ = 0;
+};
+
+} // namespace dp_aero_l2::fusion
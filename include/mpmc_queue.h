@@ -0,0 +1,284 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief What a full MpmcQueue does with a new item
+ */
+enum class OverflowPolicy {
+    DropOldest,  // Discard the oldest queued item to make room
+    DropNewest,  // Reject the new item
+    Block        // Wait until a consumer makes room (or the queue is closed)
+};
+
+/**
+ * @brief Outcome of MpmcQueue::push
+ */
+enum class PushResult {
+    Enqueued,
+    EnqueuedDroppedOldest,  // Enqueued after discarding one or more old items
+    DroppedNewest,          // Queue full, item rejected
+    Closed                  // Queue closed, item rejected
+};
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue
+ *
+ * Ring buffer of slots with per-slot sequence numbers (Vyukov): producers
+ * and consumers each claim a position with one CAS and hand the slot over
+ * through its sequence, so neither side takes a lock. Items are moved in and
+ * out, so T should be cheap to move (e.g. a shared_ptr to the payload).
+ *
+ * Blocking is only used where asked for: pop_batch_wait() sleeps while the
+ * queue is empty and push() sleeps on a full queue under OverflowPolicy::Block.
+ * Sleepers wait on an atomic counter (futex); a push or pop only issues a
+ * wake when someone went to sleep since the last one. close() wakes everyone.
+ *
+ * Capacity must be at least 2. T must be default constructible and move
+ * assignable.
+ */
+template<typename T>
+class MpmcQueue {
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // Producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+
+    // Sleepers raise the flag before re-checking; the first signaller to see it
+    // clears it and wakes everyone, so only the first push/pop after a sleep pays for a wake
+    alignas(64) std::atomic<uint32_t> push_signal_{0};
+    std::atomic<bool> consumers_sleeping_{false};
+    alignas(64) std::atomic<uint32_t> pop_signal_{0};
+    std::atomic<bool> producers_sleeping_{false};
+
+    std::atomic<bool> closed_{false};
+    std::atomic<uint64_t> dropped_{0};
+
+    const size_t capacity_;
+    const OverflowPolicy policy_;
+    std::unique_ptr<Slot[]> slots_;
+
+public:
+    explicit MpmcQueue(size_t capacity, OverflowPolicy policy = OverflowPolicy::DropOldest)
+        : capacity_(capacity), policy_(policy) {
+        // With a single slot "full at pos" and "free at pos + 1" share a sequence value
+        if (capacity < 2) {
+            throw std::invalid_argument("MpmcQueue capacity must be at least 2");
+        }
+        slots_ = std::make_unique<Slot[]>(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @brief Enqueue an item according to the overflow policy
+     */
+    PushResult push(T value) {
+        if (closed_.load(std::memory_order_acquire)) {
+            return PushResult::Closed;
+        }
+
+        bool dropped_oldest = false;
+        while (!try_push(value)) {
+            switch (policy_) {
+                case OverflowPolicy::DropNewest:
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return PushResult::DroppedNewest;
+
+                case OverflowPolicy::DropOldest: {
+                    T discarded;
+                    if (pop_one(discarded)) {
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                        dropped_oldest = true;
+                    }
+                    break;
+                }
+
+                case OverflowPolicy::Block:
+                    if (!wait_for_space()) {
+                        return PushResult::Closed;
+                    }
+                    break;
+            }
+        }
+
+        signal_consumers();
+        return dropped_oldest ? PushResult::EnqueuedDroppedOldest : PushResult::Enqueued;
+    }
+
+    /**
+     * @brief Dequeue one item without blocking
+     * @return False if the queue was empty
+     */
+    bool try_pop(T& out) {
+        if (!pop_one(out)) {
+            return false;
+        }
+        signal_producers();
+        return true;
+    }
+
+    /**
+     * @brief Dequeue up to max_items without blocking
+     * @return Number of items appended to out
+     */
+    size_t try_pop_batch(std::vector<T>& out, size_t max_items) {
+        size_t count = 0;
+        T item;
+        while (count < max_items && pop_one(item)) {
+            out.push_back(std::move(item));
+            ++count;
+        }
+        if (count > 0) {
+            signal_producers();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Dequeue up to max_items, sleeping while the queue is empty
+     * @return Number of items appended to out; 0 only once the queue is closed
+     */
+    size_t pop_batch_wait(std::vector<T>& out, size_t max_items) {
+        for (;;) {
+            size_t count = try_pop_batch(out, max_items);
+            if (count > 0 || closed_.load()) {
+                return count;
+            }
+
+            consumers_sleeping_.store(true);
+            uint32_t observed = push_signal_.load();
+            count = try_pop_batch(out, max_items);
+            if (count > 0 || closed_.load()) {
+                return count;
+            }
+            push_signal_.wait(observed);
+        }
+    }
+
+    /**
+     * @brief Reject further pushes and wake all waiting producers and consumers
+     *
+     * Items already queued can still be popped.
+     */
+    void close() {
+        closed_.store(true);
+        push_signal_.fetch_add(1);
+        push_signal_.notify_all();
+        pop_signal_.fetch_add(1);
+        pop_signal_.notify_all();
+    }
+
+    /**
+     * @brief Accept pushes again after close()
+     */
+    void reopen() {
+        closed_.store(false);
+    }
+
+    bool is_closed() const { return closed_.load(); }
+    size_t capacity() const { return capacity_; }
+    OverflowPolicy policy() const { return policy_; }
+
+    /**
+     * @brief Items dropped by the overflow policy so far
+     */
+    uint64_t dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Approximate number of queued items (exact when quiescent)
+     */
+    size_t size_approx() const {
+        size_t tail = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t head = enqueue_pos_.load(std::memory_order_relaxed);
+        return head > tail ? head - tail : 0;
+    }
+
+private:
+    bool pop_one(T& out) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos % capacity_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(slot.value);
+                    slot.sequence.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Moves value into the queue only on success
+    bool try_push(T& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos % capacity_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Sleep until a slot may have been freed; false if the queue was closed
+    bool wait_for_space() {
+        producers_sleeping_.store(true);
+        uint32_t observed = pop_signal_.load();
+        if (!closed_.load() && size_approx() >= capacity_) {
+            pop_signal_.wait(observed);
+        }
+        return !closed_.load();
+    }
+
+    void signal_consumers() {
+        push_signal_.fetch_add(1);
+        if (consumers_sleeping_.load() && consumers_sleeping_.exchange(false)) {
+            push_signal_.notify_all();
+        }
+    }
+
+    void signal_producers() {
+        if (policy_ != OverflowPolicy::Block) {
+            return;
+        }
+        pop_signal_.fetch_add(1);
+        if (producers_sleeping_.load() && producers_sleeping_.exchange(false)) {
+            pop_signal_.notify_all();
+        }
+    }
+};
+
+} // namespace dp_aero_l2::core
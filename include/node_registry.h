@@ -0,0 +1,286 @@
+#pragma once
+
+#include "messages/l1_to_l2.pb.h"
+#include "symbol_table.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief Node registry for tracking L1 nodes
+ *
+ * Each node has one record: its identity, which only changes by replacing
+ * the record, plus its last-seen time and status, which are atomics updated
+ * in place. Records are indexed by node symbol in an immutable snapshot
+ * published through an atomic pointer, so readers and heartbeat/status
+ * updates never wait on each other; only adding, replacing and removing
+ * nodes copy the snapshot, under a writer lock.
+ *
+ * Timeouts come from a min-heap of last-seen times holding one entry per
+ * node. A check pops only entries older than the timeout: nodes heard from
+ * since are pushed back with their current time, the rest are removed.
+ * Each node is re-pushed at most once per timeout period.
+ */
+class NodeRegistry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    NodeRegistry() : nodes_(std::make_shared<const NodeMap>()) {}
+
+    /**
+     * @brief Refresh a known node without parsing or copying its identity
+     * @return False if the node is unknown or its identity changed; register_node() it then
+     */
+    bool touch_node(NodeSymbol node, std::string_view serialized_identity) {
+        auto nodes = nodes_.load();
+        const auto* record = nodes->find(node);
+        if (!record || (*record)->serialized_identity != serialized_identity) {
+            return false;
+        }
+        (*record)->last_seen_ns.store(now_ns(), std::memory_order_relaxed);
+        return true;
+    }
+
+    void update_node_heartbeat(NodeSymbol node) {
+        record_for(node)->last_seen_ns.store(now_ns(), std::memory_order_relaxed);
+    }
+
+    void update_node_status(NodeSymbol node, const common::NodeStatus& status) {
+        auto record = record_for(node);
+        record->status.store(std::make_shared<const common::NodeStatus>(status));
+        record->last_seen_ns.store(now_ns(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add or refresh a node
+     * @param serialized_identity The identity as received, if at hand; saves
+     *        serializing it for touch_node()
+     */
+    void register_node(const common::NodeIdentity& node, std::string_view serialized_identity = {}) {
+        std::string serialized = serialized_identity.empty() ? node.SerializeAsString()
+                                                             : std::string(serialized_identity);
+        if (!touch_node(node.node_id(), serialized)) {
+            upsert(node, std::move(serialized));
+        }
+    }
+
+    bool touch_node(std::string_view node_id, std::string_view serialized_identity) {
+        return touch_node(SymbolTable<NodeTag>::global().find(node_id), serialized_identity);
+    }
+
+    void update_node_heartbeat(const std::string& node_id) {
+        update_node_heartbeat(intern_node(node_id));
+    }
+
+    void update_node_status(const std::string& node_id, const common::NodeStatus& status) {
+        update_node_status(intern_node(node_id), status);
+    }
+
+    std::vector<std::string> get_active_nodes(std::chrono::seconds timeout) const {
+        std::vector<std::string> active_nodes;
+        const int64_t cutoff = cutoff_ns(timeout);
+        nodes_.load()->for_each([&](NodeSymbol, const auto& record) {
+            if (record->last_seen_ns.load(std::memory_order_relaxed) > cutoff) {
+                active_nodes.push_back(record->identity.node_id());
+            }
+        });
+        return active_nodes;
+    }
+
+    /**
+     * @brief Identities of the active nodes, from one consistent snapshot
+     */
+    std::vector<common::NodeIdentity> get_active_node_identities(std::chrono::seconds timeout) const {
+        std::vector<common::NodeIdentity> active_nodes;
+        const int64_t cutoff = cutoff_ns(timeout);
+        nodes_.load()->for_each([&](NodeSymbol, const auto& record) {
+            if (record->last_seen_ns.load(std::memory_order_relaxed) > cutoff) {
+                active_nodes.push_back(record->identity);
+            }
+        });
+        return active_nodes;
+    }
+
+    size_t count_active_nodes(std::chrono::seconds timeout) const {
+        size_t count = 0;
+        const int64_t cutoff = cutoff_ns(timeout);
+        nodes_.load()->for_each([&](NodeSymbol, const auto& record) {
+            count += record->last_seen_ns.load(std::memory_order_relaxed) > cutoff;
+        });
+        return count;
+    }
+
+    std::vector<std::string> get_timed_out_nodes(std::chrono::seconds timeout) const {
+        std::vector<std::string> timed_out_nodes;
+        const int64_t cutoff = cutoff_ns(timeout);
+        nodes_.load()->for_each([&](NodeSymbol, const auto& record) {
+            if (record->last_seen_ns.load(std::memory_order_relaxed) <= cutoff) {
+                timed_out_nodes.push_back(record->identity.node_id());
+            }
+        });
+        return timed_out_nodes;
+    }
+
+    std::optional<common::NodeIdentity> get_node(const std::string& node_id) const {
+        auto nodes = nodes_.load();
+        const auto* record = nodes->find(SymbolTable<NodeTag>::global().find(node_id));
+        return record ? std::make_optional((*record)->identity) : std::nullopt;
+    }
+
+    std::optional<common::NodeStatus> get_node_status(const std::string& node_id) const {
+        auto nodes = nodes_.load();
+        const auto* record = nodes->find(SymbolTable<NodeTag>::global().find(node_id));
+        if (!record) {
+            return std::nullopt;
+        }
+        auto status = (*record)->status.load();
+        return status ? std::make_optional(*status) : std::nullopt;
+    }
+
+    std::vector<common::NodeIdentity> get_all_nodes() const {
+        std::vector<common::NodeIdentity> all_nodes;
+        nodes_.load()->for_each([&](NodeSymbol, const auto& record) {
+            all_nodes.push_back(record->identity);
+        });
+        return all_nodes;
+    }
+
+    size_t size() const {
+        return nodes_.load()->size();
+    }
+
+    void remove_node(const std::string& node_id) {
+        std::lock_guard lock(writer_mutex_);
+        auto nodes = std::make_shared<NodeMap>(*nodes_.load());
+        if (nodes->erase(SymbolTable<NodeTag>::global().find(node_id))) {
+            nodes_.store(std::move(nodes));
+        }
+    }
+
+    /**
+     * @brief Atomically check and remove timed-out nodes
+     *
+     * A heartbeat racing with the removal of its node is lost; the node's
+     * next message registers it again.
+     *
+     * @param timeout Timeout duration
+     * @return List of node IDs that were actually removed
+     */
+    std::vector<std::string> check_and_remove_timed_out_nodes(std::chrono::seconds timeout) {
+        std::lock_guard lock(writer_mutex_);
+        std::vector<NodeSymbol> removed;
+        const int64_t cutoff = cutoff_ns(timeout);
+        auto current = nodes_.load();
+
+        while (!deadlines_.empty() && deadlines_.top().last_seen_ns <= cutoff) {
+            auto record = deadlines_.top().record.lock();
+            deadlines_.pop();
+
+            // Entries of removed or replaced records are dropped
+            if (!record) {
+                continue;
+            }
+            const auto* current_record = current->find(record->node);
+            if (!current_record || *current_record != record) {
+                continue;
+            }
+
+            const int64_t last_seen = record->last_seen_ns.load(std::memory_order_relaxed);
+            if (last_seen > cutoff) {
+                deadlines_.push({last_seen, record});
+            } else {
+                removed.push_back(record->node);
+            }
+        }
+
+        std::vector<std::string> removed_nodes;
+        if (!removed.empty()) {
+            auto nodes = std::make_shared<NodeMap>(*current);
+            for (NodeSymbol node : removed) {
+                nodes->erase(node);
+                removed_nodes.push_back(symbol_name(node));
+            }
+            nodes_.store(std::move(nodes));
+        }
+        return removed_nodes;
+    }
+
+private:
+    struct NodeRecord {
+        const NodeSymbol node;
+        const common::NodeIdentity identity;
+        const std::string serialized_identity;
+        std::atomic<int64_t> last_seen_ns;
+        std::atomic<std::shared_ptr<const common::NodeStatus>> status;
+
+        NodeRecord(NodeSymbol symbol, common::NodeIdentity node, std::string serialized, int64_t seen)
+            : node(symbol), identity(std::move(node)), serialized_identity(std::move(serialized)),
+              last_seen_ns(seen) {}
+    };
+
+    using NodeMap = SymbolMap<NodeTag, std::shared_ptr<NodeRecord>>;
+
+    struct Deadline {
+        int64_t last_seen_ns;
+        std::weak_ptr<NodeRecord> record;
+
+        bool operator>(const Deadline& other) const { return last_seen_ns > other.last_seen_ns; }
+    };
+
+    std::atomic<std::shared_ptr<const NodeMap>> nodes_;
+    std::mutex writer_mutex_;  // Serializes map copies and the deadline heap
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>> deadlines_;
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    static int64_t cutoff_ns(std::chrono::seconds timeout) {
+        return now_ns() - std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+    }
+
+    std::shared_ptr<NodeRecord> upsert(const common::NodeIdentity& node, std::string serialized) {
+        const NodeSymbol symbol = intern_node(node.node_id());
+        std::lock_guard lock(writer_mutex_);
+        auto current = nodes_.load();
+        const auto* existing = current->find(symbol);
+        if (existing && (*existing)->serialized_identity == serialized) {
+            (*existing)->last_seen_ns.store(now_ns(), std::memory_order_relaxed);
+            return *existing;  // Registered by another thread meanwhile
+        }
+
+        auto record = std::make_shared<NodeRecord>(symbol, node, std::move(serialized), now_ns());
+        auto nodes = std::make_shared<NodeMap>(*current);
+        auto& slot = (*nodes)[symbol];
+        if (slot) {
+            // Same node, new identity: carry its status over
+            record->status.store(slot->status.load());
+        }
+        slot = record;
+        deadlines_.push({record->last_seen_ns.load(std::memory_order_relaxed), record});
+        nodes_.store(std::move(nodes));
+        return record;
+    }
+
+    // A node heard from before it registered gets a record with a bare identity
+    std::shared_ptr<NodeRecord> record_for(NodeSymbol symbol) {
+        auto nodes = nodes_.load();
+        if (const auto* record = nodes->find(symbol)) {
+            return *record;
+        }
+        common::NodeIdentity node;
+        node.set_node_id(symbol_name(symbol));
+        return upsert(node, node.SerializeAsString());
+    }
+};
+
+} // namespace dp_aero_l2::core
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace dp_aero_l2::algorithms {
+
+/**
+ * @brief Encoding of LidarData.packed_points
+ *
+ * Points are interleaved x, y, z, intensity float32 values in little-endian
+ * byte order, 16 bytes per point. Decoding produces the flat float buffer
+ * (stride 4) consumed by EuclideanClusterExtractor, so no per-point protobuf
+ * objects are created on either side.
+ */
+namespace packed_point_cloud {
+
+constexpr size_t kFloatsPerPoint = 4;
+constexpr size_t kBytesPerPoint = kFloatsPerPoint * sizeof(float);
+
+static_assert(sizeof(float) == sizeof(uint32_t), "float32 required");
+
+/**
+ * @brief Number of complete points in a packed buffer
+ */
+inline size_t point_count(const std::string& packed) {
+    return packed.size() / kBytesPerPoint;
+}
+
+/**
+ * @brief Append one point to a packed buffer
+ */
+inline void append_point(std::string& packed, float x, float y, float z, float intensity) {
+    const float values[kFloatsPerPoint] = {x, y, z, intensity};
+    char bytes[kBytesPerPoint];
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(bytes, values, kBytesPerPoint);
+    } else {
+        for (size_t i = 0; i < kFloatsPerPoint; ++i) {
+            uint32_t word = std::bit_cast<uint32_t>(values[i]);
+            for (size_t b = 0; b < sizeof(word); ++b) {
+                bytes[i * sizeof(word) + b] = static_cast<char>((word >> (8 * b)) & 0xFF);
+            }
+        }
+    }
+    packed.append(bytes, kBytesPerPoint);
+}
+
+/**
+ * @brief Decode a packed buffer into a flat x, y, z, intensity float buffer
+ *
+ * Trailing bytes that do not form a complete point are ignored.
+ *
+ * @param out Receives point_count(packed) * 4 floats; replaced, not appended
+ * @return Number of decoded points
+ */
+inline size_t unpack(const std::string& packed, std::vector<float>& out) {
+    const size_t count = point_count(packed);
+    out.resize(count * kFloatsPerPoint);
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(out.data(), packed.data(), count * kBytesPerPoint);
+    } else {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(packed.data());
+        for (size_t i = 0; i < out.size(); ++i) {
+            uint32_t word = 0;
+            for (size_t b = 0; b < sizeof(word); ++b) {
+                word |= static_cast<uint32_t>(bytes[i * sizeof(word) + b]) << (8 * b);
+            }
+            out[i] = std::bit_cast<float>(word);
+        }
+    }
+    return count;
+}
+
+} // namespace packed_point_cloud
+
+} // namespace dp_aero_l2::algorithms
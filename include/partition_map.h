@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief How tracks are divided between L2 partitions
+ */
+enum class PartitionScheme {
+    Node,   // Partitions own L1 nodes; any two partitions may see the same airspace
+    Sector  // Partitions own square airspace sectors; only tracks near a sector border are shared
+};
+
+/**
+ * @brief Assignment of L1 nodes and airspace to the L2 processes of a deployment
+ *
+ * Each L2 process owns one partition (index out of count). An L1 node
+ * publishes to the channel or stream of its partition: either the one
+ * assigned to it explicitly or one picked by a stable hash of its id, so
+ * L1 and L2 binaries agree without sharing state. With the Sector scheme the
+ * x/y plane is also cut into sectors of sector_size, each hashed to a
+ * partition, which owns the tracks inside it.
+ *
+ * Partitions exchange the tracks they may share with a peer: with Sector,
+ * those within boundary_margin of a sector of another partition; with Node,
+ * all of them. track_owner() decides which partition keeps a track both see.
+ *
+ * A default-constructed map is a single partition that owns everything and
+ * keeps the unpartitioned channel names.
+ */
+class PartitionMap {
+private:
+    size_t count_ = 1;
+    size_t index_ = 0;
+    PartitionScheme scheme_ = PartitionScheme::Node;
+    float sector_size_ = 2000.0f;
+    float inverse_sector_size_ = 1.0f / 2000.0f;
+    float boundary_margin_ = 100.0f;
+    std::unordered_map<std::string, size_t> node_assignments_;
+
+public:
+    PartitionMap() = default;
+
+    /**
+     * @param count Number of L2 partitions
+     * @param index Partition owned by this process
+     * @param scheme How tracks are divided
+     * @param sector_size Side of the square airspace sectors (m), Sector scheme
+     * @param boundary_margin Distance from a foreign sector within which tracks are shared (m)
+     * @throws std::invalid_argument on an empty map, an index out of range or a non-positive size
+     */
+    PartitionMap(size_t count, size_t index, PartitionScheme scheme = PartitionScheme::Node,
+                 float sector_size = 2000.0f, float boundary_margin = 100.0f)
+        : count_(count), index_(index), scheme_(scheme),
+          sector_size_(sector_size), boundary_margin_(boundary_margin) {
+        if (count_ == 0 || index_ >= count_) {
+            throw std::invalid_argument("Partition index " + std::to_string(index_) +
+                                        " out of range for " + std::to_string(count_) + " partitions");
+        }
+        if (!(sector_size_ > 0.0f) || boundary_margin_ < 0.0f) {
+            throw std::invalid_argument("Partition sector size must be positive and margin non-negative");
+        }
+        inverse_sector_size_ = 1.0f / sector_size_;
+    }
+
+    size_t count() const { return count_; }
+    size_t index() const { return index_; }
+    PartitionScheme scheme() const { return scheme_; }
+    float sector_size() const { return sector_size_; }
+    float boundary_margin() const { return boundary_margin_; }
+    bool partitioned() const { return count_ > 1; }
+
+    /**
+     * @brief Pin an L1 node to a partition instead of hashing its id
+     * @throws std::out_of_range if the partition does not exist
+     */
+    void assign_node(const std::string& node_id, size_t partition) {
+        if (partition >= count_) {
+            throw std::out_of_range("Node " + node_id + " assigned to partition " + std::to_string(partition) +
+                                    " of " + std::to_string(count_));
+        }
+        node_assignments_[node_id] = partition;
+    }
+
+    /**
+     * @brief Pin nodes from a "node=partition,node=partition" list
+     * @throws std::invalid_argument on a malformed entry, std::out_of_range on a bad partition
+     */
+    void assign_nodes(std::string_view spec) {
+        while (!spec.empty()) {
+            const size_t comma = spec.find(',');
+            const std::string_view entry = spec.substr(0, comma);
+            spec = comma == std::string_view::npos ? std::string_view{} : spec.substr(comma + 1);
+            if (entry.empty()) {
+                continue;
+            }
+
+            const size_t equals = entry.find('=');
+            if (equals == 0 || equals == std::string_view::npos || equals + 1 == entry.size()) {
+                throw std::invalid_argument("Malformed node assignment: " + std::string(entry));
+            }
+            const std::string partition(entry.substr(equals + 1));
+            if (partition.find_first_not_of("0123456789") != std::string::npos) {
+                throw std::invalid_argument("Malformed node assignment: " + std::string(entry));
+            }
+            assign_node(std::string(entry.substr(0, equals)), std::stoul(partition));
+        }
+    }
+
+    /**
+     * @brief Partition whose L2 process ingests a node's messages
+     *
+     * Unassigned nodes are placed by FNV-1a of their id, which unlike
+     * std::hash is the same in every build and process.
+     */
+    size_t partition_of_node(std::string_view node_id) const {
+        if (!node_assignments_.empty()) {
+            auto it = node_assignments_.find(std::string(node_id));
+            if (it != node_assignments_.end()) {
+                return it->second;
+            }
+        }
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (unsigned char c : node_id) {
+            hash = (hash ^ c) * 0x100000001b3ull;
+        }
+        return static_cast<size_t>(hash % count_);
+    }
+
+    /**
+     * @brief Partition owning the airspace sector of a position (Sector scheme)
+     */
+    size_t partition_of_position(float x, float y) const {
+        return partition_of_sector(sector_coord(x), sector_coord(y));
+    }
+
+    /**
+     * @brief Whether a track at this position may also be held by another partition
+     */
+    bool near_boundary(float x, float y) const {
+        if (count_ == 1) {
+            return false;
+        }
+        if (scheme_ == PartitionScheme::Node) {
+            return true;
+        }
+        const int64_t x0 = sector_coord(x - boundary_margin_), x1 = sector_coord(x + boundary_margin_);
+        const int64_t y0 = sector_coord(y - boundary_margin_), y1 = sector_coord(y + boundary_margin_);
+        for (int64_t sx = x0; sx <= x1; ++sx) {
+            for (int64_t sy = y0; sy <= y1; ++sy) {
+                if (partition_of_sector(sx, sy) != index_) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Partition that keeps a track held both here (at local) and by a peer (at remote)
+     *
+     * With Sector, the owner of the sector both estimates fall in; otherwise,
+     * and whenever the sector belongs to neither side, the lower index. Both
+     * partitions see the same pair of positions, so they reach the same answer.
+     */
+    size_t track_owner(float local_x, float local_y, float remote_x, float remote_y, size_t peer) const {
+        if (scheme_ == PartitionScheme::Sector) {
+            const size_t owner = partition_of_position(local_x, local_y);
+            if (owner == partition_of_position(remote_x, remote_y) && (owner == index_ || owner == peer)) {
+                return owner;
+            }
+        }
+        return std::min(index_, peer);
+    }
+
+    /**
+     * @brief Name of a partition's channel or stream ("<base>.p<partition>"; base when unpartitioned)
+     */
+    std::string channel(const std::string& base, size_t partition) const {
+        return count_ == 1 ? base : base + ".p" + std::to_string(partition);
+    }
+
+    /**
+     * @brief Name of this partition's channel or stream
+     */
+    std::string channel(const std::string& base) const {
+        return channel(base, index_);
+    }
+
+    /**
+     * @brief Name of the channel or stream a node publishes to
+     */
+    std::string channel_for_node(const std::string& base, std::string_view node_id) const {
+        return channel(base, partition_of_node(node_id));
+    }
+
+private:
+    int64_t sector_coord(float value) const {
+        return static_cast<int64_t>(std::floor(value * inverse_sector_size_));
+    }
+
+    size_t partition_of_sector(int64_t sx, int64_t sy) const {
+        uint64_t hash = static_cast<uint64_t>(sx) * 0x9E3779B97F4A7C15ull ^
+                        static_cast<uint64_t>(sy) * 0xC2B2AE3D27D4EB4Full;
+        hash ^= hash >> 29;
+        return static_cast<size_t>(hash % count_);
+    }
+};
+
+} // namespace dp_aero_l2::core
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "mpmc_queue.h"
+#include "condition_wait.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dp_aero_l2::redis_utils {
+
+using core::OverflowPolicy;
+using core::wait_until_ready;
+
+/**
+ * @brief Serialized message waiting to be published
+ */
+struct OutboundMessage {
+    std::string channel;
+    std::string payload;
+    std::chrono::steady_clock::time_point enqueued_at;
+};
+
+/**
+ * @brief Batching limits of a PipelinedPublisher
+ */
+struct PublisherOptions {
+    size_t max_batch = 64;                         // Messages per pipeline
+    std::chrono::microseconds max_delay{500};      // Longest a message waits for a batch to fill
+    size_t queue_capacity = 4096;                  // Queued messages before the overflow policy applies
+    OverflowPolicy overflow = OverflowPolicy::Block;
+};
+
+/**
+ * @brief Asynchronous publisher that coalesces messages into pipelines
+ *
+ * Callers serialize on their own thread and only take the queue lock to
+ * append the payload. A flusher thread hands the queued messages to the
+ * flush function in batches: a batch goes out once it reaches max_batch
+ * messages or its oldest message has waited max_delay, so a burst of N
+ * outputs costs one round trip instead of N.
+ *
+ * The flush function does the actual I/O (RedisMessenger::publish_batch
+ * sends each batch as one pipeline). If it throws, the batch is counted as
+ * failed and dropped; the publisher keeps running.
+ */
+class PipelinedPublisher {
+public:
+    using FlushFunction = std::function<void(std::span<const OutboundMessage>)>;
+
+    using Options = PublisherOptions;
+
+    struct Stats {
+        uint64_t messages_queued = 0;
+        uint64_t messages_published = 0;
+        uint64_t messages_dropped = 0;   // Overflow and failed flushes
+        uint64_t batches = 0;
+        uint64_t failed_batches = 0;
+        size_t last_batch_size = 0;
+        size_t max_batch_size = 0;
+        double average_batch_size = 0.0;
+        // Flush latency: oldest message of a batch enqueued -> flush function returned
+        std::chrono::microseconds last_flush_latency{0};
+        std::chrono::microseconds max_flush_latency{0};
+        std::chrono::microseconds average_flush_latency{0};
+    };
+
+private:
+    FlushFunction flush_function_;
+    Options options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable pending_cv_;   // Flusher: messages queued, flush requested or stopping
+    std::condition_variable space_cv_;     // Blocked publishers and flush() callers
+    std::deque<OutboundMessage> pending_;
+    uint64_t accepted_ = 0;                // Messages accepted into the queue
+    uint64_t completed_ = 0;               // Accepted messages flushed, failed or dropped
+    uint64_t flush_target_ = 0;            // flush() waits until completed_ reaches this
+    bool stopping_ = false;
+
+    Stats stats_;
+    uint64_t batched_messages_ = 0;
+    uint64_t total_flush_latency_us_ = 0;
+
+    std::thread flusher_;
+
+public:
+    explicit PipelinedPublisher(FlushFunction flush_function, const Options& options = Options{})
+        : flush_function_(std::move(flush_function)), options_(options) {
+        if (!flush_function_) {
+            throw std::invalid_argument("PipelinedPublisher requires a flush function");
+        }
+        if (options_.max_batch == 0 || options_.queue_capacity == 0) {
+            throw std::invalid_argument("PipelinedPublisher batch size and queue capacity must be positive");
+        }
+        flusher_ = std::thread(&PipelinedPublisher::flusher_thread_func, this);
+    }
+
+    PipelinedPublisher(const PipelinedPublisher&) = delete;
+    PipelinedPublisher& operator=(const PipelinedPublisher&) = delete;
+
+    /**
+     * @brief Flush everything queued and stop the flusher
+     */
+    ~PipelinedPublisher() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        pending_cv_.notify_all();
+        space_cv_.notify_all();
+        if (flusher_.joinable()) {
+            flusher_.join();
+        }
+    }
+
+    /**
+     * @brief Serialize a protobuf message on the calling thread and queue it
+     * @return False if the message was dropped by the overflow policy or
+     *         because the publisher is stopping
+     * @throws std::runtime_error if serialization fails
+     */
+    template<typename T>
+    bool publish(const std::string& channel, const T& message) {
+        std::string payload;
+        if (!message.SerializeToString(&payload)) {
+            throw std::runtime_error("Failed to serialize protobuf message");
+        }
+        return publish_raw(channel, std::move(payload));
+    }
+
+    /**
+     * @brief Queue an already serialized payload
+     * @return False if the message was dropped by the overflow policy or
+     *         because the publisher is stopping
+     */
+    bool publish_raw(std::string channel, std::string payload) {
+        {
+            std::unique_lock lock(mutex_);
+            if (stopping_) {
+                ++stats_.messages_dropped;
+                return false;
+            }
+            if (pending_.size() >= options_.queue_capacity) {
+                switch (options_.overflow) {
+                    case OverflowPolicy::DropNewest:
+                        ++stats_.messages_dropped;
+                        return false;
+                    case OverflowPolicy::DropOldest:
+                        pending_.pop_front();
+                        ++stats_.messages_dropped;
+                        ++completed_;
+                        break;
+                    case OverflowPolicy::Block:
+                        wait_until_ready(space_cv_, lock, [this] {
+                            return stopping_ || pending_.size() < options_.queue_capacity;
+                        });
+                        if (stopping_) {
+                            ++stats_.messages_dropped;
+                            return false;
+                        }
+                        break;
+                }
+            }
+            pending_.push_back({std::move(channel), std::move(payload), std::chrono::steady_clock::now()});
+            ++accepted_;
+            ++stats_.messages_queued;
+
+            // Only a full batch wakes the flusher early; otherwise it is already
+            // waiting for the deadline of the oldest message
+            if (pending_.size() != 1 && pending_.size() < options_.max_batch) {
+                return true;
+            }
+        }
+        pending_cv_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Send everything queued so far without waiting for the deadline, and wait for it
+     */
+    void flush() {
+        std::unique_lock lock(mutex_);
+        flush_target_ = std::max(flush_target_, accepted_);
+        const uint64_t target = accepted_;
+        pending_cv_.notify_one();
+        wait_until_ready(space_cv_, lock, [this, target] { return completed_ >= target; });
+    }
+
+    Stats get_stats() const {
+        std::lock_guard lock(mutex_);
+        return stats_;
+    }
+
+    const Options& options() const { return options_; }
+
+private:
+    void flusher_thread_func() {
+        std::vector<OutboundMessage> batch;
+        batch.reserve(options_.max_batch);
+
+        std::unique_lock lock(mutex_);
+        for (;;) {
+            wait_until_ready(pending_cv_, lock, [this] { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return;  // Stopping with nothing left to send
+            }
+
+            // Wait for the batch to fill, up to the oldest message's deadline
+            const auto deadline = pending_.front().enqueued_at + options_.max_delay;
+            pending_cv_.wait_until(lock, deadline, [this] {
+                return stopping_ || pending_.size() >= options_.max_batch || completed_ < flush_target_;
+            });
+
+            const size_t count = std::min(pending_.size(), options_.max_batch);
+            std::move(pending_.begin(), pending_.begin() + count, std::back_inserter(batch));
+            pending_.erase(pending_.begin(), pending_.begin() + count);
+            space_cv_.notify_all();
+
+            lock.unlock();
+            bool ok = true;
+            try {
+                flush_function_(batch);
+            } catch (const std::exception& e) {
+                std::cerr << "Pipelined publish of " << count << " messages failed: " << e.what() << std::endl;
+                ok = false;
+            }
+            const auto done = std::chrono::steady_clock::now();
+            lock.lock();
+
+            record_batch(batch.front().enqueued_at, done, count, ok);
+            completed_ += count;
+            batch.clear();
+            space_cv_.notify_all();
+        }
+    }
+
+    void record_batch(std::chrono::steady_clock::time_point oldest,
+                      std::chrono::steady_clock::time_point done, size_t count, bool ok) {
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(done - oldest);
+        ++stats_.batches;
+        if (ok) {
+            stats_.messages_published += count;
+        } else {
+            ++stats_.failed_batches;
+            stats_.messages_dropped += count;
+        }
+        stats_.last_batch_size = count;
+        stats_.max_batch_size = std::max(stats_.max_batch_size, count);
+        batched_messages_ += count;
+        stats_.average_batch_size = static_cast<double>(batched_messages_) / static_cast<double>(stats_.batches);
+        stats_.last_flush_latency = latency;
+        stats_.max_flush_latency = std::max(stats_.max_flush_latency, latency);
+        total_flush_latency_us_ += static_cast<uint64_t>(latency.count());
+        stats_.average_flush_latency = std::chrono::microseconds(total_flush_latency_us_ / stats_.batches);
+    }
+};
+
+} // namespace dp_aero_l2::redis_utils
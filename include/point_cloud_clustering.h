@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace dp_aero_l2::algorithms {
+
+/**
+ * @brief Centroid and size of one extracted point cluster
+ */
+struct PointCluster {
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    uint32_t point_count = 0;
+};
+
+/**
+ * @brief Euclidean cluster extraction over a voxel grid
+ *
+ * Points closer than cluster_distance are linked and clusters are the
+ * connected components (single linkage, i.e. DBSCAN with minPts = 1).
+ *
+ * Points are bucketed into cubic cells of side cluster_distance / sqrt(3),
+ * so every pair inside one cell is already linked and connectivity is
+ * resolved per cell: two neighbouring cells are joined on the first point
+ * pair within range, and cells already in the same cluster are never
+ * compared. Cell keys are radix sorted, so neighbouring cells are found by
+ * linear merges over the key list instead of a hash lookup per cell.
+ *
+ * Input is a flat float buffer (x, y, z at the start of each stride), and
+ * only centroids and point counts are produced. Scratch buffers are kept
+ * between calls, so one extractor should be reused across frames.
+ */
+class EuclideanClusterExtractor {
+private:
+    using CellKey = uint64_t;
+
+    float cluster_distance_;
+    float inverse_cell_size_;
+    uint32_t min_points_;
+
+    // (cell key, point index), sorted by key
+    std::vector<std::pair<CellKey, uint32_t>> keyed_points_;
+    std::vector<std::pair<CellKey, uint32_t>> radix_scratch_;
+
+    // Cell c owns sorted points [cell_start_[c], cell_start_[c + 1])
+    std::vector<CellKey> cell_keys_;
+    std::vector<uint32_t> cell_start_;
+    std::vector<uint32_t> parent_;
+
+    // Point coordinates grouped by cell
+    std::vector<float> sorted_x_, sorted_y_, sorted_z_;
+
+    // Per-root accumulators
+    std::vector<double> sum_x_, sum_y_, sum_z_;
+    std::vector<uint32_t> count_;
+
+public:
+    /**
+     * @param cluster_distance Points strictly closer than this are linked
+     * @param min_points Smallest cluster reported
+     */
+    explicit EuclideanClusterExtractor(float cluster_distance = 1.0f, uint32_t min_points = 1)
+        : cluster_distance_(cluster_distance),
+          // Shrink the cell slightly so the in-cell diagonal stays strictly below the link distance
+          inverse_cell_size_(std::sqrt(3.0f) / (cluster_distance * (1.0f - 1e-5f))),
+          min_points_(min_points) {}
+
+    float cluster_distance() const { return cluster_distance_; }
+    uint32_t min_points() const { return min_points_; }
+
+    /**
+     * @brief Extract clusters from a flat point buffer
+     * @param points Point i's x, y, z are points[i * stride + 0..2]
+     * @param num_points Number of points in the buffer; points with a
+     *        non-finite coordinate are skipped
+     * @param stride Floats per point (>= 3), e.g. 4 for x, y, z, intensity
+     * @param out Receives clusters with at least min_points points; cleared first
+     */
+    void extract(const float* points, size_t num_points, size_t stride,
+                 std::vector<PointCluster>& out) {
+        out.clear();
+        if (num_points == 0) return;
+
+        bucket_points(points, num_points, stride);
+        link_cells();
+        accumulate(out);
+    }
+
+private:
+    // Coordinates are biased into 21 unsigned bits per axis, x most significant,
+    // so key order is lexicographic cell order and offsets are plain additions
+    static constexpr int kAxisBits = 21;
+    static constexpr int64_t kBias = int64_t{1} << (kAxisBits - 1);
+    static constexpr int64_t kMaxCoord = kBias - 3;  // Leaves room for +-2 neighbour offsets
+
+    void bucket_points(const float* points, size_t num_points, size_t stride) {
+        keyed_points_.resize(num_points);
+        size_t kept = 0;
+        for (size_t i = 0; i < num_points; ++i) {
+            const float* p = points + i * stride;
+            if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2])) {
+                continue;
+            }
+            keyed_points_[kept++] = {key_for(p[0], p[1], p[2]), static_cast<uint32_t>(i)};
+        }
+        keyed_points_.resize(kept);
+        num_points = kept;
+        radix_sort(keyed_points_, radix_scratch_);
+
+        cell_keys_.clear();
+        cell_start_.clear();
+        sorted_x_.resize(num_points);
+        sorted_y_.resize(num_points);
+        sorted_z_.resize(num_points);
+        for (size_t slot = 0; slot < num_points; ++slot) {
+            const auto& [key, index] = keyed_points_[slot];
+            if (cell_keys_.empty() || cell_keys_.back() != key) {
+                cell_keys_.push_back(key);
+                cell_start_.push_back(static_cast<uint32_t>(slot));
+            }
+            const float* p = points + static_cast<size_t>(index) * stride;
+            sorted_x_[slot] = p[0];
+            sorted_y_[slot] = p[1];
+            sorted_z_[slot] = p[2];
+        }
+        cell_start_.push_back(static_cast<uint32_t>(num_points));
+    }
+
+    void link_cells() {
+        const size_t num_cells = cell_keys_.size();
+        parent_.resize(num_cells);
+        std::iota(parent_.begin(), parent_.end(), 0u);
+
+        // Cells sharing (x, y) are consecutive in key order, so each neighbouring
+        // z column is found by one forward merge over the key list
+        for (const auto& column : neighbour_columns()) {
+            size_t j = 0;
+            for (uint32_t cell = 0; cell < num_cells; ++cell) {
+                const CellKey first = cell_keys_[cell] + column.first;
+                const CellKey last = cell_keys_[cell] + column.last;
+                while (j < num_cells && cell_keys_[j] < first) ++j;
+                if (j == num_cells) break;
+
+                for (size_t k = j; k < num_cells && cell_keys_[k] <= last; ++k) {
+                    uint32_t a = find(cell);
+                    uint32_t b = find(static_cast<uint32_t>(k));
+                    if (a != b && cells_linked(cell, static_cast<uint32_t>(k))) {
+                        parent_[b] = a;
+                    }
+                }
+            }
+        }
+    }
+
+    void accumulate(std::vector<PointCluster>& out) {
+        const size_t num_cells = cell_keys_.size();
+        sum_x_.assign(num_cells, 0.0);
+        sum_y_.assign(num_cells, 0.0);
+        sum_z_.assign(num_cells, 0.0);
+        count_.assign(num_cells, 0);
+
+        for (uint32_t cell = 0; cell < num_cells; ++cell) {
+            uint32_t root = find(cell);
+            for (uint32_t i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+                sum_x_[root] += sorted_x_[i];
+                sum_y_[root] += sorted_y_[i];
+                sum_z_[root] += sorted_z_[i];
+            }
+            count_[root] += cell_start_[cell + 1] - cell_start_[cell];
+        }
+
+        for (uint32_t cell = 0; cell < num_cells; ++cell) {
+            if (parent_[cell] != cell || count_[cell] < min_points_) continue;
+            PointCluster cluster;
+            cluster.x = static_cast<float>(sum_x_[cell] / count_[cell]);
+            cluster.y = static_cast<float>(sum_y_[cell] / count_[cell]);
+            cluster.z = static_cast<float>(sum_z_[cell] / count_[cell]);
+            cluster.point_count = count_[cell];
+            out.push_back(cluster);
+        }
+    }
+
+    // True if any point of cell a is strictly within range of any point of cell b
+    bool cells_linked(uint32_t a, uint32_t b) const {
+        const float range_sq = cluster_distance_ * cluster_distance_;
+        for (uint32_t i = cell_start_[a]; i < cell_start_[a + 1]; ++i) {
+            for (uint32_t j = cell_start_[b]; j < cell_start_[b + 1]; ++j) {
+                float dx = sorted_x_[i] - sorted_x_[j];
+                float dy = sorted_y_[i] - sorted_y_[j];
+                float dz = sorted_z_[i] - sorted_z_[j];
+                if (dx*dx + dy*dy + dz*dz < range_sq) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // LSD radix sort on the key, 11 bits per pass; passes where every key has
+    // the same digit (typically the high bits of a local scan) are skipped
+    static void radix_sort(std::vector<std::pair<CellKey, uint32_t>>& items,
+                           std::vector<std::pair<CellKey, uint32_t>>& scratch) {
+        constexpr int kDigitBits = 11;
+        constexpr size_t kBuckets = size_t{1} << kDigitBits;
+        scratch.resize(items.size());
+
+        std::array<uint32_t, kBuckets> counts;
+        for (int shift = 0; shift < 3 * kAxisBits; shift += kDigitBits) {
+            counts.fill(0);
+            for (const auto& item : items) {
+                ++counts[(item.first >> shift) & (kBuckets - 1)];
+            }
+            if (counts[(items.front().first >> shift) & (kBuckets - 1)] == items.size()) {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (auto& count : counts) {
+                uint32_t bucket_size = count;
+                count = offset;
+                offset += bucket_size;
+            }
+            for (const auto& item : items) {
+                scratch[counts[(item.first >> shift) & (kBuckets - 1)]++] = item;
+            }
+            items.swap(scratch);
+        }
+    }
+
+    uint32_t find(uint32_t cell) {
+        while (parent_[cell] != cell) {
+            parent_[cell] = parent_[parent_[cell]];
+            cell = parent_[cell];
+        }
+        return cell;
+    }
+
+    // Key offsets of the first and last cell of one z column (wrapping adds;
+    // biased coordinates stay clear of the field boundaries)
+    struct NeighbourColumn {
+        CellKey first;
+        CellKey last;
+    };
+
+    /**
+     * Half of the cells within link range (each unordered pair visited once),
+     * grouped into z columns. With side r / sqrt(3) that is offsets up to 2 per
+     * axis, minus the corners at (+-2, +-2, +-2) whose closest points are
+     * already r apart.
+     */
+    static const std::vector<NeighbourColumn>& neighbour_columns() {
+        static const std::vector<NeighbourColumn> columns = [] {
+            std::vector<NeighbourColumn> result;
+            for (int64_t dx = 0; dx <= 2; ++dx) {
+                for (int64_t dy = -2; dy <= 2; ++dy) {
+                    if (dx == 0 && dy < 0) continue;
+                    int64_t dz_min = (dx == 0 && dy == 0) ? 1 : -2;
+                    int64_t dz_max = 2;
+                    if (dx == 2 && std::abs(dy) == 2) {
+                        dz_min = -1;
+                        dz_max = 1;
+                    }
+                    int64_t column = (dx << (2 * kAxisBits)) + (dy << kAxisBits);
+                    result.push_back({static_cast<CellKey>(column + dz_min),
+                                      static_cast<CellKey>(column + dz_max)});
+                }
+            }
+            return result;
+        }();
+        return columns;
+    }
+
+    CellKey key_for(float x, float y, float z) const {
+        return (biased_coord(x) << (2 * kAxisBits)) | (biased_coord(y) << kAxisBits) | biased_coord(z);
+    }
+
+    // Cells beyond +-2^20 (about 600 km at a 1 m link distance) are clamped,
+    // before the conversion so it stays in range. Points are finite here
+    uint64_t biased_coord(float value) const {
+        constexpr float kLimit = static_cast<float>(kMaxCoord);
+        const float cell = std::clamp(std::floor(value * inverse_cell_size_), -kLimit, kLimit);
+        return static_cast<uint64_t>(static_cast<int64_t>(cell) + kBias);
+    }
+};
+
+} // namespace dp_aero_l2::algorithms
@@ -1,11 +1,19 @@
 #pragma once
 
+#include "pipelined_publisher.h"
 #include <sw/redis++/redis++.h>
 #include <google/protobuf/message.h>
 #include <string>
 #include <chrono>
 #include <iostream>
-#include <mutex>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 #include <thread>
 
 namespace dp_aero_l2 {
@@ -13,17 +21,33 @@ namespace redis_utils {
 
 using namespace sw::redis;
 
+/**
+ * @brief Stream entry as read by a consumer; payload is empty if the entry
+ * was trimmed away while it was pending
+ */
+struct StreamEntry {
+    std::string id;
+    std::optional<std::string> payload;  // The "data" field
+};
+
+/**
+ * @brief Protobuf messaging over Redis Pub/Sub, Streams and Lists
+ *
+ * Backed by a redis++ connection pool: every call borrows a connection for
+ * its duration, so up to pool_size calls run concurrently and a blocking
+ * pop only ties up its own connection. Subscribers get a dedicated
+ * connection outside the pool. Blocking consumers need a pool of at least
+ * two, or they stall every other caller for their timeout.
+ */
 class RedisMessenger {
-private:
-    mutable std::mutex redis_mutex_;  // Protect Redis operations
-    
 public:
-    explicit RedisMessenger(const std::string& redis_url = "tcp://127.0.0.1:6379")
-        : redis_(redis_url) {}
+    explicit RedisMessenger(const std::string& redis_url = "tcp://127.0.0.1:6379", size_t pool_size = 1)
+        : redis_(ConnectionOptions(redis_url), pool_options(pool_size)), pool_size_(pool_size) {}
+
+    size_t pool_size() const { return pool_size_; }
 
     // Get subscriber for controlled lifecycle management
     sw::redis::Subscriber get_subscriber() {
-        std::lock_guard<std::mutex> lock(redis_mutex_);
         return redis_.subscriber();
     }
 
@@ -50,46 +74,70 @@ public:
     // Publish message using Redis Pub/Sub
     template<typename T>
     void publish(const std::string& channel, const T& message) {
-        std::lock_guard<std::mutex> lock(redis_mutex_);
         auto serialized = serialize_message(message);
         redis_.publish(channel, serialized);
     }
 
-    // Subscribe to channel with callback (with shutdown support)
+    // Publish already serialized messages in one pipeline (one round trip);
+    // the flush function behind PipelinedPublisher
+    void publish_batch(std::span<const OutboundMessage> batch) {
+        auto pipe = redis_.pipeline(false);
+        for (const auto& message : batch) {
+            pipe.publish(message.channel, message.payload);
+        }
+        pipe.exec();
+    }
+
+    // Subscribe to channel with callback (with shutdown support). Payloads
+    // are parsed in place into one message reused for the whole
+    // subscription, so the reference is only valid during the callback
     template<typename T>
     void subscribe(const std::string& channel, 
                   std::function<void(const T&)> callback,
                   const std::atomic<bool>* shutdown_flag = nullptr) {
-        auto subscriber = redis_.subscriber();
-        subscriber.on_message([this, callback](std::string channel, std::string msg) {
+        T message;
+        subscribe_view(channel, [&message, &callback](std::string_view payload) {
+            if (!message.ParseFromArray(payload.data(), static_cast<int>(payload.size()))) {
+                std::cerr << "Error deserializing message on subscription" << std::endl;
+                return;
+            }
+            callback(message);
+        }, shutdown_flag);
+    }
+
+    // Subscribe to channel with a callback on a view of the received payload,
+    // valid only during the callback; parsing (and where the message is
+    // allocated) is left to the caller
+    void subscribe_view(const std::string& channel,
+                        std::function<void(std::string_view)> callback,
+                        const std::atomic<bool>* shutdown_flag = nullptr) {
+        consume_subscription(channel, [callback = std::move(callback)](std::string, std::string msg) {
             try {
-                auto message = deserialize_message<T>(msg);
-                callback(message);
+                callback(msg);
             } catch (const std::exception& e) {
-                std::cerr << "Error deserializing message: " << e.what() << std::endl;
-            }
-        });
-        
-        subscriber.subscribe(channel);
-        while (true) {
-            // Check shutdown flag frequently
-            if (shutdown_flag && !(*shutdown_flag)) {
-                break;
+                std::cerr << "Error handling message on subscription: " << e.what() << std::endl;
             }
-            
+        }, shutdown_flag);
+    }
+
+    // Subscribe to channel handing over the received payload buffer itself,
+    // for callers that queue it and parse later on another thread
+    void subscribe_owned(const std::string& channel,
+                         std::function<void(std::string&&)> callback,
+                         const std::atomic<bool>* shutdown_flag = nullptr) {
+        consume_subscription(channel, [callback = std::move(callback)](std::string, std::string msg) {
             try {
-                subscriber.consume();
-            } catch (const Error& e) {
-                std::cerr << "Redis subscription error: " << e.what() << std::endl;
-                break;
+                callback(std::move(msg));
+            } catch (const std::exception& e) {
+                std::cerr << "Error handling message on subscription: " << e.what() << std::endl;
             }
-        }
+        }, shutdown_flag);
     }
 
-    // Add message to Redis Stream
+    // Add message to Redis Stream; a non-zero max_len trims the stream to
+    // about that many entries (MAXLEN ~) in the same command
     template<typename T>
-    std::string add_to_stream(const std::string& stream_name, const T& message) {
-        std::lock_guard<std::mutex> lock(redis_mutex_);
+    std::string add_to_stream(const std::string& stream_name, const T& message, size_t max_len = 0) {
         auto serialized = serialize_message(message);
         auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
@@ -99,25 +147,120 @@ public:
             {"timestamp", std::to_string(timestamp)}
         };
         
+        if (max_len > 0) {
+            return redis_.xadd(stream_name, "*", fields.begin(), fields.end(),
+                               static_cast<long long>(max_len), true);
+        }
         return redis_.xadd(stream_name, "*", fields.begin(), fields.end());
     }
 
-    // Read from Redis Stream (TODO: Fix redis++ stream reading)
+    // Read from Redis Stream, entries after start_id
     template<typename T>
     std::vector<std::pair<std::string, T>> read_from_stream(
         const std::string& stream_name, 
         const std::string& start_id = "0",
         size_t count = 10) {
         
+        std::unordered_map<std::string, ItemStream> reply;
+        redis_.xread(stream_name, start_id, static_cast<long long>(count), std::inserter(reply, reply.end()));
+        
         std::vector<std::pair<std::string, T>> results;
-        // TODO: Implement stream reading with correct redis++ API
+        for (auto& entry : to_entries(reply)) {
+            if (entry.payload) {
+                results.emplace_back(std::move(entry.id), deserialize_message<T>(*entry.payload));
+            }
+        }
         return results;
     }
 
+    // Create a consumer group (and the stream, if missing); an existing group is kept
+    void create_consumer_group(const std::string& stream_name, const std::string& group,
+                               const std::string& start_id = "0") {
+        try {
+            redis_.xgroup_create(stream_name, group, start_id, true);
+        } catch (const ReplyError& e) {
+            if (std::string_view(e.what()).find("BUSYGROUP") == std::string_view::npos) {
+                throw;
+            }
+        }
+    }
+
+    // Read entries for a consumer of a group: id ">" delivers new entries,
+    // "0" re-delivers the consumer's own unacknowledged ones. Blocks up to
+    // block_timeout when there is nothing new. Entries are appended to out
+    size_t read_group(const std::string& stream_name, const std::string& group,
+                      const std::string& consumer, const std::string& id, size_t count,
+                      std::chrono::milliseconds block_timeout, std::vector<StreamEntry>& out) {
+        std::unordered_map<std::string, ItemStream> reply;
+        if (id == ">" && block_timeout.count() > 0) {
+            redis_.xreadgroup(group, consumer, stream_name, id, block_timeout,
+                              static_cast<long long>(count), std::inserter(reply, reply.end()));
+        } else {
+            redis_.xreadgroup(group, consumer, stream_name, id,
+                              static_cast<long long>(count), std::inserter(reply, reply.end()));
+        }
+        auto entries = to_entries(reply);
+        std::move(entries.begin(), entries.end(), std::back_inserter(out));
+        return entries.size();
+    }
+
+    // Acknowledge processed entries of a group in one XACK
+    long long acknowledge(const std::string& stream_name, const std::string& group,
+                          std::span<const std::string> ids) {
+        if (ids.empty()) {
+            return 0;
+        }
+        return redis_.xack(stream_name, group, ids.begin(), ids.end());
+    }
+
+    // Take over up to count entries that other consumers of the group left
+    // unacknowledged for at least min_idle (e.g. a crashed L2 process).
+    // Pages through the idle part of the pending list (XPENDING IDLE, Redis
+    // 6.2+), so entries of live or own consumers at its head cannot hide
+    // idle ones further back
+    size_t claim_idle_entries(const std::string& stream_name, const std::string& group,
+                              const std::string& consumer, std::chrono::milliseconds min_idle,
+                              size_t count, std::vector<StreamEntry>& out) {
+        if (count == 0) {
+            return 0;
+        }
+        const std::string idle = std::to_string(min_idle.count());
+        const std::string page_size = std::to_string(count);
+        std::vector<std::tuple<std::string, std::string, long long, long long>> pending;
+        std::vector<std::string> ids;
+        std::string start = "-";
+        while (ids.size() < count) {
+            pending.clear();
+            redis_.command("XPENDING", stream_name, group, "IDLE", idle, start, "+", page_size,
+                           std::back_inserter(pending));
+            for (const auto& [id, owner, idle_ms, deliveries] : pending) {
+                if (owner != consumer && ids.size() < count) {
+                    ids.push_back(id);
+                }
+            }
+            if (pending.size() < count) {
+                break;
+            }
+            start = "(" + std::get<0>(pending.back());
+        }
+        if (ids.empty()) {
+            return 0;
+        }
+        
+        ItemStream claimed;
+        redis_.xclaim(stream_name, group, consumer, min_idle, ids.begin(), ids.end(),
+                      std::back_inserter(claimed));
+        size_t added = 0;
+        for (auto& item : claimed) {
+            out.push_back(to_entry(item));
+            ++added;
+        }
+        return added;
+    }
+
     // Push to Redis List (FIFO queue)
     template<typename T>
     void push_to_queue(const std::string& queue_name, const T& message) {
-        std::lock_guard<std::mutex> lock(redis_mutex_);
         auto serialized = serialize_message(message);
         redis_.lpush(queue_name, serialized);
     }
@@ -126,7 +269,6 @@ public:
     template<typename T>
     std::optional<T> pop_from_queue(const std::string& queue_name, 
                                    std::chrono::seconds timeout = std::chrono::seconds(1)) {
-        std::lock_guard<std::mutex> lock(redis_mutex_);
         try {
             auto result = redis_.brpop(queue_name, timeout);
             if (result) {
@@ -139,7 +281,70 @@ public:
     }
 
 private:
+    using Attrs = std::vector<std::pair<std::string, std::string>>;
+    using Item = std::pair<std::string, Optional<Attrs>>;
+    using ItemStream = std::vector<Item>;
+    
+    // Run a subscription until the shutdown flag clears or the connection
+    // fails. redis++ moves the channel and payload it read into the callback,
+    // which must not throw: the public wrappers catch per message so one bad
+    // message cannot end the subscription
+    template<typename MessageCallback>
+    void consume_subscription(const std::string& channel, MessageCallback&& on_message,
+                              const std::atomic<bool>* shutdown_flag) {
+        auto subscriber = redis_.subscriber();
+        subscriber.on_message(std::forward<MessageCallback>(on_message));
+        
+        subscriber.subscribe(channel);
+        while (true) {
+            // Check shutdown flag frequently
+            if (shutdown_flag && !(*shutdown_flag)) {
+                break;
+            }
+            
+            try {
+                subscriber.consume();
+            } catch (const Error& e) {
+                std::cerr << "Redis subscription error: " << e.what() << std::endl;
+                break;
+            }
+        }
+    }
+    
+    static StreamEntry to_entry(Item& item) {
+        StreamEntry entry{std::move(item.first), std::nullopt};
+        if (item.second) {
+            for (auto& [field, value] : *item.second) {
+                if (field == "data") {
+                    entry.payload = std::move(value);
+                    break;
+                }
+            }
+        }
+        return entry;
+    }
+    
+    static std::vector<StreamEntry> to_entries(std::unordered_map<std::string, ItemStream>& reply) {
+        std::vector<StreamEntry> entries;
+        for (auto& [stream, items] : reply) {
+            for (auto& item : items) {
+                entries.push_back(to_entry(item));
+            }
+        }
+        return entries;
+    }
+    
+    static ConnectionPoolOptions pool_options(size_t pool_size) {
+        if (pool_size == 0) {
+            throw std::invalid_argument("RedisMessenger pool size must be at least 1");
+        }
+        ConnectionPoolOptions options;
+        options.size = pool_size;
+        return options;
+    }
+
     Redis redis_;
+    size_t pool_size_;
 };
 
 } // namespace redis_utils
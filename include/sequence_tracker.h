@@ -0,0 +1,137 @@
+#pragma once
+
+#include "symbol_table.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief How a message's sequence number relates to what its node sent before
+ */
+enum class SequenceVerdict {
+    Untracked,  // Sequence number 0: the sender does not number its messages
+    InOrder,    // Next in sequence (or the node's first message)
+    Gap,        // Newer than expected; the messages in between are missing
+    Duplicate,  // Already seen (or the node restarted less than kWindow after its last number)
+    Late,       // A missing message, arriving after newer ones
+    Restarted   // kWindow or more behind the last one seen: the node restarted its numbering
+};
+
+/**
+ * @brief Sequence anomaly counters, over all nodes
+ */
+struct SequenceStats {
+    uint64_t gaps = 0;        // Times one or more messages were skipped
+    uint64_t missing = 0;     // Messages skipped and not (yet) received late
+    uint64_t duplicates = 0;
+    uint64_t late = 0;
+    uint64_t restarts = 0;
+};
+
+/**
+ * @brief Per-node sequence number tracking
+ *
+ * Keeps the highest sequence number seen from each node and a bitmap of
+ * which of the kWindow numbers below it are still missing, which tells
+ * late arrivals from duplicates. A number further back than the window
+ * cannot be told apart, and is taken as the node restarting its numbering.
+ * Nodes are spread over independently locked shards by symbol, so nodes
+ * in different shards never contend; within a shard their state is a flat
+ * array indexed by symbol.
+ */
+class SequenceTracker {
+public:
+    static constexpr int64_t kWindow = 64;
+
+    /**
+     * @brief Record a node's sequence number and classify it
+     */
+    SequenceVerdict observe(NodeSymbol node_symbol, int32_t sequence) {
+        if (sequence == 0) {
+            return SequenceVerdict::Untracked;
+        }
+
+        Shard& shard = shards_[node_symbol.id % kShards];
+        std::lock_guard lock(shard.mutex);
+        const size_t slot = node_symbol.id / kShards;
+        if (slot >= shard.nodes.size()) {
+            shard.nodes.resize(slot + 1);
+        }
+        NodeState& node = shard.nodes[slot];
+        if (!node.seen) {
+            node = {sequence, 0, true};
+            return SequenceVerdict::InOrder;
+        }
+
+        const int64_t ahead = static_cast<int64_t>(sequence) - node.highest;
+        if (ahead > 0) {
+            // Numbers skipped over are missing, from bit 1 up to bit ahead - 1
+            const uint64_t skipped = ahead >= kWindow ? ~uint64_t{1} : (uint64_t{1} << ahead) - 2;
+            node.missing = (ahead >= kWindow ? 0 : node.missing << ahead) | skipped;
+            node.highest = sequence;
+            if (ahead == 1) {
+                return SequenceVerdict::InOrder;
+            }
+            gaps_.fetch_add(1, std::memory_order_relaxed);
+            missing_.fetch_add(static_cast<uint64_t>(ahead - 1), std::memory_order_relaxed);
+            return SequenceVerdict::Gap;
+        }
+
+        const int64_t behind = -ahead;
+        if (behind >= kWindow) {
+            node = {sequence, 0, true};
+            restarts_.fetch_add(1, std::memory_order_relaxed);
+            return SequenceVerdict::Restarted;
+        }
+        const uint64_t bit = uint64_t{1} << behind;
+        if (!(node.missing & bit)) {
+            duplicates_.fetch_add(1, std::memory_order_relaxed);
+            return SequenceVerdict::Duplicate;
+        }
+        node.missing &= ~bit;
+        missing_.fetch_sub(1, std::memory_order_relaxed);
+        late_.fetch_add(1, std::memory_order_relaxed);
+        return SequenceVerdict::Late;
+    }
+
+    SequenceVerdict observe(std::string_view node_id, int32_t sequence) {
+        return observe(intern_node(node_id), sequence);
+    }
+
+    SequenceStats stats() const {
+        return SequenceStats{
+            .gaps = gaps_.load(std::memory_order_relaxed),
+            .missing = missing_.load(std::memory_order_relaxed),
+            .duplicates = duplicates_.load(std::memory_order_relaxed),
+            .late = late_.load(std::memory_order_relaxed),
+            .restarts = restarts_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    static constexpr size_t kShards = 16;
+
+    struct NodeState {
+        int32_t highest = 0;
+        uint64_t missing = 0;  // Bit i: highest - i was skipped and has not arrived
+        bool seen = false;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<NodeState> nodes;  // Node symbol id / kShards -> state
+    };
+
+    std::array<Shard, kShards> shards_;
+    std::atomic<uint64_t> gaps_{0};
+    std::atomic<uint64_t> missing_{0};
+    std::atomic<uint64_t> duplicates_{0};
+    std::atomic<uint64_t> late_{0};
+    std::atomic<uint64_t> restarts_{0};
+};
+
+} // namespace dp_aero_l2::core
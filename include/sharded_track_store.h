@@ -0,0 +1,369 @@
+#pragma once
+
+#include "track_store.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dp_aero_l2::algorithms {
+
+/**
+ * @brief Live tracks partitioned into spatial shards, one lock per shard
+ *
+ * The x/y plane is cut into square regions of region_size and each region is
+ * hashed to one of up to 64 shards. A shard is a TrackStore plus a mutex, so
+ * messages whose measurements fall in different regions can be associated
+ * concurrently.
+ *
+ * Concurrent code locks the shards around its measurements (lock() with the
+ * mask from shards_near(), always in ascending order so overlapping regions
+ * cannot deadlock) and only touches tracks through the returned Lock. Tracks
+ * that move into another region migrate to its shard on relocate(), keeping
+ * their address. Whole-store operations (iteration, erase_if, clear, ...)
+ * take no locks and need exclusive access to the store, i.e. the algorithm
+ * context's merge point.
+ *
+ * Track ids ("target_<n>") are unique across shards.
+ */
+class ShardedTrackStore {
+public:
+    using ShardMask = uint64_t;
+    static constexpr size_t kMaxShards = 64;
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        TrackStore store;
+
+        explicit Shard(const TrackStore& tracks) : store(tracks) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    float region_size_;
+    float inverse_region_size_;
+    std::atomic<uint64_t> next_id_{0};
+
+    template<bool IsConst>
+    class basic_iterator {
+        using Owner = std::conditional_t<IsConst, const ShardedTrackStore, ShardedTrackStore>;
+        using Inner = std::conditional_t<IsConst, TrackStore::const_iterator, TrackStore::iterator>;
+
+        Owner* owner_ = nullptr;
+        size_t shard_ = 0;
+        Inner it_{};
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TrackStore::Map::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        basic_iterator() = default;
+        basic_iterator(Owner* owner, size_t shard) : owner_(owner), shard_(shard) {
+            if (shard_ < owner_->shards_.size()) {
+                it_ = owner_->shards_[shard_]->store.begin();
+                skip_empty();
+            }
+        }
+
+        reference operator*() const { return *it_; }
+        pointer operator->() const { return &*it_; }
+
+        basic_iterator& operator++() {
+            ++it_;
+            skip_empty();
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const basic_iterator& other) const {
+            return shard_ == other.shard_ && (shard_ == owner_->shards_.size() || it_ == other.it_);
+        }
+
+    private:
+        void skip_empty() {
+            while (it_ == owner_->shards_[shard_]->store.end()) {
+                if (++shard_ == owner_->shards_.size()) {
+                    return;
+                }
+                it_ = owner_->shards_[shard_]->store.begin();
+            }
+        }
+    };
+
+public:
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    /**
+     * @brief Holds the locks of a set of shards; all concurrent track access goes through it
+     */
+    class Lock {
+    private:
+        ShardedTrackStore* owner_;
+        ShardMask mask_;
+        std::vector<std::unique_lock<std::mutex>> locks_;
+        std::vector<std::pair<Target*, float>> scratch_;
+
+    public:
+        Lock(ShardedTrackStore& owner, ShardMask mask) : owner_(&owner), mask_(mask) {
+            locks_.reserve(std::popcount(mask));
+            for (ShardMask rest = mask; rest != 0; rest &= rest - 1) {
+                locks_.emplace_back(owner.shards_[std::countr_zero(rest)]->mutex);
+            }
+        }
+
+        ShardMask mask() const { return mask_; }
+
+        /**
+         * @brief Every track strictly inside radius, from the locked shards near the position
+         */
+        void find_within(float x, float y, float z, float radius,
+                         std::vector<std::pair<Target*, float>>& out) {
+            out.clear();
+            for (ShardMask rest = owner_->shards_near(x, y, radius) & mask_; rest != 0; rest &= rest - 1) {
+                owner_->shards_[std::countr_zero(rest)]->store.find_within(x, y, z, radius, scratch_);
+                out.insert(out.end(), scratch_.begin(), scratch_.end());
+            }
+        }
+
+        /**
+         * @brief Create a track at a position in the shard owning it
+         * @throws std::logic_error if that shard is not locked
+         */
+        Target& create(float x, float y, float z) {
+            auto& store = locked_store(owner_->shard_index(x, y));
+            Target& target = store.create(owner_->next_target_id());
+            target.x = x;
+            target.y = y;
+            target.z = z;
+            store.relocate(target);
+            return target;
+        }
+
+        /**
+         * @brief Re-index a moved track, migrating it if it changed shard
+         * @throws std::logic_error if the track left the locked shards
+         */
+        void relocate(Target& target) {
+            // Most updates keep a track in its shard, so look there first
+            const size_t home = owner_->shard_index(target.x, target.y);
+            auto& home_store = locked_store(home);
+            if (home_store.find(target.target_id) == &target) {
+                home_store.relocate(target);
+                return;
+            }
+            for (ShardMask rest = mask_ & ~(ShardMask{1} << home); rest != 0; rest &= rest - 1) {
+                auto& store = owner_->shards_[std::countr_zero(rest)]->store;
+                if (store.find(target.target_id) == &target) {
+                    store.transfer(target.target_id, home_store);
+                    return;
+                }
+            }
+            throw std::logic_error("Track " + target.target_id + " is not in a locked shard");
+        }
+
+    private:
+        TrackStore& locked_store(size_t shard) {
+            if ((mask_ & (ShardMask{1} << shard)) == 0) {
+                throw std::logic_error("Shard " + std::to_string(shard) + " is not locked");
+            }
+            return owner_->shards_[shard]->store;
+        }
+    };
+
+    /**
+     * @param num_shards Number of shards, 1 to 64
+     * @param region_size Side of the square regions mapped to shards; keep it
+     *        well above the association gate so most lookups touch one shard
+     * @param cell_size Spatial index cell size inside each shard
+     */
+    explicit ShardedTrackStore(size_t num_shards = 1, float region_size = 250.0f, float cell_size = 5.0f)
+        : region_size_(region_size), inverse_region_size_(1.0f / region_size) {
+        if (num_shards == 0 || num_shards > kMaxShards) {
+            throw std::invalid_argument("ShardedTrackStore supports 1 to 64 shards");
+        }
+        shards_.reserve(num_shards);
+        for (size_t i = 0; i < num_shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>(TrackStore(cell_size)));
+        }
+    }
+
+    // Copies (std::any requires them) get fresh locks; copy only when quiescent
+    ShardedTrackStore(const ShardedTrackStore& other)
+        : region_size_(other.region_size_), inverse_region_size_(other.inverse_region_size_),
+          next_id_(other.next_id_.load()) {
+        shards_.reserve(other.shards_.size());
+        for (const auto& shard : other.shards_) {
+            shards_.push_back(std::make_unique<Shard>(shard->store));
+        }
+    }
+
+    ShardedTrackStore& operator=(const ShardedTrackStore& other) {
+        if (this != &other) {
+            ShardedTrackStore copy(other);
+            shards_ = std::move(copy.shards_);
+            region_size_ = other.region_size_;
+            inverse_region_size_ = other.inverse_region_size_;
+            next_id_ = other.next_id_.load();
+        }
+        return *this;
+    }
+
+    size_t shard_count() const { return shards_.size(); }
+    float region_size() const { return region_size_; }
+
+    /**
+     * @brief Shard owning a position
+     */
+    size_t shard_index(float x, float y) const {
+        return shard_of_region(region_coord(x), region_coord(y));
+    }
+
+    /**
+     * @brief Shards whose regions intersect the square of half-width radius around (x, y)
+     */
+    ShardMask shards_near(float x, float y, float radius) const {
+        ShardMask mask = 0;
+        const int64_t x0 = region_coord(x - radius), x1 = region_coord(x + radius);
+        const int64_t y0 = region_coord(y - radius), y1 = region_coord(y + radius);
+        for (int64_t rx = x0; rx <= x1; ++rx) {
+            for (int64_t ry = y0; ry <= y1; ++ry) {
+                mask |= ShardMask{1} << shard_of_region(rx, ry);
+            }
+        }
+        return mask;
+    }
+
+    /**
+     * @brief Mask selecting every shard
+     */
+    ShardMask all_shards() const {
+        return (shard_count() == kMaxShards) ? ~ShardMask{0} : (ShardMask{1} << shard_count()) - 1;
+    }
+
+    /**
+     * @brief Lock a set of shards (in ascending order) for concurrent access
+     */
+    Lock lock(ShardMask mask) {
+        return Lock(*this, mask);
+    }
+
+    // Whole-store operations below require exclusive access
+
+    /**
+     * @brief Create a track at the origin with the next generated id
+     */
+    Target& create() {
+        return shards_[shard_index(0.0f, 0.0f)]->store.create(next_target_id());
+    }
+
+    Target* find(const std::string& target_id) {
+        for (auto& shard : shards_) {
+            if (Target* target = shard->store.find(target_id)) {
+                return target;
+            }
+        }
+        return nullptr;
+    }
+
+    const Target* find(const std::string& target_id) const {
+        for (const auto& shard : shards_) {
+            if (const Target* target = shard->store.find(target_id)) {
+                return target;
+            }
+        }
+        return nullptr;
+    }
+
+    bool erase(const std::string& target_id) {
+        for (auto& shard : shards_) {
+            if (shard->store.erase(target_id)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Remove every track matching the predicate
+     * @param pred Called with (const std::string& id, const Target&)
+     * @return Number of removed tracks
+     */
+    template<typename Pred>
+    size_t erase_if(Pred&& pred) {
+        size_t removed = 0;
+        for (auto& shard : shards_) {
+            removed += shard->store.erase_if(pred);
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Direct access to one shard's tracks
+     */
+    const TrackStore& shard(size_t index) const {
+        return shards_.at(index)->store;
+    }
+
+    /**
+     * @brief Remove all tracks; ids keep counting, as in TrackStore::clear()
+     */
+    void clear() {
+        for (auto& shard : shards_) {
+            shard->store.clear();
+        }
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            total += shard->store.size();
+        }
+        return total;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, shards_.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, shards_.size()); }
+
+private:
+    std::string next_target_id() {
+        return "target_" + std::to_string(next_id_.fetch_add(1, std::memory_order_relaxed));
+    }
+
+    // Clamped before the conversion, which is undefined out of int64 range;
+    // NaN maps to the lower bound
+    int64_t region_coord(float value) const {
+        constexpr float kLimit = static_cast<float>(int64_t{1} << 30);
+        const float region = std::floor(value * inverse_region_size_);
+        return static_cast<int64_t>(region >= -kLimit ? std::min(region, kLimit) : -kLimit);
+    }
+
+    size_t shard_of_region(int64_t rx, int64_t ry) const {
+        uint64_t hash = static_cast<uint64_t>(rx) * 0x9E3779B97F4A7C15ull ^
+                        static_cast<uint64_t>(ry) * 0xC2B2AE3D27D4EB4Full;
+        hash ^= hash >> 29;
+        return static_cast<size_t>(hash % shards_.size());
+    }
+};
+
+} // namespace dp_aero_l2::algorithms
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief Slot-reusing object pool with generation-checked handles
+ *
+ * Objects live in fixed-size chunks that never move, so pointers to them
+ * stay valid until they are erased. An erased slot is reused by the next
+ * emplace() with its generation bumped, so handles to the object that was
+ * there before no longer resolve. Slot indices are dense, for side arrays
+ * indexed by Handle::index.
+ *
+ * Not thread-safe; the owner locks around it.
+ */
+template<typename T, size_t ChunkSize = 256>
+class SlabPool {
+public:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+    static constexpr uint32_t kFirstGeneration = 1;  // Default handles (generation 0) never match
+
+    struct Handle {
+        uint32_t index = kNoSlot;
+        uint32_t generation = 0;
+
+        bool valid() const { return index != kNoSlot; }
+        explicit operator bool() const { return valid(); }
+        bool operator==(const Handle&) const = default;
+    };
+
+    SlabPool() = default;
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    template<typename... Args>
+    Handle emplace(Args&&... args) {
+        uint32_t index = free_head_;
+        if (index != kNoSlot) {
+            free_head_ = slot(index).next_free;
+        } else {
+            index = static_cast<uint32_t>(capacity_);
+            if (capacity_ % ChunkSize == 0) {
+                chunks_.push_back(std::make_unique<Slot[]>(ChunkSize));
+            }
+            ++capacity_;
+        }
+        Slot& s = slot(index);
+        s.value.emplace(std::forward<Args>(args)...);
+        ++size_;
+        return Handle{index, s.generation};
+    }
+
+    /**
+     * @brief The handle the next emplace() will return, e.g. to name the object after it
+     */
+    Handle next_handle() const {
+        if (free_head_ != kNoSlot) {
+            return Handle{free_head_, chunks_[free_head_ / ChunkSize][free_head_ % ChunkSize].generation};
+        }
+        return Handle{static_cast<uint32_t>(capacity_), kFirstGeneration};
+    }
+
+    T* get(Handle handle) {
+        if (handle.index >= capacity_) {
+            return nullptr;
+        }
+        Slot& s = slot(handle.index);
+        return (s.value && s.generation == handle.generation) ? &*s.value : nullptr;
+    }
+
+    const T* get(Handle handle) const {
+        return const_cast<SlabPool*>(this)->get(handle);
+    }
+
+    bool erase(Handle handle) {
+        if (!get(handle)) {
+            return false;
+        }
+        Slot& s = slot(handle.index);
+        s.value.reset();
+        ++s.generation;
+        s.next_free = free_head_;
+        free_head_ = handle.index;
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Handle of the object in a slot, or an invalid one if the slot is free
+     */
+    Handle handle_at(uint32_t index) const {
+        if (index >= capacity_) {
+            return Handle{};
+        }
+        const Slot& s = chunks_[index / ChunkSize][index % ChunkSize];
+        return s.value ? Handle{index, s.generation} : Handle{};
+    }
+
+    /**
+     * @brief Call fn(handle, object) for each live object, in slot order
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        for (uint32_t index = 0; index < capacity_; ++index) {
+            Slot& s = slot(index);
+            if (s.value) {
+                fn(Handle{index, s.generation}, *s.value);
+            }
+        }
+    }
+
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (uint32_t index = 0; index < capacity_; ++index) {
+            const Slot& s = chunks_[index / ChunkSize][index % ChunkSize];
+            if (s.value) {
+                fn(Handle{index, s.generation}, *s.value);
+            }
+        }
+    }
+
+    /**
+     * @brief Erase every object; outstanding handles stop resolving
+     */
+    void clear() {
+        for (uint32_t index = 0; index < capacity_; ++index) {
+            erase(handle_at(index));
+        }
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }  // Slots allocated so far
+
+private:
+    struct Slot {
+        std::optional<T> value;
+        uint32_t generation = kFirstGeneration;
+        uint32_t next_free = kNoSlot;
+    };
+
+    Slot& slot(uint32_t index) { return chunks_[index / ChunkSize][index % ChunkSize]; }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    uint32_t free_head_ = kNoSlot;
+};
+
+} // namespace dp_aero_l2::core
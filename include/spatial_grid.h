@@ -0,0 +1,177 @@
+#pragma once
+
+#include "target.h"
+#include <unordered_map>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+namespace dp_aero_l2::algorithms {
+
+/**
+ * @brief Uniform grid hash over track positions
+ *
+ * Buckets targets by the cell containing their position. With the cell size
+ * equal to the association gate, a radius query touches at most 27 cells, so
+ * lookups cost O(tracks near the query) instead of O(all tracks).
+ *
+ * The grid stores raw Target pointers and does not observe the targets: any
+ * code that moves a target must call update() (TrackStore::relocate does).
+ */
+class SpatialGrid {
+private:
+    using CellKey = uint64_t;
+
+    float cell_size_;
+    float inverse_cell_size_;
+    std::unordered_map<CellKey, std::vector<Target*>> cells_;
+    std::unordered_map<const Target*, CellKey> cell_of_;
+
+public:
+    explicit SpatialGrid(float cell_size = 5.0f)
+        : cell_size_(cell_size), inverse_cell_size_(1.0f / cell_size) {}
+
+    float cell_size() const { return cell_size_; }
+    size_t size() const { return cell_of_.size(); }
+
+    void insert(Target* target) {
+        CellKey key = key_for(target->x, target->y, target->z);
+        cells_[key].push_back(target);
+        cell_of_[target] = key;
+    }
+
+    /**
+     * @brief Re-bucket a target after its position changed
+     */
+    void update(Target* target) {
+        auto it = cell_of_.find(target);
+        if (it == cell_of_.end()) {
+            insert(target);
+            return;
+        }
+
+        CellKey key = key_for(target->x, target->y, target->z);
+        if (key != it->second) {
+            remove_from_cell(it->second, target);
+            cells_[key].push_back(target);
+            it->second = key;
+        }
+    }
+
+    void erase(const Target* target) {
+        auto it = cell_of_.find(target);
+        if (it != cell_of_.end()) {
+            remove_from_cell(it->second, target);
+            cell_of_.erase(it);
+        }
+    }
+
+    void clear() {
+        cells_.clear();
+        cell_of_.clear();
+    }
+
+    /**
+     * @brief Visit every target in the cells overlapping a sphere
+     *
+     * The visitor receives candidates and must apply the exact distance test
+     * itself; cells are only a coarse filter.
+     */
+    template<typename Visitor>
+    void for_each_candidate(float x, float y, float z, float radius, Visitor&& visit) const {
+        int64_t x0 = cell_coord(x - radius), x1 = cell_coord(x + radius);
+        int64_t y0 = cell_coord(y - radius), y1 = cell_coord(y + radius);
+        int64_t z0 = cell_coord(z - radius), z1 = cell_coord(z + radius);
+
+        for (int64_t ix = x0; ix <= x1; ++ix) {
+            for (int64_t iy = y0; iy <= y1; ++iy) {
+                for (int64_t iz = z0; iz <= z1; ++iz) {
+                    auto it = cells_.find(pack(ix, iy, iz));
+                    if (it == cells_.end()) continue;
+                    for (Target* target : it->second) {
+                        visit(target);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Closest target strictly inside radius, or nullptr
+     */
+    Target* find_nearest(float x, float y, float z, float radius) const {
+        Target* closest = nullptr;
+        float best_sq = radius * radius;
+
+        for_each_candidate(x, y, z, radius, [&](Target* target) {
+            float d2 = distance_sq(*target, x, y, z);
+            if (d2 < best_sq) {
+                best_sq = d2;
+                closest = target;
+            }
+        });
+        return closest;
+    }
+
+    /**
+     * @brief Every target strictly inside radius
+     * @param out Receives (target, squared distance) pairs; cleared first
+     */
+    void query_radius(float x, float y, float z, float radius,
+                      std::vector<std::pair<Target*, float>>& out) const {
+        out.clear();
+        const float radius_sq = radius * radius;
+        for_each_candidate(x, y, z, radius, [&](Target* target) {
+            float d2 = distance_sq(*target, x, y, z);
+            if (d2 < radius_sq) {
+                out.emplace_back(target, d2);
+            }
+        });
+    }
+
+    static float distance_sq(const Target& target, float x, float y, float z) {
+        float dx = target.x - x;
+        float dy = target.y - y;
+        float dz = target.z - z;
+        return dx*dx + dy*dy + dz*dz;
+    }
+
+private:
+    // Cells beyond +-2^20 are clamped (and alias in pack()) before the
+    // conversion, which is undefined out of int64 range; NaN maps to the lower bound
+    int64_t cell_coord(float value) const {
+        constexpr float kLimit = static_cast<float>((int64_t{1} << 20) - 1);
+        const float cell = std::floor(value * inverse_cell_size_);
+        return static_cast<int64_t>(cell >= -kLimit ? std::min(cell, kLimit) : -kLimit);
+    }
+
+    // 21 bits per axis (two's complement, masked): unique for |coord| < 2^20 cells
+    static CellKey pack(int64_t ix, int64_t iy, int64_t iz) {
+        constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+        return (static_cast<uint64_t>(ix) & mask) |
+               ((static_cast<uint64_t>(iy) & mask) << 21) |
+               ((static_cast<uint64_t>(iz) & mask) << 42);
+    }
+
+    CellKey key_for(float x, float y, float z) const {
+        return pack(cell_coord(x), cell_coord(y), cell_coord(z));
+    }
+
+    void remove_from_cell(CellKey key, const Target* target) {
+        auto cell_it = cells_.find(key);
+        if (cell_it == cells_.end()) return;
+
+        auto& bucket = cell_it->second;
+        auto it = std::find(bucket.begin(), bucket.end(), target);
+        if (it != bucket.end()) {
+            *it = bucket.back();
+            bucket.pop_back();
+        }
+        if (bucket.empty()) {
+            cells_.erase(cell_it);
+        }
+    }
+};
+
+} // namespace dp_aero_l2::algorithms
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace dp_aero_l2::fusion {
+
+/**
+ * @brief One edge of a StaticStateMachine: trigger fired in from leads to to
+ */
+template<typename State, typename Trigger>
+struct StaticTransition {
+    State from;
+    Trigger trigger;
+    State to;
+};
+
+namespace detail {
+
+inline constexpr uint8_t kNoTransition = UINT8_MAX;
+
+// State x trigger table of a Definition's transitions, kNoTransition where there is none
+template<typename Definition>
+consteval auto build_transition_table() {
+    constexpr size_t states = static_cast<size_t>(Definition::State::Count);
+    constexpr size_t triggers = static_cast<size_t>(Definition::Trigger::Count);
+    std::array<std::array<uint8_t, triggers>, states> table{};
+    for (auto& row : table) {
+        row.fill(kNoTransition);
+    }
+    for (const auto& transition : Definition::transitions) {
+        auto& to = table[static_cast<size_t>(transition.from)][static_cast<size_t>(transition.trigger)];
+        if (to != kNoTransition) {
+            throw "Two transitions share a state and trigger";  // Fails compilation
+        }
+        to = static_cast<uint8_t>(transition.to);
+    }
+    return table;
+}
+
+template<typename Definition>
+inline constexpr auto kTransitionTable = build_transition_table<Definition>();
+
+} // namespace detail
+
+/**
+ * @brief State machine whose states, triggers and transitions are fixed at compile time
+ *
+ * The Definition describes the machine:
+ *
+ *   enum class State : uint8_t { ..., Count };
+ *   enum class Trigger : uint8_t { ..., Count };
+ *   static constexpr State initial = ...;
+ *   static constexpr std::array<std::string_view, N> state_names = {...};
+ *   static constexpr std::array<std::string_view, M> trigger_names = {...};
+ *   static constexpr std::array<StaticTransition<State, Trigger>, K> transitions = {...};
+ *
+ * The transitions are compiled into a state x trigger table, so fire() is
+ * one array lookup. An instance holds only its current state; behaviour
+ * comes from the handler passed to fire() and update(), whose hooks are all
+ * optional and get the remaining arguments:
+ *
+ *   bool allow(State from, Trigger, Args...)  guard, like Transition::condition
+ *   void on_exit(State, Args...)
+ *   void on_transition(State from, Trigger, State to, Args...)
+ *   void on_enter(State, Args...)
+ *   void on_update(State, Args...)
+ *
+ * StateManager and TaskStateMachine remain for machines built at run time
+ * (e.g. by plugin algorithms).
+ */
+template<typename Definition>
+class StaticStateMachine {
+public:
+    using State = typename Definition::State;
+    using Trigger = typename Definition::Trigger;
+
+    static constexpr size_t kStates = static_cast<size_t>(State::Count);
+    static constexpr size_t kTriggers = static_cast<size_t>(Trigger::Count);
+
+    static_assert(kStates < UINT8_MAX, "StaticStateMachine supports up to 254 states");
+    static_assert(Definition::state_names.size() == kStates, "One name per state");
+    static_assert(Definition::trigger_names.size() == kTriggers, "One name per trigger");
+
+    constexpr StaticStateMachine() = default;
+
+    State state() const { return current_; }
+    std::string_view state_name() const { return name(current_); }
+
+    static constexpr std::string_view name(State state) {
+        return Definition::state_names[static_cast<size_t>(state)];
+    }
+
+    static constexpr std::string_view name(Trigger trigger) {
+        return Definition::trigger_names[static_cast<size_t>(trigger)];
+    }
+
+    /**
+     * @brief The trigger of the given name, for triggers arriving as strings
+     */
+    static constexpr std::optional<Trigger> parse_trigger(std::string_view trigger_name) {
+        for (size_t i = 0; i < kTriggers; ++i) {
+            if (Definition::trigger_names[i] == trigger_name) {
+                return static_cast<Trigger>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Where a trigger leads from a state, if anywhere
+     */
+    static constexpr std::optional<State> next_state(State from, Trigger trigger) {
+        const uint8_t to = detail::kTransitionTable<Definition>[static_cast<size_t>(from)][static_cast<size_t>(trigger)];
+        return to != detail::kNoTransition ? std::make_optional(static_cast<State>(to)) : std::nullopt;
+    }
+
+    /**
+     * @brief Take the transition the trigger leads to from the current state
+     * @return False if there is none or the handler's guard refused it
+     */
+    template<typename Handler, typename... Args>
+    bool fire(Trigger trigger, Handler&& handler, Args&&... args) {
+        const auto to = next_state(current_, trigger);
+        if (!to) {
+            return false;
+        }
+        const State from = current_;
+        if constexpr (requires { { handler.allow(from, trigger, args...) } -> std::convertible_to<bool>; }) {
+            if (!handler.allow(from, trigger, args...)) {
+                return false;
+            }
+        }
+        if constexpr (requires { handler.on_exit(from, args...); }) {
+            handler.on_exit(from, args...);
+        }
+        if constexpr (requires { handler.on_transition(from, trigger, *to, args...); }) {
+            handler.on_transition(from, trigger, *to, args...);
+        }
+        current_ = *to;
+        if constexpr (requires { handler.on_enter(*to, args...); }) {
+            handler.on_enter(*to, args...);
+        }
+        return true;
+    }
+
+    bool fire(Trigger trigger) {
+        return fire(trigger, NoHooks{});
+    }
+
+    /**
+     * @brief Run the handler's on_update for the current state
+     */
+    template<typename Handler, typename... Args>
+    void update(Handler&& handler, Args&&... args) {
+        if constexpr (requires { handler.on_update(current_, args...); }) {
+            handler.on_update(current_, args...);
+        }
+    }
+
+    /**
+     * @brief Go back to the initial state without running any hooks
+     */
+    void reset() { current_ = Definition::initial; }
+
+private:
+    struct NoHooks {};
+
+    State current_ = Definition::initial;
+};
+
+} // namespace dp_aero_l2::fusion
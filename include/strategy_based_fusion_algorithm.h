@@ -14,6 +14,7 @@ protected:
     // Strategy interfaces for modular algorithm components
     std::unique_ptr<algorithms::TargetPrioritizer> target_prioritizer_;
     std::unique_ptr<algorithms::DeviceAssignmentStrategy> device_assignment_strategy_;
+    std::unique_ptr<algorithms::AssociationStrategy> association_strategy_;
     
     // Thread safety for strategy access
     mutable std::shared_mutex strategy_mutex_;
@@ -37,6 +38,14 @@ public:
         device_assignment_strategy_ = std::move(strategy);
     }
     
+    /**
+     * @brief Set measurement-to-track association strategy (thread-safe)
+     */
+    void set_association_strategy(std::unique_ptr<algorithms::AssociationStrategy> strategy) {
+        std::unique_lock lock(strategy_mutex_);
+        association_strategy_ = std::move(strategy);
+    }
+    
     /**
      * @brief Get target prioritizer (for use by algorithms) - thread-safe
      */
@@ -53,6 +62,14 @@ public:
         return device_assignment_strategy_.get();
     }
     
+    /**
+     * @brief Get association strategy (for use by algorithms) - thread-safe
+     */
+    algorithms::AssociationStrategy* get_association_strategy() const {
+        std::shared_lock lock(strategy_mutex_);
+        return association_strategy_.get();
+    }
+    
     /**
      * @brief Safe strategy access with RAII guard
      * Usage: with_target_prioritizer([&](auto& prioritizer) { return prioritizer.calculate_priority(target, context); })
@@ -77,6 +94,18 @@ public:
         }
         throw std::runtime_error("No device assignment strategy set");
     }
+    
+    /**
+     * @brief Safe association strategy access with RAII guard
+     */
+    template<typename Func>
+    auto with_association_strategy(Func&& func) const -> decltype(func(*association_strategy_)) {
+        std::shared_lock lock(strategy_mutex_);
+        if (association_strategy_) {
+            return func(*association_strategy_);
+        }
+        throw std::runtime_error("No association strategy set");
+    }
 };
 
 } // namespace dp_aero_l2::fusion
\ No newline at end of file
@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief Dense 32-bit handle of an interned identifier
+ *
+ * Handles of one Tag are numbered from 0 in interning order, so they can
+ * index flat arrays. A default-constructed handle refers to nothing.
+ */
+template<typename Tag>
+struct Symbol {
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    uint32_t id = kNone;
+
+    bool valid() const { return id != kNone; }
+    explicit operator bool() const { return valid(); }
+    auto operator<=>(const Symbol&) const = default;
+};
+
+/**
+ * @brief Interns the identifiers of one kind to dense Symbol handles
+ *
+ * Names are stored once and never move or go away, so name() is lock-free
+ * and its references stay valid for the table's lifetime. Interning a new
+ * name takes a writer lock. Looking up a known one first tries a small
+ * per-thread cache, which needs no invalidation since a name's handle never
+ * changes, and takes a reader lock only on a miss.
+ *
+ * Symbols are never freed and every SymbolMap keyed on them is sized to
+ * the largest handle, so a table only grows as far as whoever interns into
+ * it bounds it; past kMaxChunks * kChunkSize names intern() throws. Node ids
+ * arrive off the wire, so the fusion manager interns them only when it
+ * registers a sender, and at most L2Config::max_l1_nodes of them. Track ids
+ * are not interned at all: every track ever created would keep a symbol and
+ * a slot in every SymbolMap keyed on them.
+ */
+template<typename Tag>
+class SymbolTable {
+public:
+    static constexpr size_t kChunkSize = 4096;
+    static constexpr size_t kMaxChunks = 4096;  // Up to 16M names
+    static constexpr size_t kCacheSize = 64;    // Per-thread cache entries
+
+    SymbolTable() : serial_(next_serial()) {}
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /**
+     * @brief The table shared by the whole process
+     */
+    static SymbolTable& global() {
+        static SymbolTable table;
+        return table;
+    }
+
+    Symbol<Tag> intern(std::string_view name) {
+        if (auto symbol = find(name)) {
+            return symbol;
+        }
+        std::unique_lock lock(mutex_);
+        if (auto it = index_.find(name); it != index_.end()) {
+            return it->second;
+        }
+        const uint32_t id = size_.load(std::memory_order_relaxed);
+        if (id / kChunkSize >= kMaxChunks) {
+            throw std::length_error("Symbol table is full");
+        }
+        auto& chunk = chunks_[id / kChunkSize];
+        if (!chunk) {
+            chunk = std::make_unique<std::string[]>(kChunkSize);
+        }
+        std::string& stored = chunk[id % kChunkSize];
+        stored = name;
+        const Symbol<Tag> symbol{id};
+        index_.emplace(std::string_view(stored), symbol);
+        size_.store(id + 1, std::memory_order_release);
+        return symbol;
+    }
+
+    /**
+     * @brief The handle of a name, or an invalid one if it was never interned
+     */
+    Symbol<Tag> find(std::string_view name) const {
+        auto& cached = thread_cache()[std::hash<std::string_view>{}(name) % kCacheSize];
+        if (cached.table == serial_ && cached.name == name) {
+            return cached.symbol;
+        }
+
+        Symbol<Tag> symbol;
+        {
+            std::shared_lock lock(mutex_);
+            auto it = index_.find(name);
+            if (it == index_.end()) {
+                return symbol;
+            }
+            symbol = it->second;
+        }
+        cached.table = serial_;
+        cached.name = name;
+        cached.symbol = symbol;
+        return symbol;
+    }
+
+    const std::string& name(Symbol<Tag> symbol) const {
+        static const std::string none;
+        if (symbol.id >= size_.load(std::memory_order_acquire)) {
+            return none;
+        }
+        return chunks_[symbol.id / kChunkSize][symbol.id % kChunkSize];
+    }
+
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+private:
+    struct CacheEntry {
+        uint64_t table = 0;  // serial_ of the table it came from; 0 for none
+        std::string name;
+        Symbol<Tag> symbol;
+    };
+
+    static uint64_t next_serial() {
+        static std::atomic<uint64_t> serial{0};
+        return serial.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static std::array<CacheEntry, kCacheSize>& thread_cache() {
+        thread_local std::array<CacheEntry, kCacheSize> cache;
+        return cache;
+    }
+
+    const uint64_t serial_;  // Tells this table's cache entries from those of tables before it
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, Symbol<Tag>> index_;  // Views into chunks_
+    std::array<std::unique_ptr<std::string[]>, kMaxChunks> chunks_;
+    std::atomic<uint32_t> size_{0};
+};
+
+/**
+ * @brief Map from the symbols of one kind to values, as a flat array
+ *
+ * Lookups index the array directly. Meant for maps that hold a good share
+ * of their kind's symbols; the array is as long as the largest key.
+ */
+template<typename Tag, typename T>
+class SymbolMap {
+public:
+    T& operator[](Symbol<Tag> key) {
+        if (key.id >= slots_.size()) {
+            slots_.resize(key.id + 1);
+        }
+        auto& slot = slots_[key.id];
+        if (!slot) {
+            slot.emplace();
+            ++size_;
+        }
+        return *slot;
+    }
+
+    T* find(Symbol<Tag> key) {
+        return (key.id < slots_.size() && slots_[key.id]) ? &*slots_[key.id] : nullptr;
+    }
+
+    const T* find(Symbol<Tag> key) const {
+        return (key.id < slots_.size() && slots_[key.id]) ? &*slots_[key.id] : nullptr;
+    }
+
+    bool contains(Symbol<Tag> key) const { return find(key) != nullptr; }
+
+    bool erase(Symbol<Tag> key) {
+        if (!contains(key)) {
+            return false;
+        }
+        slots_[key.id].reset();
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Erase the entries for which pred(symbol, value) is true
+     * @return Number of entries erased
+     */
+    template<typename Pred>
+    size_t erase_if(Pred&& pred) {
+        size_t erased = 0;
+        for (uint32_t id = 0; id < slots_.size(); ++id) {
+            if (slots_[id] && pred(Symbol<Tag>{id}, *slots_[id])) {
+                slots_[id].reset();
+                ++erased;
+            }
+        }
+        size_ -= erased;
+        return erased;
+    }
+
+    /**
+     * @brief Call fn(symbol, value) for each entry, in symbol order
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        for (uint32_t id = 0; id < slots_.size(); ++id) {
+            if (slots_[id]) {
+                fn(Symbol<Tag>{id}, *slots_[id]);
+            }
+        }
+    }
+
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (uint32_t id = 0; id < slots_.size(); ++id) {
+            if (slots_[id]) {
+                fn(Symbol<Tag>{id}, *slots_[id]);
+            }
+        }
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void clear() {
+        slots_.clear();
+        size_ = 0;
+    }
+
+private:
+    std::vector<std::optional<T>> slots_;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Map from a few symbols to values, as an unsorted vector
+ *
+ * For per-object maps with a handful of entries, where a linear scan of
+ * 4-byte keys beats hashing.
+ */
+template<typename Tag, typename T>
+class SmallSymbolMap {
+public:
+    using value_type = std::pair<Symbol<Tag>, T>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    T& operator[](Symbol<Tag> key) {
+        if (T* value = find(key)) {
+            return *value;
+        }
+        return entries_.emplace_back(key, T{}).second;
+    }
+
+    T* find(Symbol<Tag> key) {
+        auto it = std::find_if(entries_.begin(), entries_.end(), [key](const auto& entry) { return entry.first == key; });
+        return (it != entries_.end()) ? &it->second : nullptr;
+    }
+
+    const T* find(Symbol<Tag> key) const {
+        auto it = std::find_if(entries_.begin(), entries_.end(), [key](const auto& entry) { return entry.first == key; });
+        return (it != entries_.end()) ? &it->second : nullptr;
+    }
+
+    const T& at(Symbol<Tag> key) const {
+        if (const T* value = find(key)) {
+            return *value;
+        }
+        throw std::out_of_range("SmallSymbolMap::at: no such key");
+    }
+
+    size_t count(Symbol<Tag> key) const { return find(key) ? 1 : 0; }
+
+    size_t erase(Symbol<Tag> key) {
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->first == key) {
+                *it = std::move(entries_.back());
+                entries_.pop_back();
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    void clear() { entries_.clear(); }
+
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+
+private:
+    std::vector<value_type> entries_;
+};
+
+// Identifier kinds. Devices are L1 nodes, so they share the node symbols
+struct NodeTag {};
+
+using NodeSymbol = Symbol<NodeTag>;
+
+inline NodeSymbol intern_node(std::string_view node_id) {
+    return SymbolTable<NodeTag>::global().intern(node_id);
+}
+
+/**
+ * @brief The identifier a symbol stands for, for logs and outbound messages
+ */
+template<typename Tag>
+const std::string& symbol_name(Symbol<Tag> symbol) {
+    return SymbolTable<Tag>::global().name(symbol);
+}
+
+} // namespace dp_aero_l2::core
+
+template<typename Tag>
+struct std::hash<dp_aero_l2::core::Symbol<Tag>> {
+    size_t operator()(dp_aero_l2::core::Symbol<Tag> symbol) const noexcept { return symbol.id; }
+};
@@ -2,7 +2,8 @@
 
 #include <string>
 #include <chrono>
-#include <unordered_map>
+
+#include "symbol_table.h"
 
 namespace dp_aero_l2::algorithms {
 
@@ -15,7 +16,8 @@ struct Target {
     float vx, vy, vz;       // Velocity
     float confidence;       // Confidence score
     std::chrono::steady_clock::time_point last_update;
-    std::unordered_map<std::string, int> sensor_detections; // Count per sensor
+    core::SmallSymbolMap<core::NodeTag, int> sensor_detections; // Count per sensor
+    std::chrono::steady_clock::time_point peer_owned_until{}; // Handed over to another L2 partition until then
     
     // Default constructor (required for std::unordered_map)
     Target() : target_id(""), x(0), y(0), z(0), vx(0), vy(0), vz(0), confidence(0) {}
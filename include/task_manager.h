@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <functional>
@@ -11,6 +14,12 @@
 #include <mutex>
 #include <optional>
 #include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+#include "slab_pool.h"
+#include "static_state_machine.h"
+#include "symbol_table.h"
 
 namespace dp_aero_l2::fusion {
 
@@ -45,51 +54,107 @@ struct TaskTransition {
 };
 
 /**
- * @brief Task state machine manager for individual tasks
+ * @brief Immutable task state machine graph, shared by all tasks of a type
+ *
+ * States and transitions are built once and then shared, as a
+ * shared_ptr<const TaskStateMachineDefinition>, by every TaskStateMachine
+ * running them. States are numbered in the order added; transitions are
+ * grouped by the state they leave. State data is part of the shared
+ * definition, so per-task data belongs in the Task's parameters.
  */
-class TaskStateMachine {
-private:
-    std::unordered_map<std::string, std::shared_ptr<TaskState>> states_;
-    std::vector<TaskTransition> transitions_;
-    std::string initial_state_;
-    std::string current_state_;
-    
+class TaskStateMachineDefinition {
 public:
+    using StateIndex = uint16_t;
+    
+    /**
+     * @brief Add a state; the first one added is the initial state unless set otherwise
+     */
     void add_state(const std::string& name, std::shared_ptr<TaskState> state) {
-        states_[name] = state;
-        if (initial_state_.empty()) {
-            initial_state_ = name;
-            current_state_ = name;
+        if (state_index_.contains(name)) {
+            throw std::invalid_argument("Task state " + name + " already defined");
         }
+        state_index_.emplace(name, static_cast<StateIndex>(states_.size()));
+        states_.push_back(std::move(state));
+        transitions_.emplace_back();
     }
     
+    /**
+     * @brief Add a transition between two states already added
+     */
     void add_transition(const TaskTransition& transition) {
-        transitions_.push_back(transition);
+        const StateIndex from = index_of(transition.from_state);
+        index_of(transition.to_state);
+        transitions_[from].push_back(transition);
     }
     
     void set_initial_state(const std::string& state_name) {
-        initial_state_ = state_name;
-        current_state_ = state_name;
+        initial_state_ = index_of(state_name);
     }
     
-    std::shared_ptr<TaskState> get_state(const std::string& name) const {
-        auto it = states_.find(name);
-        return (it != states_.end()) ? it->second : nullptr;
+    StateIndex get_initial_state() const { return initial_state_; }
+    size_t size() const { return states_.size(); }
+    
+    const TaskState& get_state(StateIndex index) const { return *states_[index]; }
+    
+    std::optional<StateIndex> find_state(const std::string& name) const {
+        auto it = state_index_.find(name);
+        return (it != state_index_.end()) ? std::make_optional(it->second) : std::nullopt;
     }
     
-    std::string get_current_state() const { return current_state_; }
-    std::string get_initial_state() const { return initial_state_; }
+    /**
+     * @brief The transitions leaving a state
+     */
+    const std::vector<TaskTransition>& get_transitions(StateIndex from) const { return transitions_[from]; }
+    
+private:
+    std::vector<std::shared_ptr<TaskState>> states_;
+    std::unordered_map<std::string, StateIndex> state_index_;
+    std::vector<std::vector<TaskTransition>> transitions_;  // Indexed by from-state
+    StateIndex initial_state_ = 0;
+    
+    StateIndex index_of(const std::string& name) const {
+        auto it = state_index_.find(name);
+        if (it == state_index_.end()) {
+            throw std::invalid_argument("Unknown task state " + name);
+        }
+        return it->second;
+    }
+};
+
+/**
+ * @brief A task's position in a shared TaskStateMachineDefinition
+ *
+ * Holds only the definition and the current state's index, so any number
+ * of tasks can run one definition without copying its states.
+ */
+class TaskStateMachine {
+private:
+    std::shared_ptr<const TaskStateMachineDefinition> definition_;
+    TaskStateMachineDefinition::StateIndex current_state_ = 0;
+    
+public:
+    TaskStateMachine() = default;
+    
+    explicit TaskStateMachine(std::shared_ptr<const TaskStateMachineDefinition> definition)
+        : definition_(std::move(definition)),
+          current_state_(definition_ ? definition_->get_initial_state() : 0) {}
+    
+    explicit operator bool() const { return definition_ && definition_->size() > 0; }
+    
+    const TaskStateMachineDefinition& get_definition() const { return *definition_; }
+    
+    const std::string& get_current_state() const { return definition_->get_state(current_state_).name; }
+    TaskStateMachineDefinition::StateIndex get_current_state_index() const { return current_state_; }
     
     bool try_transition(AlgorithmContext& context, const std::string& task_id, const std::string& trigger) {
-        for (const auto& transition : transitions_) {
-            if (transition.from_state == current_state_ && 
-                transition.trigger == trigger &&
+        for (const auto& transition : definition_->get_transitions(current_state_)) {
+            if (transition.trigger == trigger &&
                 (!transition.condition || transition.condition(context, task_id))) {
                 
                 // Exit current state
-                auto current_state_obj = get_state(current_state_);
-                if (current_state_obj && current_state_obj->on_exit) {
-                    current_state_obj->on_exit(context, task_id);
+                const auto& current_state_obj = definition_->get_state(current_state_);
+                if (current_state_obj.on_exit) {
+                    current_state_obj.on_exit(context, task_id);
                 }
                 
                 // Execute transition action
@@ -98,11 +163,10 @@ public:
                 }
                 
                 // Enter new state
-                current_state_ = transition.to_state;
-                auto new_state_obj = get_state(transition.to_state);
-                
-                if (new_state_obj && new_state_obj->on_enter) {
-                    new_state_obj->on_enter(context, task_id);
+                current_state_ = *definition_->find_state(transition.to_state);
+                const auto& new_state_obj = definition_->get_state(current_state_);
+                if (new_state_obj.on_enter) {
+                    new_state_obj.on_enter(context, task_id);
                 }
                 
                 return true;
@@ -112,15 +176,34 @@ public:
     }
     
     void update(AlgorithmContext& context, const std::string& task_id) {
-        auto current_state_obj = get_state(current_state_);
-        if (current_state_obj && current_state_obj->on_update) {
-            current_state_obj->on_update(context, task_id);
+        const auto& current_state_obj = definition_->get_state(current_state_);
+        if (current_state_obj.on_update) {
+            current_state_obj.on_update(context, task_id);
         }
     }
-    
-    const std::vector<TaskTransition>& get_transitions() const { return transitions_; }
 };
 
+/**
+ * @brief The default task lifecycle, as a compile-time state machine
+ */
+struct TaskLifecycle {
+    enum class State : uint8_t { INITIALIZING, EXECUTING, COMPLETING, ERROR, Count };
+    enum class Trigger : uint8_t { START, COMPLETE, ERROR, RETRY, Count };
+    
+    static constexpr State initial = State::INITIALIZING;
+    static constexpr std::array<std::string_view, 4> state_names = {"INITIALIZING", "EXECUTING", "COMPLETING", "ERROR"};
+    static constexpr std::array<std::string_view, 4> trigger_names = {"start", "complete", "error", "retry"};
+    static constexpr std::array<StaticTransition<State, Trigger>, 5> transitions = {{
+        {State::INITIALIZING, Trigger::START, State::EXECUTING},
+        {State::EXECUTING, Trigger::COMPLETE, State::COMPLETING},
+        {State::INITIALIZING, Trigger::ERROR, State::ERROR},
+        {State::EXECUTING, Trigger::ERROR, State::ERROR},
+        {State::ERROR, Trigger::RETRY, State::INITIALIZING},
+    }};
+};
+
+using TaskLifecycleMachine = StaticStateMachine<TaskLifecycle>;
+
 /**
  * @brief Represents a task assigned to a device for a specific target
  */
@@ -155,6 +238,7 @@ private:
     std::string task_id_;
     std::string target_id_;
     std::string device_id_;
+    core::NodeSymbol device_;
     Type type_;
     Priority priority_;
     Status status_;
@@ -165,24 +249,29 @@ private:
     std::chrono::steady_clock::time_point completed_time_;
     
     std::unordered_map<std::string, std::any> parameters_;
-    std::unique_ptr<TaskStateMachine> state_machine_;
+    TaskLifecycleMachine state_machine_;
+    TaskStateMachine custom_state_machine_;  // Runs instead of state_machine_ if its type has a definition
     
     // Progress tracking
     float progress_percentage_{0.0f};
     std::string status_message_;
     
 public:
-    Task(const std::string& task_id, const std::string& target_id, Type type, Priority priority = Priority::NORMAL)
-        : task_id_(task_id), target_id_(target_id), type_(type), priority_(priority), 
+    /**
+     * @param definition Shared state machine to run instead of the default TaskLifecycle
+     */
+    Task(const std::string& task_id, const std::string& target_id, Type type, Priority priority = Priority::NORMAL,
+         std::shared_ptr<const TaskStateMachineDefinition> definition = nullptr)
+        : task_id_(task_id), target_id_(target_id),
+          type_(type), priority_(priority), 
           status_(Status::CREATED), created_time_(std::chrono::steady_clock::now()),
-          state_machine_(std::make_unique<TaskStateMachine>()) {
-        setup_default_state_machine();
-    }
+          custom_state_machine_(std::move(definition)) {}
     
     // Getters
     const std::string& get_task_id() const { return task_id_; }
     const std::string& get_target_id() const { return target_id_; }
     const std::string& get_device_id() const { return device_id_; }
+    core::NodeSymbol get_device_symbol() const { return device_; }
     Type get_type() const { return type_; }
     Priority get_priority() const { return priority_; }
     Status get_status() const { return status_; }
@@ -198,6 +287,7 @@ public:
     // Setters
     void set_device_id(const std::string& device_id) { 
         device_id_ = device_id; 
+        device_ = core::intern_node(device_id);
         if (status_ == Status::CREATED) {
             status_ = Status::ASSIGNED;
             assigned_time_ = std::chrono::steady_clock::now();
@@ -249,15 +339,37 @@ public:
     }
     
     // State machine operations
-    TaskStateMachine* get_state_machine() { return state_machine_.get(); }
-    const TaskStateMachine* get_state_machine() const { return state_machine_.get(); }
+    const TaskLifecycleMachine& get_state_machine() const { return state_machine_; }
+    
+    /**
+     * @brief The shared state machine the task runs, or nullptr if it runs the default lifecycle
+     */
+    const TaskStateMachine* get_custom_state_machine() const {
+        return custom_state_machine_ ? &custom_state_machine_ : nullptr;
+    }
+    
+    std::string_view get_state_name() const {
+        return custom_state_machine_ ? std::string_view(custom_state_machine_.get_current_state())
+                                     : state_machine_.state_name();
+    }
+    
+    bool trigger_state_transition(TaskLifecycle::Trigger trigger) {
+        return !custom_state_machine_ && state_machine_.fire(trigger);
+    }
     
     bool trigger_state_transition(AlgorithmContext& context, const std::string& trigger) {
-        return state_machine_->try_transition(context, task_id_, trigger);
+        if (custom_state_machine_) {
+            return custom_state_machine_.try_transition(context, task_id_, trigger);
+        }
+        auto parsed = TaskLifecycleMachine::parse_trigger(trigger);
+        return parsed && trigger_state_transition(*parsed);
     }
     
     void update_state_machine(AlgorithmContext& context) {
-        state_machine_->update(context, task_id_);
+        // The default lifecycle states have no update behaviour
+        if (custom_state_machine_) {
+            custom_state_machine_.update(context, task_id_);
+        }
     }
     
     // Utility methods
@@ -303,114 +415,135 @@ public:
             default: return "UNKNOWN";
         }
     }
-
-private:
-    void setup_default_state_machine() {
-        // Create default task states
-        auto initializing_state = std::make_shared<TaskState>("INITIALIZING");
-        initializing_state->on_enter = [](AlgorithmContext& ctx, const std::string& task_id) {
-            // Initialization logic
-        };
-        
-        auto executing_state = std::make_shared<TaskState>("EXECUTING");
-        executing_state->on_update = [](AlgorithmContext& ctx, const std::string& task_id) {
-            // Main task execution logic
-        };
-        
-        auto completing_state = std::make_shared<TaskState>("COMPLETING");
-        completing_state->on_enter = [](AlgorithmContext& ctx, const std::string& task_id) {
-            // Cleanup and completion logic
-        };
-        
-        auto error_state = std::make_shared<TaskState>("ERROR");
-        error_state->on_enter = [](AlgorithmContext& ctx, const std::string& task_id) {
-            // Error handling logic
-        };
-        
-        // Add states
-        state_machine_->add_state("INITIALIZING", initializing_state);
-        state_machine_->add_state("EXECUTING", executing_state);
-        state_machine_->add_state("COMPLETING", completing_state);
-        state_machine_->add_state("ERROR", error_state);
-        
-        // Set initial state
-        state_machine_->set_initial_state("INITIALIZING");
-        
-        // Define transitions
-        state_machine_->add_transition(TaskTransition("INITIALIZING", "EXECUTING", "start"));
-        state_machine_->add_transition(TaskTransition("EXECUTING", "COMPLETING", "complete"));
-        state_machine_->add_transition(TaskTransition("INITIALIZING", "ERROR", "error"));
-        state_machine_->add_transition(TaskTransition("EXECUTING", "ERROR", "error"));
-        state_machine_->add_transition(TaskTransition("ERROR", "INITIALIZING", "retry"));
-    }
 };
 
 /**
  * @brief Manages assignments between targets, devices, and tasks
+ *
+ * Task and device ids are strings only at this API; target ids stay
+ * strings, since new tracks keep coming and interned symbols are never
+ * freed. Tasks live in
+ * a slab pool, and a task id ("task_<slot>_<generation>") is its
+ * generation-checked handle: looking it up goes straight to the slot, and
+ * an id outliving its task never resolves to the task reusing it. Each
+ * target's and each device's tasks form intrusive lists threaded through
+ * the pool's slots, so removing a task unlinks it in O(1). Completed tasks
+ * are reclaimed a few slots at a time on each update, never by a full scan.
  */
 class TaskManager {
 private:
+    using TaskPool = core::SlabPool<Task>;
+    using TaskHandle = TaskPool::Handle;
+    
+    static constexpr uint32_t kNoSlot = TaskPool::kNoSlot;
+    static constexpr size_t kReclaimBudget = 64;  // Slots visited per reclaim step
+    
+    struct TaskList {
+        uint32_t head = kNoSlot;
+        uint32_t tail = kNoSlot;
+    };
+    
+    // A target with at least one task: its tasks and the device last assigned one
+    struct TargetEntry {
+        TaskList tasks;
+        core::NodeSymbol primary_device;
+    };
+    
+    // A task's target and its neighbours in its target's and its device's lists, by slot
+    struct TaskLinks {
+        TargetEntry* target = nullptr;
+        uint32_t prev_target = kNoSlot;
+        uint32_t next_target = kNoSlot;
+        uint32_t prev_device = kNoSlot;
+        uint32_t next_device = kNoSlot;
+    };
+    
     mutable std::shared_mutex mutex_;
     
     // Core mappings
-    std::unordered_map<std::string, std::unique_ptr<Task>> tasks_;                    // task_id -> Task
-    std::unordered_map<std::string, std::vector<std::string>> target_to_tasks_;      // target_id -> task_ids
-    std::unordered_map<std::string, std::vector<std::string>> device_to_tasks_;      // device_id -> task_ids
+    TaskPool tasks_;
+    std::vector<TaskLinks> links_;                           // Indexed by slot
+    std::unordered_map<std::string, TargetEntry> targets_;   // Erased with their last task
+    core::SymbolMap<core::NodeTag, TaskList> device_to_tasks_;
     
     // Assignment tracking
-    std::unordered_map<std::string, std::string> target_primary_device_;             // target_id -> primary_device_id
-    std::unordered_map<std::string, std::vector<std::string>> device_capabilities_;  // device_id -> capabilities
+    core::SymbolMap<core::NodeTag, std::vector<std::string>> device_capabilities_;
     
-    // Statistics
-    uint64_t next_task_id_{1};
-    std::chrono::steady_clock::time_point last_cleanup_time_;
+    // State machine shared by the tasks of each type; none: the default TaskLifecycle
+    std::array<std::shared_ptr<const TaskStateMachineDefinition>,
+               static_cast<size_t>(Task::Type::MONITOR_STATUS) + 1> task_definitions_;
     
+    // Reclaiming completed tasks
+    std::chrono::steady_clock::duration completed_task_retention_ = std::chrono::hours(1);
+    uint32_t reclaim_cursor_ = 0;  // Next slot to visit
+
 public:
-    TaskManager() : last_cleanup_time_(std::chrono::steady_clock::now()) {}
-    
     /**
      * @brief Create a new task for a target
      */
     std::string create_task(const std::string& target_id, Task::Type type, Task::Priority priority = Task::Priority::NORMAL) {
         std::unique_lock lock(mutex_);
         
-        std::string task_id = "task_" + std::to_string(next_task_id_++);
-        auto task = std::make_unique<Task>(task_id, target_id, type, priority);
-        
-        tasks_[task_id] = std::move(task);
-        target_to_tasks_[target_id].push_back(task_id);
+        const TaskHandle next = tasks_.next_handle();
+        std::string task_id = "task_" + std::to_string(next.index) + "_" + std::to_string(next.generation);
+        const TaskHandle handle = tasks_.emplace(task_id, target_id, type, priority,
+                                                 task_definitions_[static_cast<size_t>(type)]);
+        if (links_.size() < tasks_.capacity()) {
+            links_.resize(tasks_.capacity());
+        }
+        TargetEntry& target = targets_[target_id];
+        links_[handle.index] = TaskLinks{.target = &target};
+        link<&TaskLinks::prev_target, &TaskLinks::next_target>(target.tasks, handle.index);
         
         return task_id;
     }
     
+    /**
+     * @brief Set the state machine that tasks of a type created from now on run
+     *
+     * The definition is shared, not copied: each task only tracks its
+     * current state in it. Pass nullptr to go back to the default lifecycle.
+     */
+    void set_task_definition(Task::Type type, std::shared_ptr<const TaskStateMachineDefinition> definition) {
+        std::unique_lock lock(mutex_);
+        task_definitions_[static_cast<size_t>(type)] = std::move(definition);
+    }
+    
+    /**
+     * @brief How long completed tasks are kept before the reclaimer removes them
+     */
+    void set_completed_task_retention(std::chrono::steady_clock::duration retention) {
+        std::unique_lock lock(mutex_);
+        completed_task_retention_ = retention;
+    }
+    
     /**
      * @brief Assign a task to a specific device
      */
     bool assign_task_to_device(const std::string& task_id, const std::string& device_id) {
         std::unique_lock lock(mutex_);
         
-        auto task_it = tasks_.find(task_id);
-        if (task_it == tasks_.end()) {
+        const TaskHandle handle = handle_of(task_id);
+        Task* task = tasks_.get(handle);
+        if (!task) {
             return false;
         }
         
-        auto& task = task_it->second;
-        
         // Remove from previous device assignment if exists
-        if (!task->get_device_id().empty()) {
-            auto& prev_device_tasks = device_to_tasks_[task->get_device_id()];
-            prev_device_tasks.erase(
-                std::remove(prev_device_tasks.begin(), prev_device_tasks.end(), task_id),
-                prev_device_tasks.end()
-            );
+        if (auto* prev_device_tasks = device_to_tasks_.find(task->get_device_symbol())) {
+            unlink<&TaskLinks::prev_device, &TaskLinks::next_device>(*prev_device_tasks, handle.index);
+            if (prev_device_tasks->head == kNoSlot) {
+                device_to_tasks_.erase(task->get_device_symbol());
+            }
         }
         
         // Assign to new device
         task->set_device_id(device_id);
-        device_to_tasks_[device_id].push_back(task_id);
+        link<&TaskLinks::prev_device, &TaskLinks::next_device>(
+            device_to_tasks_[task->get_device_symbol()], handle.index);
         
         // Update primary device mapping for target
-        target_primary_device_[task->get_target_id()] = device_id;
+        links_[handle.index].target->primary_device = task->get_device_symbol();
         
         return true;
     }
@@ -420,14 +553,12 @@ public:
      */
     Task* get_task(const std::string& task_id) {
         std::shared_lock lock(mutex_);
-        auto it = tasks_.find(task_id);
-        return (it != tasks_.end()) ? it->second.get() : nullptr;
+        return tasks_.get(handle_of(task_id));
     }
     
     const Task* get_task(const std::string& task_id) const {
         std::shared_lock lock(mutex_);
-        auto it = tasks_.find(task_id);
-        return (it != tasks_.end()) ? it->second.get() : nullptr;
+        return tasks_.get(handle_of(task_id));
     }
     
     /**
@@ -435,19 +566,8 @@ public:
      */
     std::vector<Task*> get_tasks_for_target(const std::string& target_id) {
         std::shared_lock lock(mutex_);
-        std::vector<Task*> result;
-        
-        auto it = target_to_tasks_.find(target_id);
-        if (it != target_to_tasks_.end()) {
-            for (const auto& task_id : it->second) {
-                auto task_it = tasks_.find(task_id);
-                if (task_it != tasks_.end()) {
-                    result.push_back(task_it->second.get());
-                }
-            }
-        }
-        
-        return result;
+        auto it = targets_.find(target_id);
+        return tasks_of<&TaskLinks::next_target>(it != targets_.end() ? &it->second.tasks : nullptr);
     }
     
     /**
@@ -455,19 +575,8 @@ public:
      */
     std::vector<Task*> get_tasks_for_device(const std::string& device_id) {
         std::shared_lock lock(mutex_);
-        std::vector<Task*> result;
-        
-        auto it = device_to_tasks_.find(device_id);
-        if (it != device_to_tasks_.end()) {
-            for (const auto& task_id : it->second) {
-                auto task_it = tasks_.find(task_id);
-                if (task_it != tasks_.end()) {
-                    result.push_back(task_it->second.get());
-                }
-            }
-        }
-        
-        return result;
+        return tasks_of<&TaskLinks::next_device>(
+            device_to_tasks_.find(core::SymbolTable<core::NodeTag>::global().find(device_id)));
     }
     
     /**
@@ -475,8 +584,11 @@ public:
      */
     std::optional<std::string> get_primary_device_for_target(const std::string& target_id) const {
         std::shared_lock lock(mutex_);
-        auto it = target_primary_device_.find(target_id);
-        return (it != target_primary_device_.end()) ? std::make_optional(it->second) : std::nullopt;
+        auto it = targets_.find(target_id);
+        if (it == targets_.end() || !it->second.primary_device) {
+            return std::nullopt;
+        }
+        return core::symbol_name(it->second.primary_device);
     }
     
     /**
@@ -484,7 +596,7 @@ public:
      */
     void register_device_capabilities(const std::string& device_id, const std::vector<std::string>& capabilities) {
         std::unique_lock lock(mutex_);
-        device_capabilities_[device_id] = capabilities;
+        device_capabilities_[core::intern_node(device_id)] = capabilities;
     }
     
     /**
@@ -492,8 +604,8 @@ public:
      */
     std::vector<std::string> get_device_capabilities(const std::string& device_id) const {
         std::shared_lock lock(mutex_);
-        auto it = device_capabilities_.find(device_id);
-        return (it != device_capabilities_.end()) ? it->second : std::vector<std::string>{};
+        const auto* capabilities = device_capabilities_.find(core::SymbolTable<core::NodeTag>::global().find(device_id));
+        return capabilities ? *capabilities : std::vector<std::string>{};
     }
     
     /**
@@ -501,65 +613,52 @@ public:
      */
     bool remove_task(const std::string& task_id) {
         std::unique_lock lock(mutex_);
-        
-        auto task_it = tasks_.find(task_id);
-        if (task_it == tasks_.end()) {
-            return false;
-        }
-        
-        const auto& task = task_it->second;
-        const std::string& target_id = task->get_target_id();
-        const std::string& device_id = task->get_device_id();
-        
-        // Remove from target mapping
-        auto target_it = target_to_tasks_.find(target_id);
-        if (target_it != target_to_tasks_.end()) {
-            auto& task_list = target_it->second;
-            task_list.erase(std::remove(task_list.begin(), task_list.end(), task_id), task_list.end());
-            
-            if (task_list.empty()) {
-                target_to_tasks_.erase(target_it);
-                target_primary_device_.erase(target_id);
-            }
-        }
-        
-        // Remove from device mapping
-        if (!device_id.empty()) {
-            auto device_it = device_to_tasks_.find(device_id);
-            if (device_it != device_to_tasks_.end()) {
-                auto& task_list = device_it->second;
-                task_list.erase(std::remove(task_list.begin(), task_list.end(), task_id), task_list.end());
-                
-                if (task_list.empty()) {
-                    device_to_tasks_.erase(device_it);
+        return remove_task(handle_of(task_id));
+    }
+    
+    /**
+     * @brief Update all active tasks, then take one step of reclaiming completed ones
+     */
+    void update_all_tasks(AlgorithmContext& context) {
+        {
+            std::shared_lock lock(mutex_);
+            tasks_.for_each([&](TaskHandle, Task& task) {
+                if (task.is_active()) {
+                    task.update_state_machine(context);
                 }
-            }
+            });
         }
         
-        // Remove task itself
-        tasks_.erase(task_it);
-        return true;
+        reclaim_completed_tasks();
     }
     
     /**
-     * @brief Update all active tasks
+     * @brief Remove the tasks completed longer than the retention ago among the next budget slots
+     *
+     * Each call resumes where the previous one stopped and wraps around, so
+     * repeated calls cover the whole pool while each holds the lock only
+     * for a bounded number of slots.
+     *
+     * @return Number of tasks removed
      */
-    void update_all_tasks(AlgorithmContext& context) {
-        std::shared_lock lock(mutex_);
+    size_t reclaim_completed_tasks(size_t budget = kReclaimBudget) {
+        std::unique_lock lock(mutex_);
+        const auto cutoff = std::chrono::steady_clock::now() - completed_task_retention_;
+        const size_t slots = std::min(budget, tasks_.capacity());
         
-        for (auto& [task_id, task] : tasks_) {
-            if (task->is_active()) {
-                task->update_state_machine(context);
+        size_t removed = 0;
+        for (size_t visited = 0; visited < slots; ++visited) {
+            if (reclaim_cursor_ >= tasks_.capacity()) {
+                reclaim_cursor_ = 0;
+            }
+            const TaskHandle handle = tasks_.handle_at(reclaim_cursor_++);
+            const Task* task = tasks_.get(handle);
+            if (task && task->is_completed() && task->get_completed_time() <= cutoff) {
+                remove_task(handle);
+                ++removed;
             }
         }
-        
-        // Periodic cleanup
-        auto now = std::chrono::steady_clock::now();
-        if (now - last_cleanup_time_ > std::chrono::minutes(5)) {
-            // Note: This would need to be done with unique_lock, but keeping simple for now
-            // cleanup_completed_tasks();
-            last_cleanup_time_ = now;
-        }
+        return removed;
     }
     
     /**
@@ -569,11 +668,11 @@ public:
         std::shared_lock lock(mutex_);
         std::vector<Task*> result;
         
-        for (auto& [task_id, task] : tasks_) {
-            if (task->is_active()) {
-                result.push_back(task.get());
+        tasks_.for_each([&](TaskHandle, Task& task) {
+            if (task.is_active()) {
+                result.push_back(&task);
             }
-        }
+        });
         
         return result;
     }
@@ -596,10 +695,11 @@ public:
         
         stats.total_tasks = tasks_.size();
         stats.registered_devices = device_capabilities_.size();
-        stats.targets_with_assignments = target_primary_device_.size();
+        stats.targets_with_assignments = static_cast<size_t>(std::count_if(
+            targets_.begin(), targets_.end(), [](const auto& entry) { return entry.second.primary_device.valid(); }));
         
-        for (const auto& [task_id, task] : tasks_) {
-            switch (task->get_status()) {
+        tasks_.for_each([&](TaskHandle, const Task& task) {
+            switch (task.get_status()) {
                 case Task::Status::ACTIVE:
                     stats.active_tasks++;
                     break;
@@ -613,7 +713,7 @@ public:
                 default:
                     break;
             }
-        }
+        });
         
         return stats;
     }
@@ -624,27 +724,89 @@ public:
     void clear_all() {
         std::unique_lock lock(mutex_);
         tasks_.clear();
-        target_to_tasks_.clear();
+        targets_.clear();
         device_to_tasks_.clear();
-        target_primary_device_.clear();
         // Keep device_capabilities_ as they represent persistent device info
     }
 
 private:
-    void cleanup_completed_tasks() {
-        // Remove completed tasks older than 1 hour
-        auto cutoff_time = std::chrono::steady_clock::now() - std::chrono::hours(1);
+    // The handle a "task_<slot>_<generation>" id spells out; invalid if it is malformed
+    static TaskHandle handle_of(std::string_view task_id) {
+        constexpr std::string_view prefix = "task_";
+        if (!task_id.starts_with(prefix)) {
+            return TaskHandle{};
+        }
+        TaskHandle handle;
+        const char* end = task_id.data() + task_id.size();
+        auto [index_end, index_error] = std::from_chars(task_id.data() + prefix.size(), end, handle.index);
+        if (index_error != std::errc{} || index_end == end || *index_end != '_') {
+            return TaskHandle{};
+        }
+        auto [generation_end, generation_error] = std::from_chars(index_end + 1, end, handle.generation);
+        if (generation_error != std::errc{} || generation_end != end) {
+            return TaskHandle{};
+        }
+        return handle;
+    }
+    
+    // Append a slot to a list threaded through the Prev/Next links
+    template<uint32_t TaskLinks::*Prev, uint32_t TaskLinks::*Next>
+    void link(TaskList& list, uint32_t slot) {
+        links_[slot].*Prev = list.tail;
+        links_[slot].*Next = kNoSlot;
+        if (list.tail != kNoSlot) {
+            links_[list.tail].*Next = slot;
+        } else {
+            list.head = slot;
+        }
+        list.tail = slot;
+    }
+    
+    template<uint32_t TaskLinks::*Prev, uint32_t TaskLinks::*Next>
+    void unlink(TaskList& list, uint32_t slot) {
+        const uint32_t prev = links_[slot].*Prev;
+        const uint32_t next = links_[slot].*Next;
+        (prev != kNoSlot ? links_[prev].*Next : list.head) = next;
+        (next != kNoSlot ? links_[next].*Prev : list.tail) = prev;
+        links_[slot].*Prev = kNoSlot;
+        links_[slot].*Next = kNoSlot;
+    }
+    
+    template<uint32_t TaskLinks::*Next>
+    std::vector<Task*> tasks_of(const TaskList* list) {
+        std::vector<Task*> result;
+        for (uint32_t slot = list ? list->head : kNoSlot; slot != kNoSlot; slot = links_[slot].*Next) {
+            result.push_back(tasks_.get(tasks_.handle_at(slot)));
+        }
+        return result;
+    }
+    
+    bool remove_task(TaskHandle handle) {
+        const Task* task = tasks_.get(handle);
+        if (!task) {
+            return false;
+        }
         
-        std::vector<std::string> tasks_to_remove;
-        for (const auto& [task_id, task] : tasks_) {
-            if (task->is_completed() && task->get_completed_time() < cutoff_time) {
-                tasks_to_remove.push_back(task_id);
-            }
+        const auto device = task->get_device_symbol();
+        
+        // Remove from target mapping, and the target with its last task
+        TargetEntry* target = links_[handle.index].target;
+        unlink<&TaskLinks::prev_target, &TaskLinks::next_target>(target->tasks, handle.index);
+        if (target->tasks.head == kNoSlot) {
+            targets_.erase(task->get_target_id());
         }
         
-        for (const auto& task_id : tasks_to_remove) {
-            remove_task(task_id);
+        // Remove from device mapping
+        if (auto* task_list = device_to_tasks_.find(device)) {
+            unlink<&TaskLinks::prev_device, &TaskLinks::next_device>(*task_list, handle.index);
+            if (task_list->head == kNoSlot) {
+                device_to_tasks_.erase(device);
+            }
         }
+        
+        // Remove task itself
+        tasks_.erase(handle);
+        return true;
     }
 };
 
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "target.h"
+#include "spatial_grid.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace dp_aero_l2::algorithms {
+
+/**
+ * @brief Typed storage for live tracks
+ *
+ * Lives in an AlgorithmContext slot (see AlgorithmContext::emplace_data) so
+ * algorithms mutate tracks in place instead of copying the whole map out of
+ * std::any and back on every step. References returned by create() and
+ * find() stay valid until the track is erased.
+ *
+ * A SpatialGrid keyed on the association gate indexes track positions, so
+ * code that moves a track must call relocate() afterwards.
+ */
+class TrackStore {
+public:
+    using Map = std::unordered_map<std::string, Target>;
+    using iterator = Map::iterator;
+    using const_iterator = Map::const_iterator;
+
+private:
+    Map targets_;
+    SpatialGrid grid_;
+    uint64_t next_id_{0};
+
+public:
+    /**
+     * @param cell_size Spatial index cell size; match the association gate
+     */
+    explicit TrackStore(float cell_size = 5.0f) : grid_(cell_size) {}
+
+    // Copies rebuild the index so it points at the copy's own targets
+    TrackStore(const TrackStore& other)
+        : targets_(other.targets_), grid_(other.grid_.cell_size()), next_id_(other.next_id_) {
+        rebuild_index();
+    }
+
+    TrackStore& operator=(const TrackStore& other) {
+        if (this != &other) {
+            targets_ = other.targets_;
+            grid_ = SpatialGrid(other.grid_.cell_size());
+            next_id_ = other.next_id_;
+            rebuild_index();
+        }
+        return *this;
+    }
+
+    // Map nodes keep their addresses on move, so the index stays valid
+    TrackStore(TrackStore&&) = default;
+    TrackStore& operator=(TrackStore&&) = default;
+
+    /**
+     * @brief Create a track with the next generated id ("target_<n>")
+     */
+    Target& create() {
+        std::string target_id;
+        do {
+            target_id = "target_" + std::to_string(next_id_++);
+        } while (targets_.count(target_id) > 0);
+        return create(target_id);
+    }
+
+    /**
+     * @brief Create (or reset) a track with an explicit id
+     */
+    Target& create(const std::string& target_id) {
+        auto& target = targets_[target_id];
+        target = Target(target_id);
+        grid_.update(&target);
+        return target;
+    }
+
+    Target* find(const std::string& target_id) {
+        auto it = targets_.find(target_id);
+        return (it != targets_.end()) ? &it->second : nullptr;
+    }
+
+    const Target* find(const std::string& target_id) const {
+        auto it = targets_.find(target_id);
+        return (it != targets_.end()) ? &it->second : nullptr;
+    }
+
+    bool erase(const std::string& target_id) {
+        auto it = targets_.find(target_id);
+        if (it == targets_.end()) {
+            return false;
+        }
+        grid_.erase(&it->second);
+        targets_.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Move a track into another store, keeping its id and address
+     * @return False if no track has that id or the destination already does
+     */
+    bool transfer(const std::string& target_id, TrackStore& destination) {
+        auto node = targets_.extract(target_id);
+        if (node.empty()) {
+            return false;
+        }
+        auto result = destination.targets_.insert(std::move(node));
+        if (!result.inserted) {
+            targets_.insert(std::move(result.node));
+            return false;
+        }
+        grid_.erase(&result.position->second);
+        destination.grid_.update(&result.position->second);
+        return true;
+    }
+
+    /**
+     * @brief Refresh the spatial index after a track's position changed
+     */
+    void relocate(Target& target) {
+        grid_.update(&target);
+    }
+
+    /**
+     * @brief Remove every track matching the predicate
+     * @param pred Called with (const std::string& id, const Target&)
+     * @return Number of removed tracks
+     */
+    template<typename Pred>
+    size_t erase_if(Pred&& pred) {
+        return std::erase_if(targets_, [this, &pred](const auto& target_pair) {
+            bool remove = pred(target_pair.first, target_pair.second);
+            if (remove) {
+                grid_.erase(&target_pair.second);
+            }
+            return remove;
+        });
+    }
+
+    /**
+     * @brief Find the closest track within max_distance of a position
+     * @return Closest track, or nullptr if none is inside the gate
+     */
+    Target* find_closest(float x, float y, float z, float max_distance) {
+        return grid_.find_nearest(x, y, z, max_distance);
+    }
+
+    /**
+     * @brief Every track strictly inside radius of a position
+     * @param out Receives (target, squared distance) pairs; cleared first
+     */
+    void find_within(float x, float y, float z, float radius,
+                     std::vector<std::pair<Target*, float>>& out) const {
+        grid_.query_radius(x, y, z, radius, out);
+    }
+
+    const SpatialGrid& spatial_index() const { return grid_; }
+
+    /**
+     * @brief Remove all tracks; ids keep counting, so later tracks never reuse an earlier track's id
+     */
+    void clear() {
+        targets_.clear();
+        grid_.clear();
+    }
+
+    size_t size() const { return targets_.size(); }
+    bool empty() const { return targets_.empty(); }
+
+    iterator begin() { return targets_.begin(); }
+    iterator end() { return targets_.end(); }
+    const_iterator begin() const { return targets_.begin(); }
+    const_iterator end() const { return targets_.end(); }
+
+private:
+    void rebuild_index() {
+        for (auto& [id, target] : targets_) {
+            grid_.insert(&target);
+        }
+    }
+};
+
+} // namespace dp_aero_l2::algorithms
@@ -0,0 +1,327 @@
+#pragma once
+
+#include "target.h"
+#include "track_store.h"
+#include "sharded_track_store.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace dp_aero_l2::algorithms {
+
+/**
+ * @brief Structure-of-arrays track table for bulk kernels
+ *
+ * Kinematic state lives in contiguous per-field columns addressed by dense
+ * indices, with a side map from track id to row. Removal swaps the last row
+ * into the hole, so indices are only stable until the next remove().
+ *
+ * The kernels are plain loops over raw column pointers with no calls or
+ * aliasing in the body, which GCC/Clang vectorize at -O2/-O3.
+ */
+class TrackTable {
+public:
+    using Index = uint32_t;
+    using Clock = std::chrono::steady_clock;
+    static constexpr Index npos = std::numeric_limits<Index>::max();
+
+private:
+    std::vector<float> x_, y_, z_;
+    std::vector<float> vx_, vy_, vz_;
+    std::vector<float> confidence_;
+    std::vector<Clock::rep> last_update_;
+
+    // Row -> id and id -> row. Track ids are not interned (see core::SymbolTable),
+    // so the table keeps its own map, bounded by its rows.
+    std::vector<std::string> ids_;
+    std::unordered_map<std::string, Index> index_;
+
+    // Scratch buffer reused by the gating kernels
+    mutable std::vector<float> distance_sq_;
+
+public:
+    TrackTable() = default;
+
+    /**
+     * @brief Build a table from the live track store
+     */
+    static TrackTable from_store(const TrackStore& store) {
+        TrackTable table;
+        table.reserve(store.size());
+        for (const auto& [id, target] : store) {
+            table.add(target);
+        }
+        return table;
+    }
+
+    /**
+     * @brief Build a table from every shard of a sharded track store
+     *
+     * Requires exclusive access to the store, like its other whole-store operations.
+     */
+    static TrackTable from_store(const ShardedTrackStore& store) {
+        TrackTable table;
+        table.reserve(store.size());
+        for (const auto& [id, target] : store) {
+            table.add(target);
+        }
+        return table;
+    }
+
+    void reserve(size_t capacity) {
+        for (auto* column : {&x_, &y_, &z_, &vx_, &vy_, &vz_, &confidence_}) {
+            column->reserve(capacity);
+        }
+        last_update_.reserve(capacity);
+        ids_.reserve(capacity);
+        index_.reserve(capacity);
+    }
+
+    /**
+     * @brief Add a row for a target, or overwrite the row with the same id
+     * @return Row index of the target
+     */
+    Index add(const Target& target) {
+        auto it = index_.find(target.target_id);
+        if (it != index_.end()) {
+            store(it->second, target);
+            return it->second;
+        }
+
+        auto row = static_cast<Index>(ids_.size());
+        x_.push_back(target.x);
+        y_.push_back(target.y);
+        z_.push_back(target.z);
+        vx_.push_back(target.vx);
+        vy_.push_back(target.vy);
+        vz_.push_back(target.vz);
+        confidence_.push_back(target.confidence);
+        last_update_.push_back(target.last_update.time_since_epoch().count());
+        ids_.push_back(target.target_id);
+        index_.emplace(target.target_id, row);
+        return row;
+    }
+
+    /**
+     * @brief Remove a row by moving the last row into its place
+     */
+    void remove(Index row) {
+        Index last = static_cast<Index>(ids_.size() - 1);
+        index_.erase(ids_[row]);
+        if (row != last) {
+            x_[row] = x_[last];
+            y_[row] = y_[last];
+            z_[row] = z_[last];
+            vx_[row] = vx_[last];
+            vy_[row] = vy_[last];
+            vz_[row] = vz_[last];
+            confidence_[row] = confidence_[last];
+            last_update_[row] = last_update_[last];
+            ids_[row] = std::move(ids_[last]);
+            index_[ids_[row]] = row;
+        }
+        for (auto* column : {&x_, &y_, &z_, &vx_, &vy_, &vz_, &confidence_}) {
+            column->pop_back();
+        }
+        last_update_.pop_back();
+        ids_.pop_back();
+    }
+
+    void clear() {
+        for (auto* column : {&x_, &y_, &z_, &vx_, &vy_, &vz_, &confidence_}) {
+            column->clear();
+        }
+        last_update_.clear();
+        ids_.clear();
+        index_.clear();
+    }
+
+    size_t size() const { return ids_.size(); }
+    bool empty() const { return ids_.empty(); }
+
+    Index index_of(const std::string& target_id) const {
+        auto it = index_.find(target_id);
+        return (it != index_.end()) ? it->second : npos;
+    }
+
+    const std::string& id_of(Index row) const { return ids_[row]; }
+
+    // Column access
+    const float* x() const { return x_.data(); }
+    const float* y() const { return y_.data(); }
+    const float* z() const { return z_.data(); }
+    const float* vx() const { return vx_.data(); }
+    const float* vy() const { return vy_.data(); }
+    const float* vz() const { return vz_.data(); }
+    const float* confidence() const { return confidence_.data(); }
+    const Clock::rep* last_update() const { return last_update_.data(); }
+
+    /**
+     * @brief Materialize a row as a Target (e.g. for TargetPrioritizer)
+     *
+     * Sensor detection counts are not stored in the table.
+     */
+    Target to_target(Index row) const {
+        Target target(ids_[row]);
+        target.x = x_[row];
+        target.y = y_[row];
+        target.z = z_[row];
+        target.vx = vx_[row];
+        target.vy = vy_[row];
+        target.vz = vz_[row];
+        target.confidence = confidence_[row];
+        target.last_update = Clock::time_point(Clock::duration(last_update_[row]));
+        return target;
+    }
+
+    /**
+     * @brief Overwrite a row's kinematic state from a Target
+     */
+    void store(Index row, const Target& target) {
+        x_[row] = target.x;
+        y_[row] = target.y;
+        z_[row] = target.z;
+        vx_[row] = target.vx;
+        vy_[row] = target.vy;
+        vz_[row] = target.vz;
+        confidence_[row] = target.confidence;
+        last_update_[row] = target.last_update.time_since_epoch().count();
+    }
+
+    /**
+     * @brief Copy kinematic state back into matching tracks of a store
+     *
+     * Tracks missing from the store are skipped; sensor detection counts in
+     * the store are left untouched. Moved tracks are re-indexed.
+     */
+    void write_back(TrackStore& store) const {
+        for (Index row = 0; row < ids_.size(); ++row) {
+            if (Target* target = store.find(ids_[row])) {
+                load(row, *target);
+                store.relocate(*target);
+            }
+        }
+    }
+
+    /**
+     * @brief Copy kinematic state back into matching tracks of a sharded store
+     *
+     * Locks every shard for the duration; tracks that moved out of their
+     * shard's region are handed over to the new one.
+     */
+    void write_back(ShardedTrackStore& store) const {
+        auto region = store.lock(store.all_shards());
+        for (Index row = 0; row < ids_.size(); ++row) {
+            if (Target* target = store.find(ids_[row])) {
+                load(row, *target);
+                region.relocate(*target);
+            }
+        }
+    }
+
+    // ========================================================================
+    // Kernels
+    // ========================================================================
+
+    /**
+     * @brief Constant-velocity prediction of every track by dt seconds
+     */
+    void predict(float dt) {
+        const size_t n = size();
+        float* px = x_.data();
+        float* py = y_.data();
+        float* pz = z_.data();
+        const float* pvx = vx_.data();
+        const float* pvy = vy_.data();
+        const float* pvz = vz_.data();
+        for (size_t i = 0; i < n; ++i) {
+            px[i] += pvx[i] * dt;
+            py[i] += pvy[i] * dt;
+            pz[i] += pvz[i] * dt;
+        }
+    }
+
+    /**
+     * @brief Multiply confidence by factor for tracks not updated within timeout
+     */
+    void decay_confidence(Clock::time_point now, Clock::duration timeout, float factor) {
+        const size_t n = size();
+        const Clock::rep cutoff = (now - timeout).time_since_epoch().count();
+        float* conf = confidence_.data();
+        const Clock::rep* last = last_update_.data();
+        for (size_t i = 0; i < n; ++i) {
+            conf[i] = (last[i] < cutoff) ? conf[i] * factor : conf[i];
+        }
+    }
+
+    /**
+     * @brief Collect every row strictly inside radius of a position
+     * @param out Receives row indices (cleared first), in row order
+     * @return Number of rows inside the gate
+     */
+    size_t gate(float px, float py, float pz, float radius, std::vector<Index>& out) const {
+        const size_t n = compute_distance_sq(px, py, pz);
+        const float radius_sq = radius * radius;
+        const float* d2 = distance_sq_.data();
+
+        out.clear();
+        for (size_t i = 0; i < n; ++i) {
+            if (d2[i] < radius_sq) {
+                out.push_back(static_cast<Index>(i));
+            }
+        }
+        return out.size();
+    }
+
+    /**
+     * @brief Closest row strictly inside radius of a position
+     * @return Row index, or npos if no row is inside the gate
+     */
+    Index nearest(float px, float py, float pz, float radius) const {
+        const size_t n = compute_distance_sq(px, py, pz);
+        const float* d2 = distance_sq_.data();
+
+        Index best = npos;
+        float best_sq = radius * radius;
+        for (size_t i = 0; i < n; ++i) {
+            if (d2[i] < best_sq) {
+                best_sq = d2[i];
+                best = static_cast<Index>(i);
+            }
+        }
+        return best;
+    }
+
+private:
+    void load(Index row, Target& target) const {
+        target.x = x_[row];
+        target.y = y_[row];
+        target.z = z_[row];
+        target.vx = vx_[row];
+        target.vy = vy_[row];
+        target.vz = vz_[row];
+        target.confidence = confidence_[row];
+        target.last_update = Clock::time_point(Clock::duration(last_update_[row]));
+    }
+
+    size_t compute_distance_sq(float px, float py, float pz) const {
+        const size_t n = size();
+        distance_sq_.resize(n);
+        float* d2 = distance_sq_.data();
+        const float* cx = x_.data();
+        const float* cy = y_.data();
+        const float* cz = z_.data();
+        for (size_t i = 0; i < n; ++i) {
+            float dx = cx[i] - px;
+            float dy = cy[i] - py;
+            float dz = cz[i] - pz;
+            d2[i] = dx * dx + dy * dy + dz * dz;
+        }
+        return n;
+    }
+};
+
+} // namespace dp_aero_l2::algorithms
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "mpmc_queue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dp_aero_l2::core {
+
+/**
+ * @brief One traffic class of a WeightedFairQueue
+ */
+struct QueueClassOptions {
+    std::string name;
+    size_t capacity = 0;
+    OverflowPolicy policy = OverflowPolicy::DropOldest;
+    uint32_t weight = 1;
+};
+
+/**
+ * @brief Depth and counters of one WeightedFairQueue class
+ */
+struct QueueClassStats {
+    std::string name;
+    size_t depth;
+    size_t capacity;
+    uint64_t dequeued;
+    uint64_t dropped;
+};
+
+/**
+ * @brief Bounded queue split into traffic classes, dequeued by weight
+ *
+ * Each class is its own MpmcQueue with its own capacity and overflow policy,
+ * so a burst in one class only ever drops or blocks items of that class.
+ * Consumers take items class by class along a smooth weighted round-robin
+ * schedule: while every class is backlogged, a class with weight 4 gets four
+ * items for each one of a class with weight 1, interleaved rather than in
+ * runs. Empty classes are skipped, so no capacity is left idle.
+ *
+ * Pushes and pops are lock-free like MpmcQueue; pop_batch_wait() sleeps
+ * while every class is empty.
+ */
+template<typename T>
+class WeightedFairQueue {
+private:
+    struct Lane {
+        std::string name;
+        uint32_t weight;
+        MpmcQueue<T> queue;
+        std::atomic<uint64_t> dequeued{0};
+
+        explicit Lane(const QueueClassOptions& options)
+            : name(options.name), weight(options.weight), queue(options.capacity, options.policy) {}
+    };
+
+    static constexpr int64_t kMaxTotalWeight = 1 << 16;  // One schedule turn per unit of weight
+
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::vector<uint16_t> schedule_;  // Lane of each turn, one round long
+
+    alignas(64) std::atomic<size_t> cursor_{0};
+    alignas(64) std::atomic<uint32_t> push_signal_{0};
+    std::atomic<bool> consumers_sleeping_{false};
+    std::atomic<bool> closed_{false};
+
+public:
+    explicit WeightedFairQueue(const std::vector<QueueClassOptions>& classes) {
+        if (classes.empty() || classes.size() > UINT16_MAX) {
+            throw std::invalid_argument("WeightedFairQueue needs between 1 and 65535 classes");
+        }
+        for (const auto& options : classes) {
+            if (options.weight == 0) {
+                throw std::invalid_argument("WeightedFairQueue class " + options.name + " has weight 0");
+            }
+            lanes_.push_back(std::make_unique<Lane>(options));
+        }
+        build_schedule();
+    }
+
+    WeightedFairQueue(const WeightedFairQueue&) = delete;
+    WeightedFairQueue& operator=(const WeightedFairQueue&) = delete;
+
+    /**
+     * @brief Enqueue an item in a class according to that class's overflow policy
+     */
+    PushResult push(size_t class_index, T value) {
+        if (closed_.load(std::memory_order_acquire)) {
+            return PushResult::Closed;
+        }
+        auto result = lanes_.at(class_index)->queue.push(std::move(value));
+        if (result == PushResult::Enqueued || result == PushResult::EnqueuedDroppedOldest) {
+            signal_consumers();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Dequeue up to max_items in weighted order without blocking
+     * @return Number of items appended to out
+     */
+    size_t try_pop_batch(std::vector<T>& out, size_t max_items) {
+        const size_t turns = schedule_.size();
+        size_t pos = cursor_.fetch_add(1, std::memory_order_relaxed);
+        size_t count = 0;
+        size_t idle = 0;  // Consecutive turns that found their class empty
+        T item;
+        while (count < max_items && idle < turns) {
+            Lane& lane = *lanes_[schedule_[pos % turns]];
+            if (lane.queue.try_pop(item)) {
+                out.push_back(std::move(item));
+                lane.dequeued.fetch_add(1, std::memory_order_relaxed);
+                ++count;
+                idle = 0;
+            } else {
+                ++idle;
+            }
+            ++pos;
+        }
+        // The next batch continues the round where this one stopped
+        cursor_.store(pos, std::memory_order_relaxed);
+        return count;
+    }
+
+    /**
+     * @brief Dequeue up to max_items, sleeping while every class is empty
+     * @return Number of items appended to out; 0 only once the queue is closed
+     */
+    size_t pop_batch_wait(std::vector<T>& out, size_t max_items) {
+        for (;;) {
+            size_t count = try_pop_batch(out, max_items);
+            if (count > 0 || closed_.load()) {
+                return count;
+            }
+
+            consumers_sleeping_.store(true);
+            uint32_t observed = push_signal_.load();
+            count = try_pop_batch(out, max_items);
+            if (count > 0 || closed_.load()) {
+                return count;
+            }
+            push_signal_.wait(observed);
+        }
+    }
+
+    /**
+     * @brief Reject further pushes and wake all waiting producers and consumers
+     *
+     * Items already queued can still be popped.
+     */
+    void close() {
+        closed_.store(true);
+        for (auto& lane : lanes_) {
+            lane->queue.close();
+        }
+        push_signal_.fetch_add(1);
+        push_signal_.notify_all();
+    }
+
+    /**
+     * @brief Accept pushes again after close()
+     */
+    void reopen() {
+        for (auto& lane : lanes_) {
+            lane->queue.reopen();
+        }
+        closed_.store(false);
+    }
+
+    bool is_closed() const { return closed_.load(); }
+    size_t class_count() const { return lanes_.size(); }
+    const std::string& class_name(size_t class_index) const { return lanes_.at(class_index)->name; }
+
+    size_t capacity() const {
+        size_t total = 0;
+        for (const auto& lane : lanes_) {
+            total += lane->queue.capacity();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Approximate number of items queued in all classes
+     */
+    size_t size_approx() const {
+        size_t total = 0;
+        for (const auto& lane : lanes_) {
+            total += lane->queue.size_approx();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Items dropped by the classes' overflow policies so far
+     */
+    uint64_t dropped_count() const {
+        uint64_t total = 0;
+        for (const auto& lane : lanes_) {
+            total += lane->queue.dropped_count();
+        }
+        return total;
+    }
+
+    std::vector<QueueClassStats> class_stats() const {
+        std::vector<QueueClassStats> stats;
+        stats.reserve(lanes_.size());
+        for (const auto& lane : lanes_) {
+            stats.push_back(QueueClassStats{
+                .name = lane->name,
+                .depth = lane->queue.size_approx(),
+                .capacity = lane->queue.capacity(),
+                .dequeued = lane->dequeued.load(std::memory_order_relaxed),
+                .dropped = lane->queue.dropped_count()});
+        }
+        return stats;
+    }
+
+private:
+    // Smooth weighted round robin: each turn every class gains its weight in
+    // credit and the richest class takes the turn and pays the total weight
+    void build_schedule() {
+        int64_t total = 0;
+        for (const auto& lane : lanes_) {
+            total += lane->weight;
+        }
+        if (total > kMaxTotalWeight) {
+            throw std::invalid_argument("WeightedFairQueue weights must add up to at most " +
+                                        std::to_string(kMaxTotalWeight));
+        }
+        std::vector<int64_t> credit(lanes_.size(), 0);
+        schedule_.reserve(static_cast<size_t>(total));
+        for (int64_t turn = 0; turn < total; ++turn) {
+            size_t richest = 0;
+            for (size_t i = 0; i < lanes_.size(); ++i) {
+                credit[i] += lanes_[i]->weight;
+                if (credit[i] > credit[richest]) {
+                    richest = i;
+                }
+            }
+            credit[richest] -= total;
+            schedule_.push_back(static_cast<uint16_t>(richest));
+        }
+    }
+
+    void signal_consumers() {
+        push_signal_.fetch_add(1);
+        if (consumers_sleeping_.load() && consumers_sleeping_.exchange(false)) {
+            push_signal_.notify_all();
+        }
+    }
+};
+
+} // namespace dp_aero_l2::core
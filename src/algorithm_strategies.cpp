@@ -4,10 +4,31 @@
 #include "algorithms/target_tracking_algorithm.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <numeric>
 
 namespace dp_aero_l2::algorithms {
 
+// ============================================================================
+// TargetPrioritizer Implementation
+// ============================================================================
+
+TrackTable::Index TargetPrioritizer::select_highest_priority_row(const TrackTable& table,
+                                                                 const fusion::AlgorithmContext& context) const {
+    TrackTable::Index best = TrackTable::npos;
+    float best_priority = 0.0f;
+    for (TrackTable::Index row = 0; row < table.size(); ++row) {
+        float priority = calculate_priority(table.to_target(row), context);
+        if (best == TrackTable::npos || priority > best_priority) {
+            best = row;
+            best_priority = priority;
+        }
+    }
+    return best;
+}
+
 // ============================================================================
 // ConfidenceBasedPrioritizer Implementation
 // ============================================================================
@@ -37,6 +58,14 @@ Target* ConfidenceBasedPrioritizer::select_highest_priority_target(const std::ve
         });
 }
 
+TrackTable::Index ConfidenceBasedPrioritizer::select_highest_priority_row(const TrackTable& table,
+                                                                          const fusion::AlgorithmContext& /*context*/) const {
+    if (table.empty()) return TrackTable::npos;
+    
+    const float* confidence = table.confidence();
+    return static_cast<TrackTable::Index>(std::max_element(confidence, confidence + table.size()) - confidence);
+}
+
 // ============================================================================
 // SingleDeviceAssignmentStrategy Implementation  
 // ============================================================================
@@ -141,33 +170,44 @@ float CapabilityBasedAssignmentStrategy::evaluate_device_suitability(const std::
 // ThreatBasedPrioritizer Implementation
 // ============================================================================
 
-float ThreatBasedPrioritizer::calculate_priority(const Target& target, const fusion::AlgorithmContext& context) const {
+namespace {
+
+// Shared by the per-target and per-row paths so both score a track identically
+float threat_priority(const ThreatBasedPrioritizer::ThreatParameters& params,
+                      float x, float y, float z, float vx, float vy, float vz, float confidence) {
     float priority = 0.0f;
     
     // Range component (closer = higher threat)
-    float range = std::sqrt(target.x * target.x + target.y * target.y + target.z * target.z);
+    float range = std::sqrt(x * x + y * y + z * z);
     float range_score = (range > 0) ? std::exp(-range / 100.0f) : 1.0f; // Exponential decay with distance
-    priority += params_.range_weight * range_score;
+    priority += params.range_weight * range_score;
     
     // Velocity component (faster = higher threat)
-    float speed = std::sqrt(target.vx * target.vx + target.vy * target.vy + target.vz * target.vz);
+    float speed = std::sqrt(vx * vx + vy * vy + vz * vz);
     float velocity_score = std::min(1.0f, speed / 50.0f); // Normalize to max speed of 50 m/s
-    priority += params_.velocity_weight * velocity_score;
+    priority += params.velocity_weight * velocity_score;
     
     // Confidence component (more confident detections prioritized)
-    priority += params_.confidence_weight * target.confidence;
+    priority += params.confidence_weight * confidence;
     
     // Heading component (targets moving toward us = higher threat)
     if (range > 0) {
         // Calculate if target is approaching (dot product of velocity and position vectors)
-        float approach_factor = -(target.vx * target.x + target.vy * target.y + target.vz * target.z) / (range * speed);
+        float approach_factor = -(vx * x + vy * y + vz * z) / (range * speed);
         float heading_score = std::max(0.0f, approach_factor); // Only positive (approaching)
-        priority += params_.heading_weight * heading_score;
+        priority += params.heading_weight * heading_score;
     }
     
     return std::clamp(priority, 0.0f, 1.0f);
 }
 
+} // namespace
+
+float ThreatBasedPrioritizer::calculate_priority(const Target& target, const fusion::AlgorithmContext& context) const {
+    return threat_priority(params_, target.x, target.y, target.z,
+                           target.vx, target.vy, target.vz, target.confidence);
+}
+
 std::vector<Target*> ThreatBasedPrioritizer::prioritize_targets(std::vector<Target*>& targets, 
                                                                const fusion::AlgorithmContext& context) const {
     // Sort by threat priority (highest first)
@@ -193,4 +233,285 @@ Target* ThreatBasedPrioritizer::select_highest_priority_target(const std::vector
     return best_target;
 }
 
+TrackTable::Index ThreatBasedPrioritizer::select_highest_priority_row(const TrackTable& table,
+                                                                      const fusion::AlgorithmContext& /*context*/) const {
+    if (table.empty()) return TrackTable::npos;
+    
+    const float* x = table.x();
+    const float* y = table.y();
+    const float* z = table.z();
+    const float* vx = table.vx();
+    const float* vy = table.vy();
+    const float* vz = table.vz();
+    const float* confidence = table.confidence();
+    
+    TrackTable::Index best = 0;
+    float best_priority = threat_priority(params_, x[0], y[0], z[0], vx[0], vy[0], vz[0], confidence[0]);
+    for (TrackTable::Index row = 1; row < table.size(); ++row) {
+        float priority = threat_priority(params_, x[row], y[row], z[row],
+                                         vx[row], vy[row], vz[row], confidence[row]);
+        if (priority > best_priority) {
+            best = row;
+            best_priority = priority;
+        }
+    }
+    
+    std::cout << "[ThreatBasedPrioritizer] Selected target with threat priority: " 
+              << best_priority << std::endl;
+    
+    return best;
+}
+
+// ============================================================================
+// NearestNeighbourAssociation Implementation
+// ============================================================================
+
+std::vector<Target*> NearestNeighbourAssociation::associate(const GatedCandidates& candidates,
+                                                            float miss_cost) const {
+    std::vector<Target*> assignment(candidates.size(), nullptr);
+    
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        float best_cost = miss_cost;
+        for (const auto& [track, cost] : candidates[i]) {
+            if (cost < best_cost) {
+                best_cost = cost;
+                assignment[i] = track;
+            }
+        }
+    }
+    
+    return assignment;
+}
+
+// ============================================================================
+// GlobalNearestNeighbourAssociation Implementation
+// ============================================================================
+
+namespace {
+
+using SparseRow = std::vector<std::pair<uint32_t, double>>;
+
+struct DisjointSet {
+    std::vector<uint32_t> parent;
+    
+    explicit DisjointSet(size_t size) : parent(size) {
+        std::iota(parent.begin(), parent.end(), 0u);
+    }
+    
+    uint32_t find(uint32_t node) {
+        while (parent[node] != node) {
+            parent[node] = parent[parent[node]];
+            node = parent[node];
+        }
+        return node;
+    }
+    
+    void unite(uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a != b) {
+            parent[b] = a;
+        }
+    }
+};
+
+/**
+ * Minimum-cost assignment of every row to a distinct column by successive
+ * shortest augmenting paths with dual potentials. Missing entries are
+ * infeasible; every row must own a column no other row can use (its miss
+ * column) so a complete assignment always exists.
+ *
+ * Only columns reached by the current search are scanned, which keeps each
+ * augmentation proportional to the explored part of the component.
+ *
+ * @return Column assigned to each row
+ */
+std::vector<uint32_t> solve_assignment(const std::vector<SparseRow>& rows, uint32_t num_cols) {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    
+    // 1-based columns; column 0 is the virtual source of each search
+    const uint32_t m = num_cols;
+    std::vector<double> row_potential(rows.size() + 1, 0.0);
+    std::vector<double> col_potential(m + 1, 0.0);
+    std::vector<double> min_slack(m + 1, inf);
+    std::vector<uint32_t> row_of_col(m + 1, 0);   // 1-based row, 0 = free
+    std::vector<uint32_t> previous(m + 1, 0);
+    std::vector<char> visited(m + 1, 0);
+    std::vector<uint32_t> visited_cols;
+    std::vector<uint32_t> frontier;
+    
+    for (uint32_t row = 1; row <= rows.size(); ++row) {
+        row_of_col[0] = row;
+        uint32_t col = 0;
+        visited_cols.assign(1, 0);
+        frontier.clear();
+        visited[0] = 1;
+        
+        do {
+            const uint32_t current_row = row_of_col[col];
+            
+            for (const auto& [edge_col, cost] : rows[current_row - 1]) {
+                const uint32_t j = edge_col + 1;
+                if (visited[j]) continue;
+                double slack = cost - row_potential[current_row] - col_potential[j];
+                if (slack < min_slack[j]) {
+                    if (min_slack[j] == inf) {
+                        frontier.push_back(j);
+                    }
+                    min_slack[j] = slack;
+                    previous[j] = col;
+                }
+            }
+            
+            size_t best = 0;
+            for (size_t k = 1; k < frontier.size(); ++k) {
+                if (min_slack[frontier[k]] < min_slack[frontier[best]]) {
+                    best = k;
+                }
+            }
+            const uint32_t next_col = frontier[best];
+            const double delta = min_slack[next_col];
+            frontier[best] = frontier.back();
+            frontier.pop_back();
+            
+            for (uint32_t j : visited_cols) {
+                row_potential[row_of_col[j]] += delta;
+                col_potential[j] -= delta;
+            }
+            for (uint32_t j : frontier) {
+                min_slack[j] -= delta;
+            }
+            min_slack[next_col] = 0.0;
+            
+            visited[next_col] = 1;
+            visited_cols.push_back(next_col);
+            col = next_col;
+        } while (row_of_col[col] != 0);
+        
+        // Augment along the alternating path back to the source
+        do {
+            uint32_t prev_col = previous[col];
+            row_of_col[col] = row_of_col[prev_col];
+            col = prev_col;
+        } while (col != 0);
+        
+        for (uint32_t j : visited_cols) {
+            visited[j] = 0;
+            min_slack[j] = inf;
+        }
+        for (uint32_t j : frontier) {
+            min_slack[j] = inf;
+        }
+    }
+    
+    std::vector<uint32_t> col_of_row(rows.size(), 0);
+    for (uint32_t j = 1; j <= m; ++j) {
+        if (row_of_col[j] != 0) {
+            col_of_row[row_of_col[j] - 1] = j - 1;
+        }
+    }
+    return col_of_row;
+}
+
+} // namespace
+
+std::vector<Target*> GlobalNearestNeighbourAssociation::associate(const GatedCandidates& candidates,
+                                                                  float miss_cost) const {
+    const size_t num_measurements = candidates.size();
+    std::vector<Target*> assignment(num_measurements, nullptr);
+    
+    // Dense ids for every gated track
+    std::unordered_map<Target*, uint32_t> track_ids;
+    std::vector<Target*> tracks;
+    for (const auto& gated : candidates) {
+        for (const auto& [track, cost] : gated) {
+            if (cost < miss_cost && track_ids.emplace(track, static_cast<uint32_t>(tracks.size())).second) {
+                tracks.push_back(track);
+            }
+        }
+    }
+    
+    // Connected components of the gating graph (measurements, then tracks)
+    DisjointSet components(num_measurements + tracks.size());
+    for (size_t i = 0; i < num_measurements; ++i) {
+        for (const auto& [track, cost] : candidates[i]) {
+            if (cost < miss_cost) {
+                components.unite(static_cast<uint32_t>(i),
+                                 static_cast<uint32_t>(num_measurements + track_ids[track]));
+            }
+        }
+    }
+    
+    std::vector<std::pair<uint32_t, uint32_t>> by_component;  // (root, measurement)
+    by_component.reserve(num_measurements);
+    for (size_t i = 0; i < num_measurements; ++i) {
+        by_component.emplace_back(components.find(static_cast<uint32_t>(i)), static_cast<uint32_t>(i));
+    }
+    std::sort(by_component.begin(), by_component.end());
+    
+    std::vector<uint32_t> local_col(tracks.size(), UINT32_MAX);
+    std::vector<uint32_t> component_tracks;
+    std::vector<SparseRow> rows;
+    
+    for (size_t begin = 0; begin < by_component.size();) {
+        size_t end = begin + 1;
+        while (end < by_component.size() && by_component[end].first == by_component[begin].first) {
+            ++end;
+        }
+        
+        if (end - begin == 1) {
+            // A lone measurement simply takes its closest track
+            uint32_t i = by_component[begin].second;
+            float best_cost = miss_cost;
+            for (const auto& [track, cost] : candidates[i]) {
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    assignment[i] = track;
+                }
+            }
+            begin = end;
+            continue;
+        }
+        
+        // Columns: the component's tracks, then one miss column per measurement
+        component_tracks.clear();
+        for (size_t k = begin; k < end; ++k) {
+            for (const auto& [track, cost] : candidates[by_component[k].second]) {
+                uint32_t id = track_ids[track];
+                if (cost < miss_cost && local_col[id] == UINT32_MAX) {
+                    local_col[id] = static_cast<uint32_t>(component_tracks.size());
+                    component_tracks.push_back(id);
+                }
+            }
+        }
+        
+        const uint32_t num_tracks = static_cast<uint32_t>(component_tracks.size());
+        rows.assign(end - begin, {});
+        for (size_t k = begin; k < end; ++k) {
+            auto& row = rows[k - begin];
+            for (const auto& [track, cost] : candidates[by_component[k].second]) {
+                if (cost < miss_cost) {
+                    row.emplace_back(local_col[track_ids[track]], cost);
+                }
+            }
+            row.emplace_back(num_tracks + static_cast<uint32_t>(k - begin), miss_cost);
+        }
+        
+        auto cols = solve_assignment(rows, num_tracks + static_cast<uint32_t>(end - begin));
+        for (size_t k = begin; k < end; ++k) {
+            uint32_t col = cols[k - begin];
+            if (col < num_tracks) {
+                assignment[by_component[k].second] = tracks[component_tracks[col]];
+            }
+        }
+        
+        for (uint32_t id : component_tracks) {
+            local_col[id] = UINT32_MAX;
+        }
+        begin = end;
+    }
+    
+    return assignment;
+}
+
 } // namespace dp_aero_l2::algorithms
\ No newline at end of file
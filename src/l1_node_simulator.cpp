@@ -1,6 +1,8 @@
 #include "redis_utils.h"
 #include "messages/l1_to_l2.pb.h"
 #include "messages/l2_to_l1.pb.h"
+#include "packed_point_cloud.h"
+#include "partition_map.h"
 #include <iostream>
 #include <thread>
 #include <random>
@@ -44,6 +46,12 @@ private:
     // Configuration
     std::chrono::milliseconds publish_interval_{1000};
     float detection_probability_ = 0.3f;  // Probability of generating detections
+    bool packed_lidar_ = false;           // Emit lidar scans as LidarData.packed_points
+    std::string stream_;                  // Append to this stream instead of publishing (empty: Pub/Sub)
+    size_t stream_max_len_ = 100000;      // Approximate MAXLEN trim applied on each append
+    core::PartitionMap partitions_;       // L2 partitions; picks this node's topic or stream
+    std::string topic_ = "l1_to_l2";
+    std::atomic<int32_t> sequence_number_{0};  // Numbers every message sent, from 1
     
 public:
     L1NodeSimulator(const std::string& node_id, const std::string& node_type, 
@@ -56,6 +64,12 @@ public:
     void start() {
         std::cout << "Starting L1 Node Simulator: " << node_id_ << " (" << node_type_ << ")\n";
         
+        // Publish to the topic or stream of the L2 partition owning this node
+        topic_ = partitions_.channel_for_node(topic_, node_id_);
+        if (!stream_.empty()) {
+            stream_ = partitions_.channel_for_node(stream_, node_id_);
+        }
+        
         // Send initial capability advertisement
         send_capability_advertisement();
         
@@ -89,8 +103,30 @@ public:
     void set_detection_probability(float probability) {
         detection_probability_ = std::clamp(probability, 0.0f, 1.0f);
     }
+    
+    void set_packed_lidar(bool packed) {
+        packed_lidar_ = packed;
+    }
+    
+    void set_stream(const std::string& stream, size_t max_len) {
+        stream_ = stream;
+        stream_max_len_ = max_len;
+    }
+    
+    void set_partitions(const core::PartitionMap& partitions) {
+        partitions_ = partitions;
+    }
 
 private:
+    void send_to_l2(messages::L1ToL2Message& msg) {
+        msg.set_sequence_number(++sequence_number_);
+        if (stream_.empty()) {
+            redis_messenger_->publish(topic_, msg);
+        } else {
+            redis_messenger_->add_to_stream(stream_, msg, stream_max_len_);
+        }
+    }
+    
     void publisher_loop() {
         int message_count = 0;
         
@@ -138,7 +174,6 @@ private:
     void send_capability_advertisement() {
         messages::L1ToL2Message msg;
         msg.set_message_id(generate_message_id());
-        msg.set_sequence_number(0);
         
         // Set sender information
         auto* sender = msg.mutable_sender();
@@ -177,7 +212,7 @@ private:
             (*capability->mutable_parameters())["wavelength"] = "1.55e-6";
         }
         
-        redis_messenger_->publish("l1_to_l2", msg);
+        send_to_l2(msg);
         std::cout << "[" << node_id_ << "] Sent capability advertisement\n";
     }
     
@@ -200,7 +235,7 @@ private:
         (*heartbeat->mutable_status_info())["cpu_usage"] = std::to_string(
             std::uniform_real_distribution<float>(10.0f, 50.0f)(rng_));
         
-        redis_messenger_->publish("l1_to_l2", msg);
+        send_to_l2(msg);
         
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
@@ -228,7 +263,7 @@ private:
         status->set_cpu_usage(std::uniform_real_distribution<float>(10.0f, 60.0f)(rng_));
         status->set_memory_usage(std::uniform_real_distribution<float>(20.0f, 80.0f)(rng_));
         
-        redis_messenger_->publish("l1_to_l2", msg);
+        send_to_l2(msg);
     }
     
     void send_sensor_data() {
@@ -261,7 +296,7 @@ private:
             generate_coherent_status_data(sensor_data);
         }
         
-        redis_messenger_->publish("l1_to_l2", msg);
+        send_to_l2(msg);
         
         std::cout << "[" << node_id_ << "] Sent " << node_type_ << " data\n";
     }
@@ -288,6 +323,7 @@ private:
         
         // Generate clustered points to simulate objects
         int num_clusters = std::uniform_int_distribution<int>(1, 3)(rng_);
+        int num_points = 0;
         
         for (int cluster = 0; cluster < num_clusters; ++cluster) {
             // Cluster center
@@ -298,17 +334,27 @@ private:
             int points_in_cluster = std::uniform_int_distribution<int>(20, 100)(rng_);
             
             for (int i = 0; i < points_in_cluster; ++i) {
-                auto* point = lidar_data->add_points();
-                
                 // Add noise around cluster center
-                point->set_x(center_x + std::normal_distribution<float>(0.0f, 1.0f)(rng_));
-                point->set_y(center_y + std::normal_distribution<float>(0.0f, 1.0f)(rng_));
-                point->set_z(center_z + std::normal_distribution<float>(0.0f, 0.5f)(rng_));
-                point->set_intensity(std::uniform_real_distribution<float>(0.1f, 1.0f)(rng_));
+                float x = center_x + std::normal_distribution<float>(0.0f, 1.0f)(rng_);
+                float y = center_y + std::normal_distribution<float>(0.0f, 1.0f)(rng_);
+                float z = center_z + std::normal_distribution<float>(0.0f, 0.5f)(rng_);
+                float intensity = std::uniform_real_distribution<float>(0.1f, 1.0f)(rng_);
+                
+                if (packed_lidar_) {
+                    algorithms::packed_point_cloud::append_point(
+                        *lidar_data->mutable_packed_points(), x, y, z, intensity);
+                } else {
+                    auto* point = lidar_data->add_points();
+                    point->set_x(x);
+                    point->set_y(y);
+                    point->set_z(z);
+                    point->set_intensity(intensity);
+                }
             }
+            num_points += points_in_cluster;
         }
         
-        lidar_data->set_num_points(lidar_data->points_size());
+        lidar_data->set_num_points(num_points);
     }
     
     void generate_image_data(data_streams::ImageData* image_data) {
@@ -502,6 +548,11 @@ void print_usage(const char* program_name) {
     std::cout << "  --redis-url <url>          Redis connection URL (default: tcp://127.0.0.1:6379)\n";
     std::cout << "  --interval <ms>            Publish interval in milliseconds (default: 1000)\n";
     std::cout << "  --detection-prob <prob>    Detection probability 0.0-1.0 (default: 0.3)\n";
+    std::cout << "  --packed-lidar             Send lidar scans as packed float32 points\n";
+    std::cout << "  --stream <name>            Append to a Redis stream instead of publishing\n";
+    std::cout << "  --stream-maxlen <count>    Approximate stream length cap (default: 100000)\n";
+    std::cout << "  --partitions <count>       Number of L2 partitions; publishes to this node's (default: 1)\n";
+    std::cout << "  --partition-nodes <list>   Pin nodes to partitions: node=index,node=index (default: hashed)\n";
     std::cout << "  --help                     Show this help message\n";
 }
 
@@ -513,6 +564,11 @@ int main(int argc, char* argv[]) {
     std::string redis_url = "tcp://127.0.0.1:6379";
     int interval_ms = 1000;
     float detection_prob = 0.3f;
+    bool packed_lidar = false;
+    std::string stream;
+    size_t stream_max_len = 100000;
+    size_t partition_count = 1;
+    std::string partition_nodes;
     
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -533,6 +589,16 @@ int main(int argc, char* argv[]) {
             interval_ms = std::stoi(argv[++i]);
         } else if (arg == "--detection-prob" && i + 1 < argc) {
             detection_prob = std::stof(argv[++i]);
+        } else if (arg == "--packed-lidar") {
+            packed_lidar = true;
+        } else if (arg == "--stream" && i + 1 < argc) {
+            stream = argv[++i];
+        } else if (arg == "--stream-maxlen" && i + 1 < argc) {
+            stream_max_len = std::stoul(argv[++i]);
+        } else if (arg == "--partitions" && i + 1 < argc) {
+            partition_count = std::stoul(argv[++i]);
+        } else if (arg == "--partition-nodes" && i + 1 < argc) {
+            partition_nodes = argv[++i];
         } else {
             std::cerr << "Unknown argument: " << arg << std::endl;
             print_usage(argv[0]);
@@ -559,6 +625,13 @@ int main(int argc, char* argv[]) {
         L1NodeSimulator simulator(node_id, node_type, location, redis_url);
         simulator.set_publish_interval(std::chrono::milliseconds(interval_ms));
         simulator.set_detection_probability(detection_prob);
+        simulator.set_packed_lidar(packed_lidar);
+        if (!stream.empty()) {
+            simulator.set_stream(stream, stream_max_len);
+        }
+        core::PartitionMap partitions(partition_count, 0);
+        partitions.assign_nodes(partition_nodes);
+        simulator.set_partitions(partitions);
         
         simulator.start();
         
@@ -568,7 +641,10 @@ int main(int argc, char* argv[]) {
         std::cout << "  Type: " << node_type << "\n";
         std::cout << "  Location: " << location << "\n";
         std::cout << "  Publish Interval: " << interval_ms << " ms\n";
-        std::cout << "  Detection Probability: " << detection_prob << "\n\n";
+        std::cout << "  Detection Probability: " << detection_prob << "\n";
+        std::cout << "  Packed Lidar: " << (packed_lidar ? "yes" : "no") << "\n";
+        std::cout << "  Transport: " << (stream.empty() ? "pub/sub" : "stream " + stream) << "\n";
+        std::cout << "  L2 Partition: " << partitions.partition_of_node(node_id) << " of " << partition_count << "\n\n";
         
         // Keep running until signal
         while (running) {
@@ -4,7 +4,12 @@
 #include <signal.h>
 #include <thread>
 #include <iomanip>
+#include <algorithm>
 #include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 using namespace dp_aero_l2;
 
@@ -26,16 +31,90 @@ void print_usage(const char* program_name) {
     std::cout << "Usage: " << program_name << " [options]\n";
     std::cout << "Options:\n";
     std::cout << "  --redis-url <url>          Redis connection URL (default: tcp://127.0.0.1:6379)\n";
+    std::cout << "  --redis-pool <count>       Redis connection pool size (default: 4)\n";
     std::cout << "  --algorithm <name>         Algorithm to use (default: TargetTrackingAlgorithm)\n";
     std::cout << "  --update-interval <ms>     Algorithm update interval in milliseconds (default: 100)\n";
     std::cout << "  --node-timeout <seconds>   Node timeout in seconds (default: 30)\n";
+    std::cout << "  --max-nodes <count>        Distinct L1 node ids admitted (default: 4096)\n";
+    std::cout << "  --history-depth <count>    Messages kept per node (default: 100)\n";
+    std::cout << "  --history-retention <ms>   Drop history older than this, milliseconds (default: 0, never)\n";
+    std::cout << "  --history-summaries        Keep only message summaries in the history, not the messages\n";
     std::cout << "  --workers <count>          Number of worker threads (default: 2)\n";
+    std::cout << "  --queue-size <count>       Ingest queue capacity (default: 1000)\n";
+    std::cout << "  --queue-policy <policy>    Full queue policy: drop-oldest, drop-newest, block (default: drop-oldest)\n";
+    std::cout << "  --class-weights <list>     Ingest class dequeue weights: class=weight,... (default: control=4,radar=8,\n"
+              << "                             navigation=4,lidar=2,bulk=1)\n";
+    std::cout << "  --fifo-ingest              One FIFO ingest queue instead of per-class queues\n";
+    std::cout << "  --unordered                Let any worker take any node's messages (no per-node ordering)\n";
+    std::cout << "  --drop-duplicates          Drop messages whose sequence number was already seen (senders must not restart)\n";
+    std::cout << "  --ingest <mode>            L1 ingest: pubsub or stream (default: pubsub)\n";
+    std::cout << "  --defer-parsing            Pub/sub: parse on the workers, not the subscription thread\n";
+    std::cout << "  --shed <types|none>        Sensor data shed unparsed under load: image,lidar,radar,imu,gps,raw (default: image,raw)\n";
+    std::cout << "  --shed-at <fraction>       Ingest queue fill from which data is shed (default: 0.75)\n";
+    std::cout << "  --stream <name>            Ingest stream (default: l1_to_l2_stream)\n";
+    std::cout << "  --stream-group <name>      Consumer group shared by L2 processes (default: l2_fusion)\n";
+    std::cout << "  --stream-consumer <name>   Consumer name, unique per process (default: l2_<hostname>)\n";
+    std::cout << "  --partitions <count>       Number of L2 processes splitting the nodes (default: 1)\n";
+    std::cout << "  --partition <index>        Partition owned by this process, 0-based (default: 0)\n";
+    std::cout << "  --partition-scheme <s>     Track ownership: node or sector (default: node)\n";
+    std::cout << "  --partition-nodes <list>   Pin nodes to partitions: node=index,node=index (default: hashed)\n";
+    std::cout << "  --sector-size <m>          Airspace sector side for the sector scheme (default: 2000)\n";
+    std::cout << "  --boundary-margin <m>      Distance from a foreign sector at which tracks are shared (default: 100)\n";
+    std::cout << "  --exchange-interval <ms>   Boundary track exchange interval (default: 500)\n";
+    std::cout << "  --publish-batch <count>    Max messages per publish pipeline (default: 64)\n";
+    std::cout << "  --publish-delay <us>       Max wait for a publish batch to fill, microseconds (default: 500)\n";
     std::cout << "  --debug                    Enable debug logging\n";
     std::cout << "  --help                     Show this help message\n";
 }
 
+std::vector<data_streams::SensorData::DataTypeCase> parse_sensor_types(const std::string& list) {
+    static const std::unordered_map<std::string, data_streams::SensorData::DataTypeCase> names = {
+        {"image", data_streams::SensorData::kImage}, {"lidar", data_streams::SensorData::kLidar},
+        {"radar", data_streams::SensorData::kRadar}, {"imu", data_streams::SensorData::kImu},
+        {"gps", data_streams::SensorData::kGps},     {"raw", data_streams::SensorData::kRawData}};
+    
+    std::vector<data_streams::SensorData::DataTypeCase> types;
+    if (list == "none") {
+        return types;
+    }
+    std::stringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        auto it = names.find(name);
+        if (it == names.end()) {
+            throw std::invalid_argument("Unknown sensor type: " + name);
+        }
+        types.push_back(it->second);
+    }
+    return types;
+}
+
+void set_class_weights(std::vector<core::IngestClassConfig>& classes, const std::string& list) {
+    std::stringstream stream(list);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+        const auto separator = entry.find('=');
+        if (separator == std::string::npos) {
+            throw std::invalid_argument("Expected class=weight, got: " + entry);
+        }
+        const std::string name = entry.substr(0, separator);
+        auto it = std::find_if(classes.begin(), classes.end(),
+                               [&name](const core::IngestClassConfig& c) { return c.name == name; });
+        if (it == classes.end()) {
+            throw std::invalid_argument("Unknown ingest class: " + name);
+        }
+        it->weight = static_cast<uint32_t>(std::stoul(entry.substr(separator + 1)));
+    }
+}
+
 core::L2Config parse_arguments(int argc, char* argv[]) {
     core::L2Config config;
+    size_t partition_count = 1;
+    size_t partition_index = 0;
+    auto partition_scheme = core::PartitionScheme::Node;
+    std::string partition_nodes;
+    float sector_size = 2000.0f;
+    float boundary_margin = 100.0f;
     
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -45,14 +124,97 @@ core::L2Config parse_arguments(int argc, char* argv[]) {
             exit(0);
         } else if (arg == "--redis-url" && i + 1 < argc) {
             config.redis_connection = argv[++i];
+        } else if (arg == "--redis-pool" && i + 1 < argc) {
+            config.redis_pool_size = std::stoul(argv[++i]);
         } else if (arg == "--algorithm" && i + 1 < argc) {
             config.algorithm_name = argv[++i];
         } else if (arg == "--update-interval" && i + 1 < argc) {
             config.algorithm_update_interval = std::chrono::milliseconds(std::stoi(argv[++i]));
         } else if (arg == "--node-timeout" && i + 1 < argc) {
             config.node_timeout = std::chrono::seconds(std::stoi(argv[++i]));
+        } else if (arg == "--max-nodes" && i + 1 < argc) {
+            config.max_l1_nodes = std::stoul(argv[++i]);
+        } else if (arg == "--history-depth" && i + 1 < argc) {
+            config.history_depth = std::stoul(argv[++i]);
+        } else if (arg == "--history-retention" && i + 1 < argc) {
+            config.history_retention = std::chrono::milliseconds(std::stoi(argv[++i]));
+        } else if (arg == "--history-summaries") {
+            config.history_summaries_only = true;
         } else if (arg == "--workers" && i + 1 < argc) {
             config.worker_threads = std::stoi(argv[++i]);
+        } else if (arg == "--queue-size" && i + 1 < argc) {
+            config.message_queue_size = std::stoul(argv[++i]);
+        } else if (arg == "--queue-policy" && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if (policy == "drop-oldest") {
+                config.message_queue_overflow = core::OverflowPolicy::DropOldest;
+            } else if (policy == "drop-newest") {
+                config.message_queue_overflow = core::OverflowPolicy::DropNewest;
+            } else if (policy == "block") {
+                config.message_queue_overflow = core::OverflowPolicy::Block;
+            } else {
+                std::cerr << "Unknown queue policy: " << policy << std::endl;
+                print_usage(argv[0]);
+                exit(1);
+            }
+        } else if (arg == "--class-weights" && i + 1 < argc) {
+            set_class_weights(config.ingest_classes, argv[++i]);
+        } else if (arg == "--fifo-ingest") {
+            config.ingest_classes.clear();
+        } else if (arg == "--unordered") {
+            config.ordered_per_node = false;
+        } else if (arg == "--drop-duplicates") {
+            config.drop_duplicates = true;
+        } else if (arg == "--ingest" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "pubsub") {
+                config.ingest_mode = core::IngestMode::PubSub;
+            } else if (mode == "stream") {
+                config.ingest_mode = core::IngestMode::Stream;
+            } else {
+                std::cerr << "Unknown ingest mode: " << mode << std::endl;
+                print_usage(argv[0]);
+                exit(1);
+            }
+        } else if (arg == "--defer-parsing") {
+            config.defer_parsing = true;
+        } else if (arg == "--shed" && i + 1 < argc) {
+            config.shed_sensor_types = parse_sensor_types(argv[++i]);
+        } else if (arg == "--shed-at" && i + 1 < argc) {
+            config.shed_queue_fraction = std::stof(argv[++i]);
+        } else if (arg == "--stream" && i + 1 < argc) {
+            config.l1_to_l2_stream = argv[++i];
+        } else if (arg == "--stream-group" && i + 1 < argc) {
+            config.stream_group = argv[++i];
+        } else if (arg == "--stream-consumer" && i + 1 < argc) {
+            config.stream_consumer = argv[++i];
+        } else if (arg == "--partitions" && i + 1 < argc) {
+            partition_count = std::stoul(argv[++i]);
+        } else if (arg == "--partition" && i + 1 < argc) {
+            partition_index = std::stoul(argv[++i]);
+        } else if (arg == "--partition-scheme" && i + 1 < argc) {
+            std::string scheme = argv[++i];
+            if (scheme == "node") {
+                partition_scheme = core::PartitionScheme::Node;
+            } else if (scheme == "sector") {
+                partition_scheme = core::PartitionScheme::Sector;
+            } else {
+                std::cerr << "Unknown partition scheme: " << scheme << std::endl;
+                print_usage(argv[0]);
+                exit(1);
+            }
+        } else if (arg == "--partition-nodes" && i + 1 < argc) {
+            partition_nodes = argv[++i];
+        } else if (arg == "--sector-size" && i + 1 < argc) {
+            sector_size = std::stof(argv[++i]);
+        } else if (arg == "--boundary-margin" && i + 1 < argc) {
+            boundary_margin = std::stof(argv[++i]);
+        } else if (arg == "--exchange-interval" && i + 1 < argc) {
+            config.boundary_exchange_interval = std::chrono::milliseconds(std::stoi(argv[++i]));
+        } else if (arg == "--publish-batch" && i + 1 < argc) {
+            config.publish_batch_size = std::stoul(argv[++i]);
+        } else if (arg == "--publish-delay" && i + 1 < argc) {
+            config.publish_max_delay = std::chrono::microseconds(std::stoi(argv[++i]));
         } else if (arg == "--debug") {
             config.enable_debug_logging = true;
         } else {
@@ -62,16 +224,54 @@ core::L2Config parse_arguments(int argc, char* argv[]) {
         }
     }
     
+    config.partitions = core::PartitionMap(partition_count, partition_index, partition_scheme,
+                                           sector_size, boundary_margin);
+    config.partitions.assign_nodes(partition_nodes);
+    
     return config;
 }
 
 void print_system_info(const core::L2Config& config) {
     std::cout << "=== L2 Fusion System Configuration ===\n";
     std::cout << "Redis URL: " << config.redis_connection << "\n";
+    std::cout << "Redis Pool Size: " << config.redis_pool_size << "\n";
     std::cout << "Algorithm: " << config.algorithm_name << "\n";
     std::cout << "Update Interval: " << config.algorithm_update_interval.count() << " ms\n";
     std::cout << "Node Timeout: " << config.node_timeout.count() << " seconds\n";
+    std::cout << "Message History: " << config.history_depth << " per node"
+              << (config.history_summaries_only ? " (summaries)" : "");
+    if (config.history_retention.count() > 0) {
+        std::cout << ", " << config.history_retention.count() << " ms";
+    }
+    std::cout << "\n";
     std::cout << "Worker Threads: " << config.worker_threads << "\n";
+    std::cout << "Queue Size: " << config.message_queue_size << "\n";
+    if (!config.ingest_classes.empty()) {
+        std::cout << "Ingest Classes:";
+        for (const auto& ingest_class : config.ingest_classes) {
+            std::cout << " " << ingest_class.name << " (weight " << ingest_class.weight << ", "
+                      << static_cast<int>(ingest_class.queue_share * 100) << "%)";
+        }
+        std::cout << "\n";
+    }
+    if (config.ingest_mode == core::IngestMode::Stream) {
+        std::cout << "Ingest: stream " << config.partitions.channel(config.l1_to_l2_stream)
+                  << ", group " << config.stream_group << "\n";
+    } else {
+        std::cout << "Ingest: pub/sub " << config.partitions.channel(config.l1_to_l2_topic)
+                  << (config.defer_parsing ? ", parsed by workers" : "") << "\n";
+    }
+    if (!config.shed_sensor_types.empty()) {
+        std::cout << "Load Shedding: " << config.shed_sensor_types.size() << " sensor type(s) from "
+                  << static_cast<int>(config.shed_queue_fraction * 100) << "% queue fill\n";
+    }
+    if (config.partitions.partitioned()) {
+        std::cout << "Partition: " << config.partitions.index() << " of " << config.partitions.count()
+                  << " (" << (config.partitions.scheme() == core::PartitionScheme::Sector ? "sector" : "node")
+                  << " scheme), boundary tracks every " << config.boundary_exchange_interval.count() << " ms\n";
+    }
+    std::cout << "Publish Batching: up to " << config.publish_batch_size << " messages / "
+              << config.publish_max_delay.count() << " us\n";
     std::cout << "Debug Logging: " << (config.enable_debug_logging ? "enabled" : "disabled") << "\n";
     std::cout << "=======================================\n\n";
 }
@@ -88,6 +288,45 @@ void print_stats_periodically(const core::L2FusionManager& manager) {
         std::cout << "Uptime: " << stats.uptime.count() << " seconds\n";
         std::cout << "Messages Processed: " << stats.messages_processed << "\n";
         std::cout << "Messages Sent: " << stats.messages_sent << "\n";
+        std::cout << "Messages Dropped: " << stats.messages_dropped << "\n";
+        for (const auto& ingest_class : stats.ingest_classes) {
+            std::cout << "  Queue " << ingest_class.name << ": " << ingest_class.depth << "/" << ingest_class.capacity
+                      << " queued, " << ingest_class.dequeued << " dequeued, " << ingest_class.dropped << " dropped\n";
+        }
+        std::cout << "Stream Entries Acked: " << stats.messages_acked << "\n";
+        if (stats.bytes_received > 0) {
+            std::cout << "Ingest Bytes: " << stats.bytes_received << " received, " << stats.bytes_parsed
+                      << " parsed (" << std::fixed << std::setprecision(1)
+                      << 100.0 * static_cast<double>(stats.bytes_parsed) / static_cast<double>(stats.bytes_received)
+                      << "%)\n";
+        }
+        const auto& sequence = stats.sequence;
+        if (sequence.gaps + sequence.duplicates + sequence.late + sequence.restarts > 0) {
+            std::cout << "Sequence: " << sequence.gaps << " gaps (" << sequence.missing << " missing), "
+                      << sequence.duplicates << " duplicates, " << sequence.late << " late, "
+                      << sequence.restarts << " restarts\n";
+        }
+        if (stats.nodes_rejected > 0) {
+            std::cout << "Rejected Node Messages: " << stats.nodes_rejected << "\n";
+        }
+        if (stats.messages_shed > 0) {
+            std::cout << "Messages Shed: " << stats.messages_shed << "\n";
+        }
+        std::cout << "Publish Batches: " << stats.publisher.batches
+                  << " (avg " << std::fixed << std::setprecision(1) << stats.publisher.average_batch_size
+                  << " msgs, max " << stats.publisher.max_batch_size << ", "
+                  << stats.publisher.failed_batches << " failed)\n";
+        std::cout << "Publish Flush Latency: avg " << stats.publisher.average_flush_latency.count()
+                  << " us, max " << stats.publisher.max_flush_latency.count() << " us\n";
+        if (stats.boundary_tracks_sent > 0 || stats.peer_tracks_received > 0) {
+            std::cout << "Boundary Tracks: " << stats.boundary_tracks_sent << " sent, "
+                      << stats.peer_tracks_received << " received from peers\n";
+        }
+        for (const auto& task : stats.ticks) {
+            std::cout << "Ticks " << task.name << ": " << task.ticks << " (+" << task.triggered << " triggered, "
+                      << task.missed << " missed), jitter p50 " << task.jitter_p50.count() << " us, p99 "
+                      << task.jitter_p99.count() << " us, max " << task.jitter_max.count() << " us\n";
+        }
         std::cout << "Active Nodes: " << stats.active_nodes << "\n";
         std::cout << "Current State: " << stats.current_algorithm_state << "\n";
         
@@ -99,16 +338,12 @@ void print_stats_periodically(const core::L2FusionManager& manager) {
         std::cout << "========================\n\n";
         
         // Print active nodes
-        auto& registry = manager.get_node_registry();
-        auto active_nodes = registry.get_active_nodes(std::chrono::seconds(30));
+        auto active_nodes = manager.get_node_registry().get_active_node_identities(std::chrono::seconds(30));
         
         if (!active_nodes.empty()) {
             std::cout << "Active L1 Nodes:\n";
-            for (const auto& node_id : active_nodes) {
-                auto node = registry.get_node(node_id);
-                if (node) {
-                    std::cout << "  - " << node_id << " (" << node->node_type() << ")\n";
-                }
+            for (const auto& node : active_nodes) {
+                std::cout << "  - " << node.node_id() << " (" << node.node_type() << ")\n";
             }
             std::cout << "\n";
         }
@@ -175,15 +410,12 @@ int main(int argc, char* argv[]) {
                          << stats.active_nodes << " active nodes, state: " 
                          << stats.current_algorithm_state << "\n";
             } else if (input == "nodes") {
-                auto& registry = fusion_manager.get_node_registry();
-                auto active_nodes = registry.get_active_nodes(std::chrono::seconds(30));
+                auto active_nodes = fusion_manager.get_node_registry().get_active_node_identities(
+                    std::chrono::seconds(30));
                 std::cout << "Active nodes (" << active_nodes.size() << "):\n";
-                for (const auto& node_id : active_nodes) {
-                    auto node = registry.get_node(node_id);
-                    if (node) {
-                        std::cout << "  " << node_id << " (" << node->node_type() 
-                                 << ") at " << node->location() << "\n";
-                    }
+                for (const auto& node : active_nodes) {
+                    std::cout << "  " << node.node_id() << " (" << node.node_type() 
+                             << ") at " << node.location() << "\n";
                 }
             } else if (input == "reset") {
                 fusion_manager.trigger_algorithm_event("reset");
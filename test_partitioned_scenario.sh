@@ -0,0 +1,117 @@
+#!/bin/bash
+
+# L2 Fusion System Partitioned Test Script
+# Runs two L2 partitions, each ingesting its own radar, against a local Redis
+
+# Colors for output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+BLUE='\033[0;34m'
+NC='\033[0m' # No Color
+
+PARTITIONS=2
+NODES="radar_001=0,radar_002=1,coherent_001=0"
+
+echo -e "${GREEN}========================================${NC}"
+echo -e "${GREEN}L2 Fusion System Partitioned Scenario${NC}"
+echo -e "${GREEN}========================================${NC}"
+echo -e "${BLUE}Scenario:${NC}"
+echo -e "  1. Two L2 processes each own one partition of the L1 nodes"
+echo -e "  2. radar_001 publishes to partition 0, radar_002 to partition 1"
+echo -e "  3. The partitions exchange boundary tracks on l2_boundary_tracks"
+echo -e "  4. Each L2 prints the boundary tracks it sent and received in its statistics"
+echo ""
+
+# Check if Redis is running
+if ! pgrep -x "redis-server" > /dev/null; then
+    echo -e "${YELLOW}Warning: Redis server not detected. Starting Redis...${NC}"
+    redis-server --daemonize yes --port 6379
+    sleep 2
+else
+    echo -e "${GREEN}✓ Redis server is running${NC}"
+fi
+
+# Check if executables exist
+for executable in l2_fusion_system l1_node_simulator; do
+    if [[ ! -f "./build/$executable" ]]; then
+        echo -e "${RED}Error: $executable executable not found. Please build first.${NC}"
+        exit 1
+    fi
+done
+
+echo -e "${GREEN}✓ Executables found${NC}"
+echo ""
+
+# Function to kill background processes on exit
+cleanup() {
+    echo -e "\n${YELLOW}Cleaning up processes...${NC}"
+    kill $PIDS 2>/dev/null
+    sleep 1
+    echo -e "${GREEN}Cleanup complete${NC}"
+}
+
+trap cleanup EXIT INT TERM
+
+PIDS=""
+
+# Start one L2 process per partition. stdin stays open so the interactive
+# loop does not exit
+for partition in $(seq 0 $((PARTITIONS - 1))); do
+    echo -e "${YELLOW}Starting L2 partition $partition...${NC}"
+    tail -f /dev/null | ./build/l2_fusion_system \
+        --algorithm TargetTrackingAlgorithm \
+        --partitions $PARTITIONS \
+        --partition $partition \
+        --partition-nodes "$NODES" \
+        --exchange-interval 500 \
+        > "l2_partition_$partition.log" 2>&1 &
+    PIDS="$PIDS $!"
+done
+sleep 3
+
+# Radars of both partitions, watching the same airspace
+for radar in radar_001 radar_002; do
+    echo -e "${YELLOW}Starting $radar...${NC}"
+    ./build/l1_node_simulator \
+        --node-id "$radar" \
+        --node-type "radar" \
+        --location "$radar" \
+        --interval 1000 \
+        --detection-prob 0.8 \
+        --partitions $PARTITIONS \
+        --partition-nodes "$NODES" &
+    PIDS="$PIDS $!"
+done
+
+echo -e "${YELLOW}Starting coherent_001...${NC}"
+./build/l1_node_simulator \
+    --node-id "coherent_001" \
+    --node-type "coherent" \
+    --location "beam_director" \
+    --interval 30000 \
+    --detection-prob 0.1 \
+    --partitions $PARTITIONS \
+    --partition-nodes "$NODES" &
+PIDS="$PIDS $!"
+
+echo ""
+echo -e "${GREEN}All processes started (PIDs:$PIDS)${NC}"
+echo -e "${BLUE}L2 output: l2_partition_<index>.log${NC}"
+echo -e "${YELLOW}Expected Behavior:${NC}"
+echo -e "  • Each partition only reports its own radar as an active node"
+echo -e "  • 'Boundary Tracks' statistics show tracks sent to and received from the peer"
+echo -e "  • Tracks seen by both radars are handed over to partition 0"
+echo ""
+echo -e "${GREEN}Press Ctrl+C to stop all processes${NC}"
+
+# Monitor processes
+while true; do
+    for pid in $PIDS; do
+        if ! kill -0 $pid 2>/dev/null; then
+            echo -e "${RED}Process $pid died unexpectedly${NC}"
+            exit 1
+        fi
+    done
+    sleep 5
+done
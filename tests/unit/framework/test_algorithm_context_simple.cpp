@@ -202,4 +202,55 @@ TEST_F(AlgorithmContextTest, HandlesFrequentAccess) {
         int expected = 90 + i;  // Last iteration for each key
         EXPECT_EQ(value.value(), expected);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Test in-place access to stored data
+ */
+TEST_F(AlgorithmContextTest, ProvidesInPlaceDataAccess) {
+    auto& values = context->emplace_data<std::vector<int>>("values", 3, 7);
+    ASSERT_EQ(values.size(), 3);
+    
+    // Mutations through the returned reference are visible without set_data
+    values.push_back(9);
+    auto* stored = context->get_data_ptr<std::vector<int>>("values");
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored, &values);
+    EXPECT_EQ(stored->size(), 4);
+    EXPECT_EQ(stored->back(), 9);
+    
+    // Wrong type and missing keys yield nullptr
+    EXPECT_EQ(context->get_data_ptr<std::string>("values"), nullptr);
+    EXPECT_EQ(context->get_data_ptr<int>("missing"), nullptr);
+    
+    // Copying accessor still sees the in-place value
+    auto copy = context->get_data<std::vector<int>>("values");
+    ASSERT_TRUE(copy.has_value());
+    EXPECT_EQ(copy->size(), 4);
+}
+
+/**
+ * @brief Test that message history shares messages instead of copying them
+ */
+TEST_F(AlgorithmContextTest, SharesMessagesInHistory) {
+    dp_aero_l2::messages::L1ToL2Message source;
+    source.mutable_sender()->set_node_id("radar_001");
+    source.set_sequence_number(7);
+    auto message = std::make_shared<const dp_aero_l2::messages::L1ToL2Message>(source);
+    context->add_message_to_history("radar_001", message);
+    
+    // Latest and history refer to the same instance
+    ASSERT_EQ(context->get_message_history("radar_001").size(), 1);
+    EXPECT_EQ(context->get_message_history("radar_001").front().message.get(), message.get());
+    EXPECT_EQ(context->get_latest_message("radar_001").get(), message.get());
+    EXPECT_TRUE(context->get_message_history("unknown").empty());
+    
+    // History is bounded per node
+    context->max_history_per_node = 10;
+    for (int i = 0; i < 20; ++i) {
+        context->add_message_to_history("radar_001", *message);
+    }
+    EXPECT_LE(context->get_message_history("radar_001").size(), 10);
+    EXPECT_EQ(context->get_messages_from_node("radar_001").size(),
+              context->get_message_history("radar_001").size());
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "arena_message_pool.h"
+#include "messages/l1_to_l2.pb.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::core;
+
+/**
+ * @brief Test fixture for ArenaMessagePool
+ */
+class ArenaMessagePoolTest : public ::testing::Test {
+protected:
+    using Pool = ArenaMessagePool<messages::L1ToL2Message>;
+
+    std::string serialized(const std::string& node_id, int sequence) {
+        messages::L1ToL2Message message;
+        message.set_message_id(node_id + "_" + std::to_string(sequence));
+        message.mutable_sender()->set_node_id(node_id);
+        message.set_sequence_number(sequence);
+        return message.SerializeAsString();
+    }
+};
+
+/**
+ * @brief Parsed messages are arena-allocated and keep their content
+ */
+TEST_F(ArenaMessagePoolTest, ParsesIntoArena) {
+    Pool pool;
+    const std::string wire = serialized("radar_001", 5);
+
+    auto message = pool.parse(wire.data(), wire.size());
+    ASSERT_NE(message, nullptr);
+    EXPECT_NE(message->GetArena(), nullptr);
+    EXPECT_EQ(message->sender().node_id(), "radar_001");
+    EXPECT_EQ(message->sequence_number(), 5);
+    EXPECT_EQ(pool.get_stats().messages_parsed, 1u);
+}
+
+/**
+ * @brief Malformed input yields nullptr
+ */
+TEST_F(ArenaMessagePoolTest, RejectsMalformedInput) {
+    Pool pool;
+    const std::string garbage("\xff\xff\xff\xff", 4);
+    EXPECT_EQ(pool.parse(garbage.data(), garbage.size()), nullptr);
+    EXPECT_EQ(pool.get_stats().messages_parsed, 0u);
+}
+
+/**
+ * @brief Arenas are shared per batch and recycled once released
+ */
+TEST_F(ArenaMessagePoolTest, RecyclesArenasAfterRelease) {
+    Pool pool(Pool::Options{.messages_per_arena = 4});
+    const std::string wire = serialized("lidar_001", 1);
+
+    std::vector<Pool::Ptr> batch;
+    for (int i = 0; i < 8; ++i) {
+        batch.push_back(pool.parse(wire.data(), wire.size()));
+    }
+    EXPECT_EQ(batch[0]->GetArena(), batch[3]->GetArena());
+    EXPECT_NE(batch[0]->GetArena(), batch[4]->GetArena());
+    EXPECT_EQ(pool.get_stats().arenas_created, 2u);
+
+    // Releasing the first batch returns its arena to the pool for reuse
+    batch.erase(batch.begin(), batch.begin() + 4);
+    EXPECT_EQ(pool.get_stats().arenas_recycled, 1u);
+
+    for (int i = 0; i < 4; ++i) {
+        batch.push_back(pool.parse(wire.data(), wire.size()));
+    }
+    EXPECT_EQ(pool.get_stats().arenas_created, 2u);
+}
+
+/**
+ * @brief Messages stay valid after the pool is destroyed
+ */
+TEST_F(ArenaMessagePoolTest, MessagesOutliveThePool) {
+    Pool::Ptr message;
+    {
+        Pool pool;
+        const std::string wire = serialized("coherent_001", 9);
+        message = pool.parse(wire.data(), wire.size());
+    }
+    ASSERT_NE(message, nullptr);
+    EXPECT_EQ(message->message_id(), "coherent_001_9");
+}
+
+/**
+ * @brief Concurrent parses share arenas and each message keeps its own content
+ */
+TEST_F(ArenaMessagePoolTest, ParsesConcurrently) {
+    Pool pool(Pool::Options{.messages_per_arena = 8});
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 200;
+
+    std::vector<std::vector<Pool::Ptr>> parsed(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            const std::string node_id = "node_" + std::to_string(t);
+            for (int i = 0; i < kPerThread; ++i) {
+                const std::string wire = serialized(node_id, i);
+                parsed[t].push_back(pool.parse(wire.data(), wire.size()));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool.get_stats().messages_parsed, static_cast<uint64_t>(kThreads * kPerThread));
+    for (int t = 0; t < kThreads; ++t) {
+        for (int i = 0; i < kPerThread; ++i) {
+            ASSERT_NE(parsed[t][i], nullptr);
+            EXPECT_EQ(parsed[t][i]->message_id(), "node_" + std::to_string(t) + "_" + std::to_string(i));
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "deadline_scheduler.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace dp_aero_l2::core;
+using namespace std::chrono_literals;
+
+/**
+ * @brief Ticks keep their cadence even when each run takes most of the interval
+ */
+TEST(DeadlineSchedulerTest, CadenceDoesNotDrift) {
+    DeadlineScheduler scheduler;
+    std::atomic<int> runs{0};
+    scheduler.add_periodic("update", 10ms, [&runs] {
+        ++runs;
+        std::this_thread::sleep_for(6ms);
+    });
+
+    scheduler.start();
+    std::this_thread::sleep_for(205ms);
+    scheduler.stop();
+
+    // Sleeping the interval after each run would give about 12 runs
+    EXPECT_GE(runs.load(), 17);
+    EXPECT_LE(runs.load(), 21);
+    auto stats = scheduler.stats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].name, "update");
+    EXPECT_EQ(stats[0].ticks, static_cast<uint64_t>(runs.load()));
+    EXPECT_LE(stats[0].jitter_p50, stats[0].jitter_p99);
+    EXPECT_LE(stats[0].jitter_p99, stats[0].jitter_max);
+}
+
+/**
+ * @brief A run longer than several intervals skips the ticks it covered
+ */
+TEST(DeadlineSchedulerTest, SkipsMissedTicks) {
+    DeadlineScheduler scheduler;
+    std::atomic<int> runs{0};
+    scheduler.add_periodic("slow", 10ms, [&runs] {
+        if (runs++ == 0) {
+            std::this_thread::sleep_for(55ms);
+        }
+    });
+
+    scheduler.start();
+    std::this_thread::sleep_for(100ms);
+    scheduler.stop();
+
+    auto stats = scheduler.stats();
+    EXPECT_GE(stats[0].missed, 4u);
+    EXPECT_LE(stats[0].ticks + stats[0].missed, 11u);
+    EXPECT_LT(stats[0].jitter_max, 10ms);  // Skipping keeps the late ticks within an interval
+}
+
+/**
+ * @brief trigger() runs a task at once without waiting for its tick
+ */
+TEST(DeadlineSchedulerTest, TriggerRunsImmediately) {
+    DeadlineScheduler scheduler;
+    std::atomic<int> runs{0};
+    auto id = scheduler.add_periodic("update", 10s, [&runs] { ++runs; });
+    scheduler.add_periodic("other", 10s, [] {});
+
+    scheduler.start();
+    scheduler.trigger(id);
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    while (runs.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    scheduler.stop();
+
+    EXPECT_EQ(runs.load(), 1);
+    auto stats = scheduler.stats();
+    EXPECT_EQ(stats[0].triggered, 1u);
+    EXPECT_EQ(stats[0].ticks, 0u);
+}
+
+/**
+ * @brief stop() returns promptly instead of waiting out the interval
+ */
+TEST(DeadlineSchedulerTest, StopWakesPromptly) {
+    DeadlineScheduler scheduler;
+    scheduler.add_periodic("heartbeat", 30s, [] {});
+    scheduler.start();
+    std::this_thread::sleep_for(5ms);
+
+    const auto start = std::chrono::steady_clock::now();
+    scheduler.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+
+    // Restartable, and tasks can only be added while stopped
+    scheduler.add_periodic("late", 1s, [] {});
+    scheduler.start();
+    EXPECT_THROW(scheduler.add_periodic("running", 1s, [] {}), std::logic_error);
+    EXPECT_THROW(DeadlineScheduler().add_periodic("zero", 0ms, [] {}), std::invalid_argument);
+    scheduler.stop();
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "l1_envelope.h"
+#include "messages/l1_to_l2.pb.h"
+#include <string>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::core;
+
+/**
+ * @brief Test fixture for reading L1 message envelopes
+ */
+class L1EnvelopeTest : public ::testing::Test {
+protected:
+    static messages::L1ToL2Message make_message(const std::string& node_id, int32_t sequence) {
+        messages::L1ToL2Message message;
+        message.set_message_id(node_id + "_msg");
+        message.mutable_sender()->set_node_id(node_id);
+        message.mutable_sender()->set_node_type("radar");
+        message.set_sequence_number(sequence);
+        message.set_correlation_id("corr");
+        return message;
+    }
+};
+
+/**
+ * @brief Heartbeats are recognised with their sender and sequence number
+ */
+TEST_F(L1EnvelopeTest, ReadsHeartbeat) {
+    auto message = make_message("radar_001", 42);
+    message.mutable_heartbeat();
+    const std::string wire = message.SerializeAsString();
+
+    auto envelope = peek_l1_envelope(wire);
+    ASSERT_TRUE(envelope.has_value());
+    EXPECT_EQ(envelope->payload_case, messages::L1ToL2Message::kHeartbeat);
+    EXPECT_EQ(envelope->node_id, "radar_001");
+    EXPECT_EQ(envelope->sequence_number, 42);
+    EXPECT_EQ(envelope->sensor_case, data_streams::SensorData::DATA_TYPE_NOT_SET);
+}
+
+/**
+ * @brief Sensor data reports its sensor type
+ */
+TEST_F(L1EnvelopeTest, ReadsSensorType) {
+    auto message = make_message("lidar_001", -3);
+    message.mutable_sensor_data()->mutable_lidar()->add_points()->set_x(1.0f);
+    const std::string wire = message.SerializeAsString();
+
+    auto envelope = peek_l1_envelope(wire);
+    ASSERT_TRUE(envelope.has_value());
+    EXPECT_EQ(envelope->payload_case, messages::L1ToL2Message::kSensorData);
+    EXPECT_EQ(envelope->sensor_case, data_streams::SensorData::kLidar);
+    EXPECT_EQ(envelope->sequence_number, -3);
+}
+
+/**
+ * @brief The sender and payload views parse to the original sub-messages
+ */
+TEST_F(L1EnvelopeTest, ViewsHoldSubMessages) {
+    auto message = make_message("radar_002", 7);
+    message.mutable_node_status()->set_cpu_usage(0.5f);
+    const std::string wire = message.SerializeAsString();
+
+    auto envelope = peek_l1_envelope(wire);
+    ASSERT_TRUE(envelope.has_value());
+    ASSERT_EQ(envelope->payload_case, messages::L1ToL2Message::kNodeStatus);
+
+    common::NodeIdentity sender;
+    ASSERT_TRUE(sender.ParseFromArray(envelope->sender.data(), static_cast<int>(envelope->sender.size())));
+    EXPECT_EQ(sender.SerializeAsString(), message.sender().SerializeAsString());
+
+    common::NodeStatus status;
+    ASSERT_TRUE(status.ParseFromArray(envelope->payload.data(), static_cast<int>(envelope->payload.size())));
+    EXPECT_EQ(status.SerializeAsString(), message.node_status().SerializeAsString());
+}
+
+/**
+ * @brief Fields the envelope does not know about are skipped
+ */
+TEST_F(L1EnvelopeTest, SkipsUnknownFields) {
+    auto message = make_message("radar_003", 9);
+    message.mutable_heartbeat();
+    std::string wire = message.SerializeAsString();
+    wire += std::string("\xa8\x06\x05", 3);             // Field 101, varint 5
+    wire += std::string("\xb5\x06\x00\x00\x80\x3f", 6);  // Field 102, fixed32
+
+    auto envelope = peek_l1_envelope(wire);
+    ASSERT_TRUE(envelope.has_value());
+    EXPECT_EQ(envelope->payload_case, messages::L1ToL2Message::kHeartbeat);
+    EXPECT_EQ(envelope->node_id, "radar_003");
+}
+
+/**
+ * @brief Truncated or corrupt buffers are rejected rather than half read
+ */
+TEST_F(L1EnvelopeTest, RejectsMalformedBuffer) {
+    auto message = make_message("radar_004", 1);
+    message.mutable_sensor_data()->mutable_radar()->add_detections()->set_range(10.0f);
+    const std::string wire = message.SerializeAsString();
+
+    EXPECT_FALSE(peek_l1_envelope(wire.substr(0, wire.size() - 3)).has_value());
+    EXPECT_FALSE(peek_l1_envelope(std::string("\x22\x7f\x01", 3)).has_value());  // Length past the end
+    EXPECT_FALSE(peek_l1_envelope(std::string("\x07", 1)).has_value());          // Invalid wire type
+
+    auto empty = peek_l1_envelope(std::string());
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_EQ(empty->payload_case, messages::L1ToL2Message::PAYLOAD_NOT_SET);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "l2_fusion_manager.h"
+#include <string>
+
+using namespace dp_aero_l2;
+
+namespace {
+
+std::string radar_message(const std::string& node_id, int32_t sequence) {
+    messages::L1ToL2Message message;
+    message.mutable_sender()->set_node_id(node_id);
+    message.set_sequence_number(sequence);
+    message.mutable_sensor_data()->mutable_radar()->add_detections()->set_range(10.0f);
+    return message.SerializeAsString();
+}
+
+} // namespace
+
+/**
+ * @brief A node restarting its numbering keeps being processed, wherever it restarts
+ */
+TEST(L2FusionManagerTest, KeepsMessagesOfRestartedNode) {
+    core::L2FusionManager manager;
+    for (int32_t sequence = 1; sequence <= 20; ++sequence) {
+        ASSERT_TRUE(manager.ingest_l1_message(radar_message("radar_restart", sequence)));
+    }
+
+    // Restarted within the window: its first numbers look like duplicates
+    for (int32_t sequence = 1; sequence <= 5; ++sequence) {
+        EXPECT_TRUE(manager.ingest_l1_message(radar_message("radar_restart", sequence)));
+    }
+    EXPECT_EQ(manager.get_stats().sequence.duplicates, 5u);
+
+    // Restarted after more than a window of messages
+    for (int32_t sequence = 6; sequence <= 100; ++sequence) {
+        manager.ingest_l1_message(radar_message("radar_restart", sequence));
+    }
+    EXPECT_TRUE(manager.ingest_l1_message(radar_message("radar_restart", 1)));
+    EXPECT_EQ(manager.get_stats().sequence.restarts, 1u);
+}
+
+/**
+ * @brief Entries arriving after newer ones (e.g. claimed from a dead consumer) are processed
+ */
+TEST(L2FusionManagerTest, KeepsLateMessages) {
+    core::L2FusionManager manager;
+    ASSERT_TRUE(manager.ingest_l1_message(radar_message("radar_claimed", 1)));
+    ASSERT_TRUE(manager.ingest_l1_message(radar_message("radar_claimed", 4)));
+
+    EXPECT_TRUE(manager.ingest_l1_message(radar_message("radar_claimed", 2)));
+    EXPECT_TRUE(manager.ingest_l1_message(radar_message("radar_claimed", 3)));
+
+    const auto sequence = manager.get_stats().sequence;
+    EXPECT_EQ(sequence.late, 2u);
+    EXPECT_EQ(sequence.missing, 0u);
+}
+
+/**
+ * @brief With drop_duplicates, only messages already seen are dropped
+ */
+TEST(L2FusionManagerTest, DropsOnlyDuplicatesWhenAsked) {
+    core::L2Config config;
+    config.drop_duplicates = true;
+    core::L2FusionManager manager(config);
+    ASSERT_TRUE(manager.ingest_l1_message(radar_message("radar_dup", 1)));
+    ASSERT_TRUE(manager.ingest_l1_message(radar_message("radar_dup", 3)));
+
+    EXPECT_FALSE(manager.ingest_l1_message(radar_message("radar_dup", 3)));
+    EXPECT_TRUE(manager.ingest_l1_message(radar_message("radar_dup", 2)));
+}
+
+/**
+ * @brief Past max_l1_nodes, unknown node ids are rejected before they are interned
+ */
+TEST(L2FusionManagerTest, RejectsNodesPastTheLimit) {
+    auto& nodes = core::SymbolTable<core::NodeTag>::global();
+    core::L2Config config;
+    config.max_l1_nodes = nodes.size() + 1;
+    core::L2FusionManager manager(config);
+
+    ASSERT_TRUE(manager.ingest_l1_message(radar_message("radar_admitted", 1)));
+    EXPECT_FALSE(manager.ingest_l1_message(radar_message("radar_excess", 1)));
+    EXPECT_FALSE(nodes.find("radar_excess"));
+    EXPECT_EQ(manager.get_stats().nodes_rejected, 1u);
+
+    EXPECT_TRUE(manager.ingest_l1_message(radar_message("radar_admitted", 2)));
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "algorithm_framework.h"
+#include "message_history.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::fusion;
+
+namespace {
+
+HistoryEntry make_entry(int32_t sequence,
+                        std::chrono::steady_clock::time_point received = std::chrono::steady_clock::now()) {
+    return HistoryEntry{.summary = {.received = received, .sequence_number = sequence}, .message = nullptr};
+}
+
+std::vector<int32_t> sequences(const MessageRing& ring) {
+    std::vector<int32_t> result;
+    for (const auto& entry : ring) {
+        result.push_back(entry.summary.sequence_number);
+    }
+    return result;
+}
+
+} // namespace
+
+/**
+ * @brief A full ring overwrites its oldest entries and reads oldest first
+ */
+TEST(MessageRingTest, OverwritesOldest) {
+    MessageRing ring(4);
+    for (int32_t sequence = 1; sequence <= 6; ++sequence) {
+        ring.push(make_entry(sequence));
+    }
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(sequences(ring), (std::vector<int32_t>{3, 4, 5, 6}));
+    EXPECT_EQ(ring.front().summary.sequence_number, 3);
+    EXPECT_EQ(ring.back().summary.sequence_number, 6);
+    EXPECT_EQ(ring[1].summary.sequence_number, 4);
+
+    // Wrapped: two runs, older first
+    auto [older, newer] = ring.spans();
+    ASSERT_EQ(older.size(), 2u);
+    ASSERT_EQ(newer.size(), 2u);
+    EXPECT_EQ(older[0].summary.sequence_number, 3);
+    EXPECT_EQ(newer[1].summary.sequence_number, 6);
+
+    MessageRing disabled(0);
+    disabled.push(make_entry(1));
+    EXPECT_TRUE(disabled.empty());
+}
+
+/**
+ * @brief Expiry drops old entries and releases their messages
+ */
+TEST(MessageRingTest, ExpiresByAge) {
+    const auto now = std::chrono::steady_clock::now();
+    auto message = std::make_shared<const messages::L1ToL2Message>();
+    MessageRing ring(8);
+    for (int32_t sequence = 1; sequence <= 5; ++sequence) {
+        auto entry = make_entry(sequence, now + std::chrono::seconds(sequence));
+        entry.message = message;
+        ring.push(std::move(entry));
+    }
+    EXPECT_EQ(message.use_count(), 6);
+
+    EXPECT_EQ(ring.expire(now + std::chrono::seconds(3)), 3u);
+    EXPECT_EQ(sequences(ring), (std::vector<int32_t>{4, 5}));
+    EXPECT_EQ(message.use_count(), 3);
+}
+
+/**
+ * @brief Resizing keeps the most recent entries in order
+ */
+TEST(MessageRingTest, ResizeKeepsNewest) {
+    MessageRing ring(4);
+    for (int32_t sequence = 1; sequence <= 6; ++sequence) {
+        ring.push(make_entry(sequence));
+    }
+    ring.set_capacity(2);
+    EXPECT_EQ(sequences(ring), (std::vector<int32_t>{5, 6}));
+    ring.set_capacity(3);
+    ring.push(make_entry(7));
+    EXPECT_EQ(sequences(ring), (std::vector<int32_t>{5, 6, 7}));
+}
+
+/**
+ * @brief In summary mode the context keeps message facts but not the messages
+ */
+TEST(MessageRingTest, ContextKeepsSummaries) {
+    AlgorithmContext context;
+    context.history_summaries_only = true;
+
+    messages::L1ToL2Message source;
+    source.mutable_sender()->set_node_id("radar_001");
+    source.set_sequence_number(9);
+    source.mutable_sensor_data()->mutable_radar();
+    auto message = std::make_shared<const messages::L1ToL2Message>(source);
+    context.add_message_to_history("radar_001", message);
+
+    const auto& history = context.get_message_history("radar_001");
+    ASSERT_EQ(history.size(), 1u);
+    EXPECT_EQ(history.front().message, nullptr);
+    EXPECT_EQ(history.front().summary.sequence_number, 9);
+    EXPECT_EQ(history.front().summary.sensor_case, data_streams::SensorData::kRadar);
+    EXPECT_EQ(context.get_latest_message("radar_001").get(), message.get());
+    EXPECT_TRUE(context.get_messages_from_node("radar_001").empty());
+}
+
+/**
+ * @brief Retention drops expired entries and nodes left empty
+ */
+TEST(MessageRingTest, ContextExpiresHistory) {
+    AlgorithmContext context;
+    context.history_retention = std::chrono::milliseconds(50);
+    context.add_message_to_history("imu_001", messages::L1ToL2Message{});
+    context.expire_message_history();
+    EXPECT_EQ(context.get_message_history("imu_001").size(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    context.expire_message_history();
+    EXPECT_TRUE(context.get_message_history("imu_001").empty());
+    EXPECT_EQ(context.message_history.size(), 0u);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "mpmc_queue.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2::core;
+
+/**
+ * @brief Test fixture for MpmcQueue
+ */
+class MpmcQueueTest : public ::testing::Test {
+protected:
+    std::vector<int> drain(MpmcQueue<int>& queue) {
+        std::vector<int> items;
+        queue.try_pop_batch(items, queue.capacity());
+        return items;
+    }
+};
+
+/**
+ * @brief Items come out in FIFO order, including across the ring wrap
+ */
+TEST_F(MpmcQueueTest, PreservesFifoOrder) {
+    MpmcQueue<int> queue(5);
+    int next_in = 0, next_out = 0;
+    for (int round = 0; round < 7; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_EQ(queue.push(next_in++), PushResult::Enqueued);
+        }
+        int value = -1;
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, next_out++);
+        }
+    }
+    int value;
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(queue.size_approx(), 0u);
+}
+
+/**
+ * @brief Capacities below two are rejected
+ */
+TEST_F(MpmcQueueTest, RejectsTooSmallCapacity) {
+    EXPECT_THROW(MpmcQueue<int>(0), std::invalid_argument);
+    EXPECT_THROW(MpmcQueue<int>(1), std::invalid_argument);
+}
+
+/**
+ * @brief DropOldest keeps the newest capacity items
+ */
+TEST_F(MpmcQueueTest, DropOldestDiscardsHead) {
+    MpmcQueue<int> queue(3, OverflowPolicy::DropOldest);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(queue.push(i), PushResult::Enqueued);
+    }
+    EXPECT_EQ(queue.push(3), PushResult::EnqueuedDroppedOldest);
+    EXPECT_EQ(queue.push(4), PushResult::EnqueuedDroppedOldest);
+
+    EXPECT_EQ(drain(queue), (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(queue.dropped_count(), 2u);
+}
+
+/**
+ * @brief DropNewest rejects items once full
+ */
+TEST_F(MpmcQueueTest, DropNewestRejectsTail) {
+    MpmcQueue<int> queue(3, OverflowPolicy::DropNewest);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(queue.push(i), PushResult::Enqueued);
+    }
+    EXPECT_EQ(queue.push(3), PushResult::DroppedNewest);
+
+    EXPECT_EQ(drain(queue), (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(queue.dropped_count(), 1u);
+}
+
+/**
+ * @brief Block waits for a consumer and never drops
+ */
+TEST_F(MpmcQueueTest, BlockWaitsForSpace) {
+    MpmcQueue<int> queue(2, OverflowPolicy::Block);
+    std::thread producer([&queue] {
+        for (int i = 0; i < 100; ++i) {
+            queue.push(i);
+        }
+    });
+
+    std::vector<int> received;
+    while (received.size() < 100) {
+        queue.pop_batch_wait(received, 8);
+    }
+    producer.join();
+
+    std::vector<int> expected(100);
+    for (int i = 0; i < 100; ++i) expected[i] = i;
+    EXPECT_EQ(received, expected);
+    EXPECT_EQ(queue.dropped_count(), 0u);
+}
+
+/**
+ * @brief Batch dequeue respects the limit
+ */
+TEST_F(MpmcQueueTest, PopsBatches) {
+    MpmcQueue<int> queue(16);
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    std::vector<int> batch;
+    EXPECT_EQ(queue.pop_batch_wait(batch, 4), 4u);
+    EXPECT_EQ(queue.try_pop_batch(batch, 100), 6u);
+    EXPECT_EQ(batch.size(), 10u);
+    EXPECT_EQ(queue.try_pop_batch(batch, 100), 0u);
+}
+
+/**
+ * @brief close() wakes waiting consumers and blocked producers
+ */
+TEST_F(MpmcQueueTest, CloseWakesWaiters) {
+    MpmcQueue<int> queue(2, OverflowPolicy::Block);
+    queue.push(0);
+    queue.push(1);
+
+    std::atomic<int> producer_result{-1};
+    std::thread producer([&] { producer_result = static_cast<int>(queue.push(2)); });
+
+    MpmcQueue<int> empty(4);
+    std::thread consumer([&] {
+        std::vector<int> batch;
+        EXPECT_EQ(empty.pop_batch_wait(batch, 4), 0u);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    empty.close();
+    producer.join();
+    consumer.join();
+
+    EXPECT_EQ(producer_result.load(), static_cast<int>(PushResult::Closed));
+    EXPECT_EQ(queue.push(3), PushResult::Closed);
+
+    // Queued items remain poppable after close
+    int value = -1;
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 0);
+}
+
+/**
+ * @brief Every item is delivered exactly once under concurrent use
+ */
+TEST_F(MpmcQueueTest, DeliversEachItemOnceAcrossThreads) {
+    constexpr int kProducers = 3;
+    constexpr int kConsumers = 3;
+    constexpr int kPerProducer = 20000;
+    MpmcQueue<std::unique_ptr<int>> queue(64, OverflowPolicy::Block);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                queue.push(std::make_unique<int>(p * kPerProducer + i));
+            }
+        });
+    }
+
+    std::vector<std::vector<int>> received(kConsumers);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < kConsumers; ++c) {
+        consumers.emplace_back([&queue, &received, c] {
+            std::vector<std::unique_ptr<int>> batch;
+            while (queue.pop_batch_wait(batch, 16) > 0) {
+                for (auto& item : batch) {
+                    received[c].push_back(*item);
+                }
+                batch.clear();
+            }
+        });
+    }
+
+    for (auto& thread : producers) thread.join();
+    while (queue.size_approx() > 0) {
+        std::this_thread::yield();
+    }
+    queue.close();
+    for (auto& thread : consumers) thread.join();
+
+    std::vector<int> all;
+    for (auto& items : received) {
+        all.insert(all.end(), items.begin(), items.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), static_cast<size_t>(kProducers * kPerProducer));
+    for (size_t i = 0; i < all.size(); ++i) {
+        ASSERT_EQ(all[i], static_cast<int>(i));
+    }
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "node_registry.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::core;
+
+namespace {
+
+common::NodeIdentity make_node(const std::string& node_id, const std::string& location = "north") {
+    common::NodeIdentity node;
+    node.set_node_id(node_id);
+    node.set_node_type("radar");
+    node.set_location(location);
+    return node;
+}
+
+} // namespace
+
+/**
+ * @brief Registered nodes can be looked up and are active
+ */
+TEST(NodeRegistryTest, RegistersNodes) {
+    NodeRegistry registry;
+    registry.register_node(make_node("radar_001"));
+    registry.register_node(make_node("radar_002"));
+
+    ASSERT_TRUE(registry.get_node("radar_001").has_value());
+    EXPECT_EQ(registry.get_node("radar_001")->node_type(), "radar");
+    EXPECT_FALSE(registry.get_node("radar_003").has_value());
+    EXPECT_EQ(registry.size(), 2u);
+    EXPECT_EQ(registry.count_active_nodes(std::chrono::seconds(30)), 2u);
+    EXPECT_EQ(registry.get_active_node_identities(std::chrono::seconds(30)).size(), 2u);
+}
+
+/**
+ * @brief touch_node() only refreshes a node whose identity is unchanged
+ */
+TEST(NodeRegistryTest, TouchDetectsIdentityChange) {
+    NodeRegistry registry;
+    const auto node = make_node("radar_001");
+    const std::string serialized = node.SerializeAsString();
+
+    EXPECT_FALSE(registry.touch_node("radar_001", serialized));
+    registry.register_node(node, serialized);
+    EXPECT_TRUE(registry.touch_node("radar_001", serialized));
+
+    const auto moved = make_node("radar_001", "south");
+    EXPECT_FALSE(registry.touch_node("radar_001", moved.SerializeAsString()));
+    registry.register_node(moved);
+    EXPECT_EQ(registry.get_node("radar_001")->location(), "south");
+    EXPECT_EQ(registry.size(), 1u);
+}
+
+/**
+ * @brief Heartbeats and status from unknown nodes create a bare record
+ */
+TEST(NodeRegistryTest, StatusSurvivesReRegistration) {
+    NodeRegistry registry;
+    registry.update_node_heartbeat("imu_001");
+    ASSERT_TRUE(registry.get_node("imu_001").has_value());
+    EXPECT_TRUE(registry.get_node("imu_001")->node_type().empty());
+    EXPECT_FALSE(registry.get_node_status("imu_001").has_value());
+
+    common::NodeStatus status;
+    status.set_cpu_usage(42.0f);
+    registry.update_node_status("imu_001", status);
+    registry.register_node(make_node("imu_001"));
+
+    EXPECT_EQ(registry.get_node("imu_001")->node_type(), "radar");
+    ASSERT_TRUE(registry.get_node_status("imu_001").has_value());
+    EXPECT_FLOAT_EQ(registry.get_node_status("imu_001")->cpu_usage(), 42.0f);
+}
+
+/**
+ * @brief Only nodes not heard from within the timeout are removed
+ */
+TEST(NodeRegistryTest, RemovesOnlyTimedOutNodes) {
+    NodeRegistry registry;
+    registry.register_node(make_node("stale"));
+    registry.register_node(make_node("alive"));
+    registry.register_node(make_node("removed"));
+    registry.remove_node("removed");
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    registry.update_node_heartbeat("alive");
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+
+    auto removed = registry.check_and_remove_timed_out_nodes(std::chrono::seconds(1));
+    EXPECT_EQ(removed, std::vector<std::string>{"stale"});
+    EXPECT_TRUE(registry.get_node("alive").has_value());
+    EXPECT_EQ(registry.size(), 1u);
+
+    // The refreshed node is still due once its own timeout passes
+    EXPECT_TRUE(registry.check_and_remove_timed_out_nodes(std::chrono::seconds(1)).empty());
+    EXPECT_EQ(registry.check_and_remove_timed_out_nodes(std::chrono::seconds(0)),
+              std::vector<std::string>{"alive"});
+    EXPECT_EQ(registry.size(), 0u);
+}
+
+/**
+ * @brief Readers see consistent snapshots while heartbeats and registrations go on
+ */
+TEST(NodeRegistryTest, ConcurrentHeartbeatsAndReaders) {
+    NodeRegistry registry;
+    constexpr int kNodes = 64;
+    for (int i = 0; i < kNodes; ++i) {
+        registry.register_node(make_node("node_" + std::to_string(i)));
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&registry, t] {
+            for (int round = 0; round < 2000; ++round) {
+                const int i = (round * 4 + t) % kNodes;
+                registry.update_node_heartbeat("node_" + std::to_string(i));
+                if (round % 100 == 0) {
+                    registry.register_node(make_node("node_" + std::to_string(i), "moved_" + std::to_string(round)));
+                }
+            }
+        });
+    }
+    size_t min_seen = kNodes;
+    std::thread reader([&] {
+        while (!done.load()) {
+            min_seen = std::min(min_seen, registry.get_active_node_identities(std::chrono::seconds(30)).size());
+        }
+    });
+
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done.store(true);
+    reader.join();
+
+    EXPECT_EQ(min_seen, static_cast<size_t>(kNodes));
+    EXPECT_EQ(registry.count_active_nodes(std::chrono::seconds(30)), static_cast<size_t>(kNodes));
+}
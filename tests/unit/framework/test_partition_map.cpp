@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "partition_map.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace dp_aero_l2::core;
+
+/**
+ * @brief Test fixture for PartitionMap
+ */
+class PartitionMapTest : public ::testing::Test {
+protected:
+    static constexpr float kSectorSize = 1000.0f;
+    static constexpr float kMargin = 50.0f;
+
+    // x coordinate of a vertical sector border at y = 500 whose two sides
+    // belong to different partitions
+    static float foreign_border(const PartitionMap& map) {
+        for (int sector = -50; sector < 50; ++sector) {
+            const float border = kSectorSize * sector;
+            if (map.partition_of_position(border - 1.0f, 500.0f) != map.partition_of_position(border + 1.0f, 500.0f)) {
+                return border;
+            }
+        }
+        ADD_FAILURE() << "No border between partitions found";
+        return 0.0f;
+    }
+};
+
+/**
+ * @brief A default map is one partition that keeps the plain channel names
+ */
+TEST_F(PartitionMapTest, DefaultIsSinglePartition) {
+    PartitionMap map;
+    EXPECT_FALSE(map.partitioned());
+    EXPECT_EQ(map.count(), 1u);
+    EXPECT_EQ(map.partition_of_node("radar_001"), 0u);
+    EXPECT_EQ(map.channel("l1_to_l2"), "l1_to_l2");
+    EXPECT_FALSE(map.near_boundary(0.0f, 0.0f));
+}
+
+/**
+ * @brief Invalid partition layouts are rejected
+ */
+TEST_F(PartitionMapTest, RejectsInvalidLayout) {
+    EXPECT_THROW(PartitionMap(0, 0), std::invalid_argument);
+    EXPECT_THROW(PartitionMap(2, 2), std::invalid_argument);
+    EXPECT_THROW(PartitionMap(2, 0, PartitionScheme::Sector, 0.0f), std::invalid_argument);
+    EXPECT_THROW(PartitionMap(2, 0, PartitionScheme::Sector, 1000.0f, -1.0f), std::invalid_argument);
+}
+
+/**
+ * @brief Node placement is the same in every process and build
+ */
+TEST_F(PartitionMapTest, HashesNodesStably) {
+    PartitionMap map(4, 0);
+    EXPECT_EQ(map.partition_of_node("radar_001"), 3u);
+    EXPECT_EQ(map.partition_of_node("radar_002"), 2u);
+    EXPECT_EQ(map.partition_of_node("lidar_001"), 1u);
+    EXPECT_EQ(map.channel_for_node("l1_to_l2", "radar_002"), "l1_to_l2.p2");
+    EXPECT_EQ(map.channel("l1_to_l2_stream", 3), "l1_to_l2_stream.p3");
+    EXPECT_EQ(map.channel("l1_to_l2"), "l1_to_l2.p0");
+}
+
+/**
+ * @brief Explicit assignments override the hash
+ */
+TEST_F(PartitionMapTest, AssignsNodesFromList) {
+    PartitionMap map(4, 0);
+    map.assign_nodes("radar_001=0,lidar_001=2,");
+    EXPECT_EQ(map.partition_of_node("radar_001"), 0u);
+    EXPECT_EQ(map.partition_of_node("lidar_001"), 2u);
+    EXPECT_EQ(map.partition_of_node("radar_002"), 2u);  // Still hashed
+
+    EXPECT_THROW(map.assign_nodes("radar_001"), std::invalid_argument);
+    EXPECT_THROW(map.assign_nodes("=1"), std::invalid_argument);
+    EXPECT_THROW(map.assign_nodes("radar_001=x"), std::invalid_argument);
+    EXPECT_THROW(map.assign_nodes("radar_001=4"), std::out_of_range);
+}
+
+/**
+ * @brief With sectors, only tracks within the margin of a foreign sector are shared
+ */
+TEST_F(PartitionMapTest, SectorBoundaryUsesMargin) {
+    PartitionMap map(2, 0, PartitionScheme::Sector, kSectorSize, kMargin);
+    const float border = foreign_border(map);
+
+    EXPECT_TRUE(map.near_boundary(border - kMargin + 1.0f, 500.0f));
+    EXPECT_TRUE(map.near_boundary(border + kMargin - 1.0f, 500.0f));
+
+    // The centre of an own sector is further than the margin from any other
+    bool found = false;
+    for (int sector = -50; sector < 50 && !found; ++sector) {
+        const float centre = kSectorSize * sector + kSectorSize / 2;
+        if (map.partition_of_position(centre, 500.0f) == 0) {
+            EXPECT_FALSE(map.near_boundary(centre, 500.0f));
+            found = true;
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+/**
+ * @brief Both sides of a shared track agree on its owner
+ */
+TEST_F(PartitionMapTest, TrackOwnerIsSymmetric) {
+    PartitionMap first(2, 0, PartitionScheme::Sector, kSectorSize, kMargin);
+    PartitionMap second(2, 1, PartitionScheme::Sector, kSectorSize, kMargin);
+    const float border = foreign_border(first);
+
+    // Both estimates in one sector: its owner
+    const float inside = border + 10.0f;
+    const size_t owner = first.partition_of_position(inside, 500.0f);
+    EXPECT_EQ(first.track_owner(inside, 500.0f, inside + 1.0f, 500.0f, 1), owner);
+    EXPECT_EQ(second.track_owner(inside + 1.0f, 500.0f, inside, 500.0f, 0), owner);
+
+    // Estimates straddling the border: the lower index
+    EXPECT_EQ(first.track_owner(border - 1.0f, 500.0f, border + 1.0f, 500.0f, 1), 0u);
+    EXPECT_EQ(second.track_owner(border + 1.0f, 500.0f, border - 1.0f, 500.0f, 0), 0u);
+
+    // Without sectors every track may be shared and the lower index keeps it
+    PartitionMap by_node(3, 2);
+    EXPECT_TRUE(by_node.near_boundary(0.0f, 0.0f));
+    EXPECT_EQ(by_node.track_owner(0.0f, 0.0f, 0.0f, 0.0f, 1), 1u);
+}
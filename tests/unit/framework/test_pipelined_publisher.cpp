@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "pipelined_publisher.h"
+#include "messages/l2_to_l1.pb.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::redis_utils;
+
+/**
+ * @brief Test fixture for PipelinedPublisher, recording each flushed batch
+ */
+class PipelinedPublisherTest : public ::testing::Test {
+protected:
+    std::mutex mutex;
+    std::vector<std::vector<std::string>> batches;
+
+    PipelinedPublisher::FlushFunction recorder() {
+        return [this](std::span<const OutboundMessage> batch) {
+            std::vector<std::string> payloads;
+            for (const auto& message : batch) {
+                payloads.push_back(message.channel + ":" + message.payload);
+            }
+            std::lock_guard lock(mutex);
+            batches.push_back(std::move(payloads));
+        };
+    }
+
+    std::vector<std::vector<std::string>> recorded() {
+        std::lock_guard lock(mutex);
+        return batches;
+    }
+};
+
+/**
+ * @brief A burst within the delay goes out as one batch, in order
+ */
+TEST_F(PipelinedPublisherTest, CoalescesBurstIntoOneBatch) {
+    PipelinedPublisher publisher(recorder(), {.max_batch = 64, .max_delay = std::chrono::seconds(10)});
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(publisher.publish_raw("out", std::to_string(i)));
+    }
+    publisher.flush();
+
+    auto sent = recorded();
+    ASSERT_EQ(sent.size(), 1u);
+    ASSERT_EQ(sent[0].size(), 10u);
+    EXPECT_EQ(sent[0].front(), "out:0");
+    EXPECT_EQ(sent[0].back(), "out:9");
+
+    auto stats = publisher.get_stats();
+    EXPECT_EQ(stats.batches, 1u);
+    EXPECT_EQ(stats.messages_published, 10u);
+    EXPECT_EQ(stats.max_batch_size, 10u);
+    EXPECT_DOUBLE_EQ(stats.average_batch_size, 10.0);
+}
+
+/**
+ * @brief Batches are cut at max_batch without waiting for the deadline
+ */
+TEST_F(PipelinedPublisherTest, FlushesOnSize) {
+    PipelinedPublisher publisher(recorder(), {.max_batch = 4, .max_delay = std::chrono::seconds(10)});
+    for (int i = 0; i < 8; ++i) {
+        publisher.publish_raw("out", std::to_string(i));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (publisher.get_stats().messages_published < 8 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto sent = recorded();
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[0].size(), 4u);
+    EXPECT_EQ(sent[1].size(), 4u);
+}
+
+/**
+ * @brief A partial batch goes out once its oldest message reaches the delay
+ */
+TEST_F(PipelinedPublisherTest, FlushesOnDeadline) {
+    PipelinedPublisher publisher(recorder(), {.max_batch = 64, .max_delay = std::chrono::milliseconds(20)});
+    publisher.publish_raw("out", "a");
+    publisher.publish_raw("out", "b");
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (publisher.get_stats().batches == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto stats = publisher.get_stats();
+    EXPECT_EQ(stats.batches, 1u);
+    EXPECT_EQ(stats.last_batch_size, 2u);
+    EXPECT_GE(stats.last_flush_latency, std::chrono::milliseconds(20));
+}
+
+/**
+ * @brief Protobuf messages are serialized by the caller and arrive intact
+ */
+TEST_F(PipelinedPublisherTest, PublishesSerializedProtobuf) {
+    std::vector<std::string> payloads;
+    PipelinedPublisher publisher([&payloads](std::span<const OutboundMessage> batch) {
+        for (const auto& message : batch) payloads.push_back(message.payload);
+    });
+
+    messages::L2ToL1Message message;
+    message.set_message_id("L2_42");
+    message.set_target_node_id("gimbal_1");
+    publisher.publish("l2_to_l1", message);
+    publisher.flush();
+
+    ASSERT_EQ(payloads.size(), 1u);
+    messages::L2ToL1Message parsed;
+    ASSERT_TRUE(parsed.ParseFromString(payloads[0]));
+    EXPECT_EQ(parsed.message_id(), "L2_42");
+    EXPECT_EQ(parsed.target_node_id(), "gimbal_1");
+}
+
+/**
+ * @brief A failing flush drops its batch and the publisher keeps going
+ */
+TEST_F(PipelinedPublisherTest, SurvivesFlushFailure) {
+    std::atomic<int> calls{0};
+    PipelinedPublisher publisher([&calls](std::span<const OutboundMessage>) {
+        if (calls++ == 0) {
+            throw std::runtime_error("connection refused");
+        }
+    });
+
+    publisher.publish_raw("out", "lost");
+    publisher.flush();
+    publisher.publish_raw("out", "sent");
+    publisher.flush();
+
+    auto stats = publisher.get_stats();
+    EXPECT_EQ(stats.batches, 2u);
+    EXPECT_EQ(stats.failed_batches, 1u);
+    EXPECT_EQ(stats.messages_dropped, 1u);
+    EXPECT_EQ(stats.messages_published, 1u);
+}
+
+/**
+ * @brief DropNewest rejects messages while the queue is full
+ */
+TEST_F(PipelinedPublisherTest, DropNewestWhenFull) {
+    std::mutex gate;
+    std::unique_lock hold(gate);
+    std::atomic<bool> flushing{false};
+    PipelinedPublisher publisher(
+        [&](std::span<const OutboundMessage>) {
+            flushing = true;
+            std::lock_guard wait(gate);
+        },
+        {.max_batch = 1, .max_delay = std::chrono::microseconds(0),
+         .queue_capacity = 2, .overflow = OverflowPolicy::DropNewest});
+
+    // The first message is taken by the stalled flusher, the next two fill the queue
+    publisher.publish_raw("out", "0");
+    while (!flushing) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(publisher.publish_raw("out", "1"));
+    EXPECT_TRUE(publisher.publish_raw("out", "2"));
+    EXPECT_FALSE(publisher.publish_raw("out", "3"));
+
+    hold.unlock();
+    publisher.flush();
+    auto stats = publisher.get_stats();
+    EXPECT_EQ(stats.messages_published, 3u);
+    EXPECT_EQ(stats.messages_dropped, 1u);
+}
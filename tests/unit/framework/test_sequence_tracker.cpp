@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "sequence_tracker.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2::core;
+
+/**
+ * @brief Consecutive numbers are in order, per node
+ */
+TEST(SequenceTrackerTest, TracksNodesIndependently) {
+    SequenceTracker tracker;
+    EXPECT_EQ(tracker.observe("radar_001", 5), SequenceVerdict::InOrder);
+    EXPECT_EQ(tracker.observe("radar_002", 100), SequenceVerdict::InOrder);
+    EXPECT_EQ(tracker.observe("radar_001", 6), SequenceVerdict::InOrder);
+    EXPECT_EQ(tracker.observe("radar_002", 101), SequenceVerdict::InOrder);
+    EXPECT_EQ(tracker.observe("radar_001", 0), SequenceVerdict::Untracked);
+
+    auto stats = tracker.stats();
+    EXPECT_EQ(stats.gaps + stats.duplicates + stats.late + stats.restarts, 0u);
+}
+
+/**
+ * @brief Skipped numbers count as missing until they arrive late
+ */
+TEST(SequenceTrackerTest, CountsGapsAndLateArrivals) {
+    SequenceTracker tracker;
+    tracker.observe("radar_001", 1);
+    EXPECT_EQ(tracker.observe("radar_001", 5), SequenceVerdict::Gap);
+    EXPECT_EQ(tracker.stats().gaps, 1u);
+    EXPECT_EQ(tracker.stats().missing, 3u);
+
+    EXPECT_EQ(tracker.observe("radar_001", 3), SequenceVerdict::Late);
+    EXPECT_EQ(tracker.observe("radar_001", 3), SequenceVerdict::Duplicate);
+    EXPECT_EQ(tracker.observe("radar_001", 5), SequenceVerdict::Duplicate);
+    EXPECT_EQ(tracker.observe("radar_001", 1), SequenceVerdict::Duplicate);
+
+    auto stats = tracker.stats();
+    EXPECT_EQ(stats.missing, 2u);
+    EXPECT_EQ(stats.late, 1u);
+    EXPECT_EQ(stats.duplicates, 3u);
+}
+
+/**
+ * @brief Missing numbers within the window are late, anything older a restart
+ */
+TEST(SequenceTrackerTest, DetectsRestartedSender) {
+    SequenceTracker tracker;
+    tracker.observe("lidar_001", 1000);
+    tracker.observe("lidar_001", 1010);
+    EXPECT_EQ(tracker.observe("lidar_001", 1001), SequenceVerdict::Late);
+    EXPECT_EQ(tracker.observe("lidar_001", 1010 - SequenceTracker::kWindow), SequenceVerdict::Restarted);
+    EXPECT_EQ(tracker.observe("lidar_001", 1), SequenceVerdict::Restarted);
+    EXPECT_EQ(tracker.observe("lidar_001", 2), SequenceVerdict::InOrder);
+    EXPECT_EQ(tracker.stats().restarts, 2u);
+}
+
+/**
+ * @brief A jump past the window forgets what was missing before it
+ */
+TEST(SequenceTrackerTest, LongGapMovesWindow) {
+    SequenceTracker tracker;
+    tracker.observe("imu_001", 10);
+    EXPECT_EQ(tracker.observe("imu_001", 210), SequenceVerdict::Gap);
+    EXPECT_EQ(tracker.stats().missing, 199u);
+    EXPECT_EQ(tracker.observe("imu_001", 209), SequenceVerdict::Late);
+    EXPECT_EQ(tracker.observe("imu_001", 150), SequenceVerdict::Late);
+    EXPECT_EQ(tracker.stats().missing, 197u);
+}
+
+/**
+ * @brief Nodes observed from several threads are each counted exactly
+ */
+TEST(SequenceTrackerTest, ConcurrentNodes) {
+    SequenceTracker tracker;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&tracker, t] {
+            const std::string node = "node_" + std::to_string(t);
+            for (int32_t sequence = 1; sequence <= 10000; ++sequence) {
+                // Every 100th message is lost
+                if (sequence % 100 != 0) {
+                    tracker.observe(node, sequence);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(tracker.stats().gaps, 4u * 99u);
+    EXPECT_EQ(tracker.stats().missing, 4u * 99u);
+    EXPECT_EQ(tracker.stats().duplicates, 0u);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "slab_pool.h"
+#include <string>
+#include <vector>
+
+using namespace dp_aero_l2::core;
+
+/**
+ * @brief Erased slots are reused, and handles to the erased object stop resolving
+ */
+TEST(SlabPoolTest, ReusedSlotsInvalidateOldHandles) {
+    SlabPool<std::string, 4> pool;
+    const auto first = pool.emplace("first");
+    const auto second = pool.emplace("second");
+    ASSERT_NE(pool.get(first), nullptr);
+    EXPECT_EQ(*pool.get(first), "first");
+    EXPECT_EQ(pool.size(), 2u);
+
+    EXPECT_TRUE(pool.erase(first));
+    EXPECT_FALSE(pool.erase(first));
+    EXPECT_EQ(pool.get(first), nullptr);
+
+    const auto next = pool.next_handle();
+    const auto third = pool.emplace("third");
+    EXPECT_EQ(third, next);
+    EXPECT_EQ(third.index, first.index);
+    EXPECT_NE(third, first);
+    EXPECT_EQ(pool.get(first), nullptr);
+    EXPECT_EQ(*pool.get(third), "third");
+    EXPECT_EQ(*pool.get(second), "second");
+    EXPECT_EQ(pool.get(SlabPool<std::string, 4>::Handle{}), nullptr);
+    EXPECT_EQ(pool.capacity(), 2u);
+}
+
+/**
+ * @brief Objects keep their address while the pool grows past a chunk
+ */
+TEST(SlabPoolTest, ObjectsDoNotMoveAsPoolGrows) {
+    SlabPool<int, 4> pool;
+    const auto handle = pool.emplace(7);
+    const int* address = pool.get(handle);
+    EXPECT_EQ(pool.next_handle().index, 1u);
+    for (int i = 0; i < 20; ++i) {
+        pool.emplace(i);
+    }
+    EXPECT_EQ(pool.get(handle), address);
+    EXPECT_EQ(pool.capacity(), 21u);
+}
+
+/**
+ * @brief for_each visits live objects in slot order; clear() invalidates everything
+ */
+TEST(SlabPoolTest, IteratesAndClears) {
+    SlabPool<int, 4> pool;
+    std::vector<SlabPool<int, 4>::Handle> handles;
+    for (int i = 0; i < 6; ++i) {
+        handles.push_back(pool.emplace(i));
+    }
+    pool.erase(handles[1]);
+    pool.erase(handles[4]);
+
+    std::vector<int> values;
+    pool.for_each([&](auto handle, int value) {
+        EXPECT_EQ(pool.handle_at(handle.index), handle);
+        values.push_back(value);
+    });
+    EXPECT_EQ(values, (std::vector<int>{0, 2, 3, 5}));
+    EXPECT_FALSE(pool.handle_at(1).valid());
+
+    pool.clear();
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.get(handles[0]), nullptr);
+}
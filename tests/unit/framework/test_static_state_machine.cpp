@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "algorithm_framework.h"
+#include "static_state_machine.h"
+#include "task_manager.h"
+#include <string>
+#include <vector>
+
+using namespace dp_aero_l2::fusion;
+
+namespace {
+
+struct DoorStates {
+    enum class State : uint8_t { CLOSED, OPEN, LOCKED, Count };
+    enum class Trigger : uint8_t { OPEN, CLOSE, LOCK, UNLOCK, Count };
+
+    static constexpr State initial = State::CLOSED;
+    static constexpr std::array<std::string_view, 3> state_names = {"CLOSED", "OPEN", "LOCKED"};
+    static constexpr std::array<std::string_view, 4> trigger_names = {"open", "close", "lock", "unlock"};
+    static constexpr std::array<StaticTransition<State, Trigger>, 4> transitions = {{
+        {State::CLOSED, Trigger::OPEN, State::OPEN},
+        {State::OPEN, Trigger::CLOSE, State::CLOSED},
+        {State::CLOSED, Trigger::LOCK, State::LOCKED},
+        {State::LOCKED, Trigger::UNLOCK, State::CLOSED},
+    }};
+};
+
+using Door = StaticStateMachine<DoorStates>;
+using DoorState = DoorStates::State;
+using DoorTrigger = DoorStates::Trigger;
+
+// Records the hooks run, with the argument passed through fire()
+struct RecordingHooks {
+    std::vector<std::string> calls;
+    bool allow_unlock = true;
+
+    bool allow(DoorState, DoorTrigger trigger, int) { return trigger != DoorTrigger::UNLOCK || allow_unlock; }
+    void on_exit(DoorState state, int) { calls.push_back("exit " + std::string(Door::name(state))); }
+    void on_transition(DoorState, DoorTrigger trigger, DoorState, int) { calls.push_back("via " + std::string(Door::name(trigger))); }
+    void on_enter(DoorState state, int code) { calls.push_back("enter " + std::string(Door::name(state)) + " " + std::to_string(code)); }
+    void on_update(DoorState state, int) { calls.push_back("update " + std::string(Door::name(state))); }
+};
+
+} // namespace
+
+/**
+ * @brief The transition table is built at compile time and holds no state
+ */
+TEST(StaticStateMachineTest, TableIsCompileTime) {
+    static_assert(Door::next_state(DoorState::CLOSED, DoorTrigger::OPEN) == DoorState::OPEN);
+    static_assert(!Door::next_state(DoorState::OPEN, DoorTrigger::LOCK));
+    static_assert(Door::parse_trigger("unlock") == DoorTrigger::UNLOCK);
+    static_assert(sizeof(Door) == sizeof(DoorState));
+
+    EXPECT_FALSE(Door::parse_trigger("kick"));
+}
+
+/**
+ * @brief Triggers follow the table; triggers without a transition are refused
+ */
+TEST(StaticStateMachineTest, FiresTransitions) {
+    Door door;
+    EXPECT_EQ(door.state(), DoorState::CLOSED);
+
+    EXPECT_FALSE(door.fire(DoorTrigger::CLOSE));
+    EXPECT_TRUE(door.fire(DoorTrigger::OPEN));
+    EXPECT_EQ(door.state_name(), "OPEN");
+    EXPECT_FALSE(door.fire(DoorTrigger::LOCK));
+    EXPECT_TRUE(door.fire(DoorTrigger::CLOSE));
+    EXPECT_TRUE(door.fire(DoorTrigger::LOCK));
+    EXPECT_EQ(door.state(), DoorState::LOCKED);
+
+    door.reset();
+    EXPECT_EQ(door.state(), DoorState::CLOSED);
+}
+
+/**
+ * @brief Hooks run in exit, transition, enter order, and the guard can refuse
+ */
+TEST(StaticStateMachineTest, RunsHooksAndGuard) {
+    Door door;
+    RecordingHooks hooks;
+
+    EXPECT_TRUE(door.fire(DoorTrigger::LOCK, hooks, 7));
+    EXPECT_EQ(hooks.calls, (std::vector<std::string>{"exit CLOSED", "via lock", "enter LOCKED 7"}));
+
+    hooks.calls.clear();
+    hooks.allow_unlock = false;
+    EXPECT_FALSE(door.fire(DoorTrigger::UNLOCK, hooks, 1));
+    EXPECT_TRUE(hooks.calls.empty());
+    EXPECT_EQ(door.state(), DoorState::LOCKED);
+
+    door.update(hooks, 0);
+    EXPECT_EQ(hooks.calls, std::vector<std::string>{"update LOCKED"});
+}
+
+/**
+ * @brief Tasks run the default lifecycle without a per-task machine on the heap
+ */
+TEST(StaticStateMachineTest, TaskLifecycle) {
+    Task task("task_1", "target_1", Task::Type::TRACK_TARGET);
+    AlgorithmContext context;
+    EXPECT_EQ(task.get_state_machine().state_name(), "INITIALIZING");
+
+    EXPECT_FALSE(task.trigger_state_transition(context, "complete"));
+    EXPECT_FALSE(task.trigger_state_transition(context, "no_such_trigger"));
+    EXPECT_TRUE(task.trigger_state_transition(context, "start"));
+    EXPECT_TRUE(task.trigger_state_transition(TaskLifecycle::Trigger::ERROR));
+    EXPECT_TRUE(task.trigger_state_transition(context, "retry"));
+    EXPECT_EQ(task.get_state_machine().state(), TaskLifecycle::State::INITIALIZING);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "symbol_table.h"
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2::core;
+
+namespace {
+
+struct TestTag {};
+
+} // namespace
+
+/**
+ * @brief Interning hands out dense handles and maps them back to names
+ */
+TEST(SymbolTableTest, InternsNamesToDenseHandles) {
+    SymbolTable<TestTag> table;
+    const auto radar = table.intern("radar_001");
+    const auto lidar = table.intern("lidar_001");
+
+    EXPECT_EQ(radar.id, 0u);
+    EXPECT_EQ(lidar.id, 1u);
+    EXPECT_EQ(table.intern("radar_001"), radar);
+    EXPECT_EQ(table.size(), 2u);
+
+    EXPECT_EQ(table.name(radar), "radar_001");
+    EXPECT_EQ(table.name(lidar), "lidar_001");
+    EXPECT_EQ(table.name(Symbol<TestTag>{}), "");
+}
+
+/**
+ * @brief find() does not intern unknown names
+ */
+TEST(SymbolTableTest, FindDoesNotIntern) {
+    SymbolTable<TestTag> table;
+    table.intern("radar_001");
+
+    EXPECT_TRUE(table.find("radar_001").valid());
+    EXPECT_FALSE(table.find("camera_001"));
+    EXPECT_EQ(table.size(), 1u);
+}
+
+/**
+ * @brief Threads interning the same names agree on their handles
+ */
+TEST(SymbolTableTest, ConcurrentInterning) {
+    SymbolTable<TestTag> table;
+    constexpr int kThreads = 4;
+    constexpr int kNames = 2000;
+    std::vector<std::vector<Symbol<TestTag>>> seen(kThreads);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kNames; ++i) {
+                seen[t].push_back(table.intern("node_" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(table.size(), static_cast<size_t>(kNames));
+    for (int t = 1; t < kThreads; ++t) {
+        EXPECT_EQ(seen[t], seen[0]);
+    }
+    std::set<uint32_t> ids;
+    for (int i = 0; i < kNames; ++i) {
+        EXPECT_EQ(table.name(seen[0][i]), "node_" + std::to_string(i));
+        ids.insert(seen[0][i].id);
+    }
+    EXPECT_EQ(*ids.rbegin(), static_cast<uint32_t>(kNames - 1));
+}
+
+/**
+ * @brief SymbolMap inserts, finds and erases by handle
+ */
+TEST(SymbolMapTest, InsertFindErase) {
+    SymbolMap<TestTag, int> map;
+    const Symbol<TestTag> first{3};
+    const Symbol<TestTag> second{7};
+
+    map[first] = 30;
+    map[second] = 70;
+    EXPECT_EQ(map.size(), 2u);
+    ASSERT_NE(map.find(first), nullptr);
+    EXPECT_EQ(*map.find(first), 30);
+    EXPECT_FALSE(map.contains(Symbol<TestTag>{5}));
+    EXPECT_FALSE(map.contains(Symbol<TestTag>{}));
+
+    EXPECT_TRUE(map.erase(first));
+    EXPECT_FALSE(map.erase(first));
+    EXPECT_EQ(map.size(), 1u);
+
+    map[first] = 31;
+    EXPECT_EQ(map.erase_if([](Symbol<TestTag>, int value) { return value > 50; }), 1u);
+    std::vector<uint32_t> keys;
+    map.for_each([&](Symbol<TestTag> key, int) { keys.push_back(key.id); });
+    EXPECT_EQ(keys, std::vector<uint32_t>{3});
+}
+
+/**
+ * @brief SmallSymbolMap keeps one entry per handle
+ */
+TEST(SmallSymbolMapTest, CountsPerSymbol) {
+    SmallSymbolMap<TestTag, int> map;
+    const Symbol<TestTag> radar{0};
+    const Symbol<TestTag> lidar{1};
+
+    map[radar]++;
+    map[radar]++;
+    map[lidar]++;
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map.at(radar), 2);
+    EXPECT_EQ(map.count(lidar), 1u);
+    EXPECT_THROW(map.at(Symbol<TestTag>{2}), std::out_of_range);
+
+    EXPECT_EQ(map.erase(radar), 1u);
+    EXPECT_EQ(map.erase(radar), 0u);
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_EQ(map.begin()->first, lidar);
+}
@@ -146,4 +146,78 @@ TEST_F(TaskManagerTest, ManagesTaskPriority) {
     
     task.set_priority(Task::Priority::LOW);
     EXPECT_EQ(task.get_priority(), Task::Priority::LOW);
+}
+
+/**
+ * @brief An id of a removed task does not resolve to the task reusing its slot
+ */
+TEST_F(TaskManagerTest, RemovedTaskIdDoesNotResolveAfterSlotReuse) {
+    const std::string first = task_manager->create_task("target_001", Task::Type::TRACK_TARGET);
+    ASSERT_TRUE(task_manager->remove_task(first));
+    
+    const std::string second = task_manager->create_task("target_002", Task::Type::TRACK_TARGET);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(task_manager->get_task(first), nullptr);
+    EXPECT_FALSE(task_manager->remove_task(first));
+    ASSERT_NE(task_manager->get_task(second), nullptr);
+    EXPECT_EQ(task_manager->get_task(second)->get_target_id(), "target_002");
+    EXPECT_EQ(task_manager->get_task("task_x"), nullptr);
+    EXPECT_EQ(task_manager->get_task("task_0"), nullptr);
+    EXPECT_EQ(task_manager->get_task(second + "0"), nullptr);
+}
+
+/**
+ * @brief Removing a task unlinks it from its target's and its device's lists
+ */
+TEST_F(TaskManagerTest, RemoveTaskUnlinksTargetAndDeviceLists) {
+    std::vector<std::string> ids;
+    for (int i = 0; i < 3; ++i) {
+        ids.push_back(task_manager->create_task("target_001", Task::Type::TRACK_TARGET));
+        task_manager->assign_task_to_device(ids.back(), "radar_001");
+    }
+    
+    ASSERT_TRUE(task_manager->remove_task(ids[1]));
+    auto target_tasks = task_manager->get_tasks_for_target("target_001");
+    ASSERT_EQ(target_tasks.size(), 2u);
+    EXPECT_EQ(target_tasks[0]->get_task_id(), ids[0]);
+    EXPECT_EQ(target_tasks[1]->get_task_id(), ids[2]);
+    EXPECT_EQ(task_manager->get_tasks_for_device("radar_001").size(), 2u);
+    
+    // Moving a task to another device takes it off the first one's list
+    task_manager->assign_task_to_device(ids[0], "lidar_001");
+    auto radar_tasks = task_manager->get_tasks_for_device("radar_001");
+    ASSERT_EQ(radar_tasks.size(), 1u);
+    EXPECT_EQ(radar_tasks[0]->get_task_id(), ids[2]);
+    
+    task_manager->remove_task(ids[0]);
+    task_manager->remove_task(ids[2]);
+    EXPECT_TRUE(task_manager->get_tasks_for_target("target_001").empty());
+    EXPECT_TRUE(task_manager->get_tasks_for_device("radar_001").empty());
+    EXPECT_FALSE(task_manager->get_primary_device_for_target("target_001").has_value());
+    EXPECT_EQ(task_manager->get_task_statistics().targets_with_assignments, 0u);
+}
+
+/**
+ * @brief Completed tasks are reclaimed once past the retention, a budget of slots at a time
+ */
+TEST_F(TaskManagerTest, ReclaimsCompletedTasksIncrementally) {
+    std::vector<std::string> ids;
+    for (int i = 0; i < 4; ++i) {
+        ids.push_back(task_manager->create_task("target_00" + std::to_string(i), Task::Type::TRACK_TARGET));
+    }
+    task_manager->get_task(ids[0])->set_status(Task::Status::COMPLETED);
+    task_manager->get_task(ids[3])->set_status(Task::Status::FAILED);
+    
+    // Still within the default retention
+    EXPECT_EQ(task_manager->reclaim_completed_tasks(), 0u);
+    
+    task_manager->set_completed_task_retention(std::chrono::seconds(0));
+    EXPECT_EQ(task_manager->reclaim_completed_tasks(2), 1u);
+    EXPECT_EQ(task_manager->get_task(ids[0]), nullptr);
+    EXPECT_NE(task_manager->get_task(ids[1]), nullptr);
+    EXPECT_NE(task_manager->get_task(ids[3]), nullptr);
+    
+    EXPECT_EQ(task_manager->reclaim_completed_tasks(2), 1u);
+    EXPECT_EQ(task_manager->get_task(ids[3]), nullptr);
+    EXPECT_EQ(task_manager->get_task_statistics().total_tasks, 2u);
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "algorithm_framework.h"
+#include "task_manager.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dp_aero_l2::fusion;
+
+namespace {
+
+// A two-step calibration flow recording which tasks entered DONE
+std::shared_ptr<const TaskStateMachineDefinition> make_calibration(std::vector<std::string>& finished) {
+    auto definition = std::make_shared<TaskStateMachineDefinition>();
+    definition->add_state("WAITING", std::make_shared<TaskState>("WAITING"));
+    definition->add_state("MEASURING", std::make_shared<TaskState>("MEASURING"));
+    auto done = std::make_shared<TaskState>("DONE");
+    done->on_enter = [&finished](AlgorithmContext&, const std::string& task_id) { finished.push_back(task_id); };
+    definition->add_state("DONE", done);
+    definition->add_transition(TaskTransition("WAITING", "MEASURING", "begin"));
+    definition->add_transition(TaskTransition("MEASURING", "DONE", "finish"));
+    return definition;
+}
+
+} // namespace
+
+/**
+ * @brief Tasks share one definition but keep their own current state
+ */
+TEST(TaskStateMachineTest, TasksShareDefinition) {
+    std::vector<std::string> finished;
+    auto definition = make_calibration(finished);
+    AlgorithmContext context;
+
+    Task first("task_1", "target_1", Task::Type::CALIBRATE_SENSOR, Task::Priority::NORMAL, definition);
+    Task second("task_2", "target_1", Task::Type::CALIBRATE_SENSOR, Task::Priority::NORMAL, definition);
+    ASSERT_NE(first.get_custom_state_machine(), nullptr);
+    EXPECT_EQ(&first.get_custom_state_machine()->get_definition(), &second.get_custom_state_machine()->get_definition());
+
+    EXPECT_TRUE(first.trigger_state_transition(context, "begin"));
+    EXPECT_FALSE(first.trigger_state_transition(context, "begin"));
+    EXPECT_TRUE(first.trigger_state_transition(context, "finish"));
+    EXPECT_EQ(first.get_state_name(), "DONE");
+    EXPECT_EQ(second.get_state_name(), "WAITING");
+    EXPECT_EQ(finished, std::vector<std::string>{"task_1"});
+
+    // The default lifecycle's triggers do not apply
+    EXPECT_FALSE(second.trigger_state_transition(context, "start"));
+    EXPECT_FALSE(second.trigger_state_transition(TaskLifecycle::Trigger::START));
+}
+
+/**
+ * @brief Definitions reject duplicate states and transitions to unknown ones
+ */
+TEST(TaskStateMachineTest, DefinitionValidatesStates) {
+    TaskStateMachineDefinition definition;
+    definition.add_state("A", std::make_shared<TaskState>("A"));
+    definition.add_state("B", std::make_shared<TaskState>("B"));
+    definition.set_initial_state("B");
+
+    EXPECT_THROW(definition.add_state("A", std::make_shared<TaskState>("A")), std::invalid_argument);
+    EXPECT_THROW(definition.add_transition(TaskTransition("A", "C", "go")), std::invalid_argument);
+    EXPECT_THROW(definition.set_initial_state("C"), std::invalid_argument);
+    EXPECT_EQ(definition.get_initial_state(), *definition.find_state("B"));
+    EXPECT_EQ(TaskStateMachine(std::make_shared<TaskStateMachineDefinition>(definition)).get_current_state(), "B");
+}
+
+/**
+ * @brief TaskManager hands each task its type's definition
+ */
+TEST(TaskStateMachineTest, ManagerUsesDefinitionPerType) {
+    std::vector<std::string> finished;
+    TaskManager manager;
+    manager.set_task_definition(Task::Type::CALIBRATE_SENSOR, make_calibration(finished));
+
+    const auto calibration = manager.create_task("target_1", Task::Type::CALIBRATE_SENSOR);
+    const auto tracking = manager.create_task("target_1", Task::Type::TRACK_TARGET);
+
+    EXPECT_EQ(manager.get_task(calibration)->get_state_name(), "WAITING");
+    EXPECT_EQ(manager.get_task(tracking)->get_custom_state_machine(), nullptr);
+    EXPECT_EQ(manager.get_task(tracking)->get_state_name(), "INITIALIZING");
+}
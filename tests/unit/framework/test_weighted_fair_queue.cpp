@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "weighted_fair_queue.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace dp_aero_l2::core;
+
+/**
+ * @brief Test fixture for WeightedFairQueue
+ */
+class WeightedFairQueueTest : public ::testing::Test {
+protected:
+    // Items are tagged with their class times 1000
+    static void fill(WeightedFairQueue<int>& queue, size_t class_index, int count) {
+        for (int i = 0; i < count; ++i) {
+            queue.push(class_index, static_cast<int>(class_index) * 1000 + i);
+        }
+    }
+
+    static size_t count_class(const std::vector<int>& items, int class_index) {
+        return static_cast<size_t>(std::count_if(items.begin(), items.end(),
+                                                 [class_index](int item) { return item / 1000 == class_index; }));
+    }
+};
+
+/**
+ * @brief Backlogged classes are dequeued in proportion to their weights, interleaved
+ */
+TEST_F(WeightedFairQueueTest, DequeuesByWeight) {
+    WeightedFairQueue<int> queue({{"radar", 100, OverflowPolicy::DropOldest, 3},
+                                  {"lidar", 100, OverflowPolicy::DropOldest, 1}});
+    fill(queue, 0, 100);
+    fill(queue, 1, 100);
+
+    std::vector<int> items;
+    ASSERT_EQ(queue.try_pop_batch(items, 40), 40u);
+    EXPECT_EQ(count_class(items, 0), 30u);
+    EXPECT_EQ(count_class(items, 1), 10u);
+
+    // No class gets a run longer than its weight
+    size_t run = 0;
+    for (size_t i = 0; i < items.size(); ++i) {
+        run = (i > 0 && items[i] / 1000 == items[i - 1] / 1000) ? run + 1 : 1;
+        EXPECT_LE(run, 3u);
+    }
+
+    // Each class stays in FIFO order
+    int next[2] = {0, 1000};
+    for (int item : items) {
+        EXPECT_EQ(item, next[item / 1000]++);
+    }
+}
+
+/**
+ * @brief An empty class does not hold back the others
+ */
+TEST_F(WeightedFairQueueTest, SkipsEmptyClasses) {
+    WeightedFairQueue<int> queue({{"radar", 10, OverflowPolicy::DropOldest, 8},
+                                  {"lidar", 10, OverflowPolicy::DropOldest, 1}});
+    fill(queue, 1, 5);
+
+    std::vector<int> items;
+    EXPECT_EQ(queue.try_pop_batch(items, 10), 5u);
+    EXPECT_EQ(count_class(items, 1), 5u);
+    EXPECT_EQ(queue.try_pop_batch(items, 10), 0u);
+}
+
+/**
+ * @brief Overflow in one class drops only that class's items
+ */
+TEST_F(WeightedFairQueueTest, OverflowStaysWithinClass) {
+    WeightedFairQueue<int> queue({{"radar", 4, OverflowPolicy::DropOldest, 1},
+                                  {"lidar", 4, OverflowPolicy::DropOldest, 1},
+                                  {"bulk", 2, OverflowPolicy::DropNewest, 1}});
+    fill(queue, 0, 3);
+    fill(queue, 1, 50);
+    EXPECT_EQ(queue.push(2, 2000), PushResult::Enqueued);
+    EXPECT_EQ(queue.push(2, 2001), PushResult::Enqueued);
+    EXPECT_EQ(queue.push(2, 2002), PushResult::DroppedNewest);
+
+    auto stats = queue.class_stats();
+    ASSERT_EQ(stats.size(), 3u);
+    EXPECT_EQ(stats[0].name, "radar");
+    EXPECT_EQ(stats[0].depth, 3u);
+    EXPECT_EQ(stats[0].dropped, 0u);
+    EXPECT_EQ(stats[1].depth, 4u);
+    EXPECT_EQ(stats[1].dropped, 46u);
+    EXPECT_EQ(stats[2].dropped, 1u);
+    EXPECT_EQ(queue.dropped_count(), 47u);
+    EXPECT_EQ(queue.size_approx(), 9u);
+
+    std::vector<int> items;
+    queue.try_pop_batch(items, 100);
+    EXPECT_EQ(count_class(items, 0), 3u);
+    EXPECT_EQ(queue.class_stats()[0].dequeued, 3u);
+}
+
+/**
+ * @brief Invalid class layouts are rejected
+ */
+TEST_F(WeightedFairQueueTest, RejectsInvalidClasses) {
+    EXPECT_THROW(WeightedFairQueue<int>({}), std::invalid_argument);
+    EXPECT_THROW(WeightedFairQueue<int>({{"radar", 4, OverflowPolicy::DropOldest, 0}}), std::invalid_argument);
+    EXPECT_THROW(WeightedFairQueue<int>({{"radar", 1}}), std::invalid_argument);
+}
+
+/**
+ * @brief A consumer waiting on all classes wakes for a push to any of them, and on close
+ */
+TEST_F(WeightedFairQueueTest, WaitWakesOnAnyClass) {
+    WeightedFairQueue<int> queue({{"radar", 4}, {"lidar", 4}});
+
+    std::vector<int> items;
+    std::thread consumer([&] {
+        queue.pop_batch_wait(items, 4);
+        std::vector<int> rest;
+        EXPECT_EQ(queue.pop_batch_wait(rest, 4), 0u);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.push(1, 1000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    consumer.join();
+
+    ASSERT_EQ(items.size(), 1u);
+    EXPECT_EQ(items[0], 1000);
+    EXPECT_EQ(queue.push(0, 1), PushResult::Closed);
+}
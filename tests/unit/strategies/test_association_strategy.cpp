@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "algorithm_strategies.h"
+#include "track_store.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
+
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+float total_cost(const GatedCandidates& candidates, const std::vector<Target*>& assignment, float miss_cost) {
+    float total = 0.0f;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (!assignment[i]) {
+            total += miss_cost;
+            continue;
+        }
+        for (const auto& [track, cost] : candidates[i]) {
+            if (track == assignment[i]) total += cost;
+        }
+    }
+    return total;
+}
+
+// Exhaustive minimum over all one-to-one assignments
+void brute_force(const GatedCandidates& candidates, float miss_cost, size_t i,
+                 std::set<Target*>& used, float cost, float& best) {
+    if (cost >= best) return;
+    if (i == candidates.size()) {
+        best = cost;
+        return;
+    }
+    brute_force(candidates, miss_cost, i + 1, used, cost + miss_cost, best);
+    for (const auto& [track, track_cost] : candidates[i]) {
+        if (track_cost < miss_cost && used.insert(track).second) {
+            brute_force(candidates, miss_cost, i + 1, used, cost + track_cost, best);
+            used.erase(track);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Test fixture for association strategies
+ */
+class AssociationStrategyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        global_ = std::make_unique<GlobalNearestNeighbourAssociation>();
+        greedy_ = std::make_unique<NearestNeighbourAssociation>();
+    }
+
+    GatedCandidates gate_all(const TrackStore& store,
+                             const std::vector<std::array<float, 3>>& measurements,
+                             float gate) {
+        GatedCandidates candidates(measurements.size());
+        for (size_t i = 0; i < measurements.size(); ++i) {
+            store.find_within(measurements[i][0], measurements[i][1], measurements[i][2],
+                              gate, candidates[i]);
+        }
+        return candidates;
+    }
+
+    std::unique_ptr<GlobalNearestNeighbourAssociation> global_;
+    std::unique_ptr<NearestNeighbourAssociation> greedy_;
+};
+
+/**
+ * @brief Two close detections must not both update the same track
+ */
+TEST_F(AssociationStrategyTest, ResolvesConflictingDetections) {
+    TrackStore store;
+    Target& a = store.create("a");
+    Target& b = store.create("b");
+    b.x = 3.0f;
+    store.relocate(b);
+
+    auto candidates = gate_all(store, {{1.0f, 0.0f, 0.0f}, {1.4f, 0.0f, 0.0f}}, 5.0f);
+
+    // Greedy sends both detections to track a
+    auto greedy = greedy_->associate(candidates, 25.0f);
+    EXPECT_EQ(greedy[0], &a);
+    EXPECT_EQ(greedy[1], &a);
+
+    // Global assignment splits them at minimum total cost
+    auto assignment = global_->associate(candidates, 25.0f);
+    EXPECT_EQ(assignment[0], &a);
+    EXPECT_EQ(assignment[1], &b);
+}
+
+/**
+ * @brief Surplus detections in a cluster are left for new tracks
+ */
+TEST_F(AssociationStrategyTest, LeavesSurplusDetectionsUnassigned) {
+    TrackStore store;
+    Target& only = store.create("only");
+
+    auto candidates = gate_all(store, {{0.5f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {0.0f, 3.0f, 0.0f}}, 5.0f);
+    auto assignment = global_->associate(candidates, 25.0f);
+
+    ASSERT_EQ(assignment.size(), 3u);
+    EXPECT_EQ(assignment[0], &only);
+    EXPECT_EQ(assignment[1], nullptr);
+    EXPECT_EQ(assignment[2], nullptr);
+}
+
+/**
+ * @brief Candidates at or above the miss cost are never assigned
+ */
+TEST_F(AssociationStrategyTest, RespectsMissCost) {
+    Target track("t");
+    GatedCandidates candidates = {{{&track, 9.0f}}};
+
+    EXPECT_EQ(global_->associate(candidates, 10.0f)[0], &track);
+    EXPECT_EQ(global_->associate(candidates, 9.0f)[0], nullptr);
+    EXPECT_EQ(greedy_->associate(candidates, 9.0f)[0], nullptr);
+}
+
+/**
+ * @brief Empty frames and frames without candidates
+ */
+TEST_F(AssociationStrategyTest, HandlesEmptyInput) {
+    EXPECT_TRUE(global_->associate({}, 25.0f).empty());
+
+    GatedCandidates ungated(4);
+    auto assignment = global_->associate(ungated, 25.0f);
+    ASSERT_EQ(assignment.size(), 4u);
+    EXPECT_TRUE(std::all_of(assignment.begin(), assignment.end(),
+                            [](Target* target) { return target == nullptr; }));
+}
+
+/**
+ * @brief Random small instances match the exhaustive optimum
+ */
+TEST_F(AssociationStrategyTest, MatchesBruteForceOptimum) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(0.0f, 8.0f);
+    const float gate = 4.0f;
+
+    for (int trial = 0; trial < 200; ++trial) {
+        TrackStore store;
+        for (int t = 0; t < 5; ++t) {
+            Target& target = store.create();
+            target.x = position(rng);
+            target.y = position(rng);
+            store.relocate(target);
+        }
+        std::vector<std::array<float, 3>> measurements;
+        for (int m = 0; m < 6; ++m) {
+            measurements.push_back({position(rng), position(rng), 0.0f});
+        }
+
+        auto candidates = gate_all(store, measurements, gate);
+        auto assignment = global_->associate(candidates, gate * gate);
+
+        // One-to-one
+        std::set<Target*> used;
+        for (Target* target : assignment) {
+            if (target) {
+                EXPECT_TRUE(used.insert(target).second) << "Track assigned twice in trial " << trial;
+            }
+        }
+
+        float best = std::numeric_limits<float>::infinity();
+        std::set<Target*> scratch;
+        brute_force(candidates, gate * gate, 0, scratch, 0.0f, best);
+        EXPECT_NEAR(total_cost(candidates, assignment, gate * gate), best, 1e-3f) << "Trial " << trial;
+    }
+}
+
+/**
+ * @brief Strategy names
+ */
+TEST_F(AssociationStrategyTest, ReturnsCorrectNames) {
+    EXPECT_EQ(global_->get_name(), "GlobalNearestNeighbourAssociation");
+    EXPECT_EQ(greedy_->get_name(), "NearestNeighbourAssociation");
+}
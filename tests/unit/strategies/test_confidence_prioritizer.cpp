@@ -116,6 +116,27 @@ TEST_F(ConfidenceBasedPrioritizerTest, HandlesEmptyTargetList) {
     EXPECT_TRUE(sorted.empty());
 }
 
+/**
+ * @brief Row selection over a TrackTable agrees with the pointer interface
+ */
+TEST_F(ConfidenceBasedPrioritizerTest, SelectsHighestPriorityRow) {
+    auto targets = TargetFactory::createTargetCluster();
+    
+    TrackTable table;
+    std::vector<Target*> target_pointers;
+    for (auto& target : targets) {
+        table.add(target);
+        target_pointers.push_back(&target);
+    }
+    
+    auto row = prioritizer->select_highest_priority_row(table, *context);
+    ASSERT_NE(row, TrackTable::npos);
+    EXPECT_EQ(table.id_of(row),
+              prioritizer->select_highest_priority_target(target_pointers, *context)->target_id);
+    
+    EXPECT_EQ(prioritizer->select_highest_priority_row(TrackTable{}, *context), TrackTable::npos);
+}
+
 /**
  * @brief Test with single target
  */
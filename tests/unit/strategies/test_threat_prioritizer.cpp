@@ -167,6 +167,29 @@ TEST_F(ThreatBasedPrioritizerTest, SelectsHighestThreatTarget) {
     }
 }
 
+/**
+ * @brief Row selection over a TrackTable scores tracks like calculate_priority
+ */
+TEST_F(ThreatBasedPrioritizerTest, SelectsHighestThreatRow) {
+    auto targets = TargetFactory::createTargetCluster();
+    
+    TrackTable table;
+    std::vector<Target*> target_pointers;
+    for (auto& target : targets) {
+        table.add(target);
+        target_pointers.push_back(&target);
+    }
+    
+    for (const auto* p : {prioritizer.get(), custom_prioritizer.get()}) {
+        auto row = p->select_highest_priority_row(table, *context);
+        ASSERT_NE(row, TrackTable::npos);
+        EXPECT_EQ(table.id_of(row),
+                  p->select_highest_priority_target(target_pointers, *context)->target_id);
+    }
+    
+    EXPECT_EQ(prioritizer->select_highest_priority_row(TrackTable{}, *context), TrackTable::npos);
+}
+
 /**
  * @brief Test custom threat parameters
  */
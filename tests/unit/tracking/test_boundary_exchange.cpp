@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "algorithms/target_tracking_algorithm.h"
+#include "messages/l1_to_l2.pb.h"
+#include "messages/l2_to_l2.pb.h"
+#include "partition_map.h"
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+constexpr float kSectorSize = 1000.0f;
+constexpr float kMargin = 50.0f;
+
+/**
+ * @brief One L2 partition: a tracking algorithm with its context and partition map
+ */
+struct Partition {
+    core::PartitionMap map;
+    TargetTrackingAlgorithm algorithm;
+    fusion::AlgorithmContext context;
+
+    Partition(size_t index, core::PartitionScheme scheme)
+        : map(2, index, scheme, kSectorSize, kMargin) {
+        algorithm.initialize(context);
+    }
+
+    void observe(float x, float y, int frames = 3) {
+        messages::L1ToL2Message message;
+        message.mutable_sender()->set_node_id("radar_" + std::to_string(map.index()));
+        auto* detection = message.mutable_sensor_data()->mutable_radar()->add_detections();
+        detection->set_range(std::sqrt(x * x + y * y));
+        detection->set_azimuth(std::atan2(y, x));
+        detection->set_rcs(1.0f);
+        for (int i = 0; i < frames; ++i) {
+            algorithm.process_l1_message(context, message);
+        }
+    }
+
+    messages::TrackExchange export_tracks() {
+        messages::TrackExchange exchange;
+        exchange.set_partition(static_cast<uint32_t>(map.index()));
+        exchange.set_partition_count(static_cast<uint32_t>(map.count()));
+        algorithm.export_boundary_tracks(context, map, exchange);
+        return exchange;
+    }
+
+    void merge(const messages::TrackExchange& exchange) {
+        algorithm.merge_peer_tracks(context, map, exchange);
+    }
+
+    const ShardedTrackStore& tracks() {
+        return *context.get_data_ptr<ShardedTrackStore>("targets");
+    }
+
+    // Tracks this partition reports as its own
+    size_t owned_tracks() {
+        const auto now = std::chrono::steady_clock::now();
+        size_t owned = 0;
+        for (const auto& [id, target] : tracks()) {
+            owned += now >= target.peer_owned_until;
+        }
+        return owned;
+    }
+};
+
+// x coordinate of a vertical sector border at y = 500 between the two partitions
+float foreign_border(const core::PartitionMap& map) {
+    for (int sector = 1; sector < 100; ++sector) {
+        const float border = kSectorSize * sector;
+        if (map.partition_of_position(border - 1.0f, 500.0f) != map.partition_of_position(border + 1.0f, 500.0f)) {
+            return border;
+        }
+    }
+    ADD_FAILURE() << "No border between partitions found";
+    return 0.0f;
+}
+
+} // namespace
+
+/**
+ * @brief A track both partitions hold is kept by the owner of its sector only
+ */
+TEST(BoundaryExchangeTest, DuplicateIsHandedToSectorOwner) {
+    Partition first(0, core::PartitionScheme::Sector);
+    Partition second(1, core::PartitionScheme::Sector);
+    const float x = foreign_border(first.map) + 10.0f;
+    const size_t owner = first.map.partition_of_position(x, 500.0f);
+
+    first.observe(x, 500.0f);
+    second.observe(x, 500.0f);
+    ASSERT_EQ(first.export_tracks().tracks_size(), 1);
+    ASSERT_EQ(second.export_tracks().tracks_size(), 1);
+
+    second.merge(first.export_tracks());
+    first.merge(second.export_tracks());
+
+    Partition& keeper = owner == 0 ? first : second;
+    Partition& other = owner == 0 ? second : first;
+    EXPECT_EQ(keeper.owned_tracks(), 1u);
+    EXPECT_EQ(other.owned_tracks(), 0u);
+    EXPECT_EQ(other.tracks().size(), 1u);  // Still updated, just not reported
+
+    // Only the owner keeps exporting it
+    EXPECT_EQ(keeper.export_tracks().tracks_size(), 1);
+    EXPECT_EQ(other.export_tracks().tracks_size(), 0);
+}
+
+/**
+ * @brief A peer's track entering this partition's sector is adopted with its state
+ */
+TEST(BoundaryExchangeTest, AdoptsTrackEnteringOwnSector) {
+    Partition first(0, core::PartitionScheme::Sector);
+    Partition second(1, core::PartitionScheme::Sector);
+    const float border = foreign_border(first.map);
+
+    // Seen only by the partition owning the near side, just across the border
+    const bool left_is_first = first.map.partition_of_position(border - 1.0f, 500.0f) == 0;
+    Partition& seer = left_is_first ? first : second;
+    Partition& receiver = left_is_first ? second : first;
+    const float x = border + 5.0f;
+    seer.observe(x, 500.0f);
+
+    auto exchange = seer.export_tracks();
+    ASSERT_EQ(exchange.tracks_size(), 1);
+    receiver.merge(exchange);
+
+    ASSERT_EQ(receiver.tracks().size(), 1u);
+    const auto& adopted = receiver.tracks().begin()->second;
+    EXPECT_NEAR(adopted.x, exchange.tracks(0).x(), 1e-3f);
+    EXPECT_FLOAT_EQ(adopted.confidence, exchange.tracks(0).confidence());
+    EXPECT_EQ(adopted.sensor_detections.count(core::intern_node("radar_" + std::to_string(seer.map.index()))), 1u);
+
+    // The adopting partition now owns it, so the original copy is handed over
+    seer.merge(receiver.export_tracks());
+    EXPECT_EQ(seer.owned_tracks(), 0u);
+    EXPECT_EQ(receiver.owned_tracks(), 1u);
+}
+
+/**
+ * @brief Peer tracks with non-finite state are ignored
+ */
+TEST(BoundaryExchangeTest, IgnoresNonFinitePeerTracks) {
+    Partition first(0, core::PartitionScheme::Sector);
+    Partition second(1, core::PartitionScheme::Sector);
+    const float border = foreign_border(first.map);
+    const bool left_is_first = first.map.partition_of_position(border - 1.0f, 500.0f) == 0;
+    Partition& seer = left_is_first ? first : second;
+    Partition& receiver = left_is_first ? second : first;
+    seer.observe(border + 5.0f, 500.0f);
+
+    auto exchange = seer.export_tracks();
+    ASSERT_EQ(exchange.tracks_size(), 1);
+    *exchange.add_tracks() = exchange.tracks(0);
+    *exchange.add_tracks() = exchange.tracks(0);
+    exchange.mutable_tracks(0)->set_x(std::numeric_limits<float>::quiet_NaN());
+    exchange.mutable_tracks(1)->set_vy(std::numeric_limits<float>::infinity());
+    receiver.merge(exchange);
+
+    ASSERT_EQ(receiver.tracks().size(), 1u);
+    EXPECT_TRUE(std::isfinite(receiver.tracks().begin()->second.x));
+}
+
+/**
+ * @brief With node partitions every track is shared, the lower index keeps duplicates and nothing is adopted
+ */
+TEST(BoundaryExchangeTest, NodeSchemeKeepsLowerIndex) {
+    Partition first(0, core::PartitionScheme::Node);
+    Partition second(1, core::PartitionScheme::Node);
+
+    first.observe(120.0f, 80.0f);
+    second.observe(120.0f, 80.0f);
+    second.observe(-300.0f, 40.0f);  // Only the second partition's nodes see this one
+
+    first.merge(second.export_tracks());
+    second.merge(first.export_tracks());
+
+    EXPECT_EQ(first.tracks().size(), 1u);
+    EXPECT_EQ(first.owned_tracks(), 1u);
+    EXPECT_EQ(second.tracks().size(), 2u);
+    EXPECT_EQ(second.owned_tracks(), 1u);
+}
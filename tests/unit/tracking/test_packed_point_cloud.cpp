@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "packed_point_cloud.h"
+#include "algorithms/target_tracking_algorithm.h"
+#include "messages/l1_to_l2.pb.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::algorithms;
+
+/**
+ * @brief Test fixture for the packed lidar point encoding
+ */
+class PackedPointCloudTest : public ::testing::Test {
+protected:
+    // Three 40-point objects, encoded both ways into otherwise identical messages
+    void make_scans(messages::L1ToL2Message& repeated, messages::L1ToL2Message& packed) {
+        std::mt19937 rng(9);
+        std::normal_distribution<float> noise(0.0f, 0.3f);
+        repeated.mutable_sender()->set_node_id("lidar_test");
+        packed.mutable_sender()->set_node_id("lidar_test");
+        auto* repeated_lidar = repeated.mutable_sensor_data()->mutable_lidar();
+        auto* packed_lidar = packed.mutable_sensor_data()->mutable_lidar();
+
+        for (float center : {-30.0f, 0.0f, 30.0f}) {
+            for (int i = 0; i < 40; ++i) {
+                float x = center + noise(rng), y = 10.0f + noise(rng), z = noise(rng);
+                auto* point = repeated_lidar->add_points();
+                point->set_x(x);
+                point->set_y(y);
+                point->set_z(z);
+                point->set_intensity(0.5f);
+                packed_point_cloud::append_point(*packed_lidar->mutable_packed_points(), x, y, z, 0.5f);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Encoding is interleaved little-endian float32, 16 bytes per point
+ */
+TEST_F(PackedPointCloudTest, UsesDocumentedByteLayout) {
+    std::string packed;
+    packed_point_cloud::append_point(packed, 1.0f, -2.0f, 0.0f, 0.5f);
+
+    ASSERT_EQ(packed.size(), 16u);
+    EXPECT_EQ(packed_point_cloud::point_count(packed), 1u);
+
+    // 1.0f = 0x3F800000, -2.0f = 0xC0000000, 0.5f = 0x3F000000
+    const std::string expected("\x00\x00\x80\x3F" "\x00\x00\x00\xC0" "\x00\x00\x00\x00" "\x00\x00\x00\x3F", 16);
+    EXPECT_EQ(packed, expected);
+}
+
+/**
+ * @brief Decoding restores the flat x, y, z, intensity buffer
+ */
+TEST_F(PackedPointCloudTest, RoundTripsThroughProtobuf) {
+    data_streams::LidarData lidar;
+    for (int i = 0; i < 100; ++i) {
+        float f = static_cast<float>(i);
+        packed_point_cloud::append_point(*lidar.mutable_packed_points(), f, f * 2.0f, -f, 0.25f);
+    }
+
+    data_streams::LidarData parsed;
+    ASSERT_TRUE(parsed.ParseFromString(lidar.SerializeAsString()));
+
+    std::vector<float> points;
+    ASSERT_EQ(packed_point_cloud::unpack(parsed.packed_points(), points), 100u);
+    ASSERT_EQ(points.size(), 400u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_FLOAT_EQ(points[i * 4 + 0], static_cast<float>(i));
+        EXPECT_FLOAT_EQ(points[i * 4 + 1], static_cast<float>(i) * 2.0f);
+        EXPECT_FLOAT_EQ(points[i * 4 + 2], -static_cast<float>(i));
+        EXPECT_FLOAT_EQ(points[i * 4 + 3], 0.25f);
+    }
+}
+
+/**
+ * @brief Incomplete trailing points are ignored
+ */
+TEST_F(PackedPointCloudTest, IgnoresTrailingPartialPoint) {
+    std::string packed;
+    packed_point_cloud::append_point(packed, 1.0f, 2.0f, 3.0f, 4.0f);
+    packed.append("\x01\x02\x03", 3);
+
+    std::vector<float> points = {9.0f, 9.0f};
+    EXPECT_EQ(packed_point_cloud::unpack(packed, points), 1u);
+    EXPECT_EQ(points.size(), 4u);
+    EXPECT_FLOAT_EQ(points[2], 3.0f);
+}
+
+/**
+ * @brief The tracker builds the same tracks from packed and repeated scans
+ */
+TEST_F(PackedPointCloudTest, TrackerTreatsBothEncodingsAlike) {
+    messages::L1ToL2Message repeated, packed;
+    make_scans(repeated, packed);
+
+    auto run = [](const messages::L1ToL2Message& message) {
+        TargetTrackingAlgorithm algorithm;
+        fusion::AlgorithmContext context;
+        algorithm.initialize(context);
+        algorithm.process_l1_message(context, message);
+
+        std::vector<std::pair<float, float>> positions;
+        for (const auto& [id, target] : *context.get_data_ptr<ShardedTrackStore>("targets")) {
+            positions.emplace_back(target.x, target.y);
+        }
+        std::sort(positions.begin(), positions.end());
+        return positions;
+    };
+
+    auto from_repeated = run(repeated);
+    auto from_packed = run(packed);
+
+    ASSERT_EQ(from_repeated.size(), 3u);
+    ASSERT_EQ(from_packed.size(), from_repeated.size());
+    for (size_t i = 0; i < from_packed.size(); ++i) {
+        EXPECT_FLOAT_EQ(from_packed[i].first, from_repeated[i].first);
+        EXPECT_FLOAT_EQ(from_packed[i].second, from_repeated[i].second);
+    }
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include "point_cloud_clustering.h"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+// Reference O(n^2) breadth-first clustering (the legacy lidar path)
+std::vector<PointCluster> brute_force_clusters(const std::vector<float>& points, size_t stride,
+                                               float distance, uint32_t min_points) {
+    const size_t n = points.size() / stride;
+    std::vector<bool> visited(n, false);
+    std::vector<PointCluster> clusters;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (visited[i]) continue;
+        double sx = 0, sy = 0, sz = 0;
+        uint32_t count = 0;
+        std::queue<size_t> to_visit;
+        to_visit.push(i);
+        visited[i] = true;
+
+        while (!to_visit.empty()) {
+            size_t current = to_visit.front();
+            to_visit.pop();
+            sx += points[current * stride];
+            sy += points[current * stride + 1];
+            sz += points[current * stride + 2];
+            ++count;
+            for (size_t j = 0; j < n; ++j) {
+                if (visited[j]) continue;
+                float dx = points[current * stride] - points[j * stride];
+                float dy = points[current * stride + 1] - points[j * stride + 1];
+                float dz = points[current * stride + 2] - points[j * stride + 2];
+                if (dx*dx + dy*dy + dz*dz < distance * distance) {
+                    visited[j] = true;
+                    to_visit.push(j);
+                }
+            }
+        }
+        if (count >= min_points) {
+            clusters.push_back({static_cast<float>(sx / count), static_cast<float>(sy / count),
+                                static_cast<float>(sz / count), count});
+        }
+    }
+    return clusters;
+}
+
+void sort_clusters(std::vector<PointCluster>& clusters) {
+    std::sort(clusters.begin(), clusters.end(), [](const auto& a, const auto& b) {
+        return std::tie(a.point_count, a.x, a.y, a.z) < std::tie(b.point_count, b.x, b.y, b.z);
+    });
+}
+
+} // namespace
+
+/**
+ * @brief Test fixture for voxel-grid Euclidean cluster extraction
+ */
+class PointCloudClusteringTest : public ::testing::Test {
+protected:
+    void add_blob(std::vector<float>& points, float cx, float cy, float cz, int count, std::mt19937& rng) {
+        std::normal_distribution<float> noise(0.0f, 0.5f);
+        for (int i = 0; i < count; ++i) {
+            points.insert(points.end(), {cx + noise(rng), cy + noise(rng), cz + noise(rng), 1.0f});
+        }
+    }
+};
+
+/**
+ * @brief Separated blobs come back as separate clusters with correct centroids
+ */
+TEST_F(PointCloudClusteringTest, SeparatesDistinctObjects) {
+    // Two tight 3-point chains 10 m apart
+    std::vector<float> points = {
+        0.0f, 0.0f, 0.0f, 1.0f,   0.5f, 0.0f, 0.0f, 1.0f,   1.0f, 0.0f, 0.0f, 1.0f,
+        10.0f, 0.0f, 0.0f, 1.0f,  10.0f, 0.5f, 0.0f, 1.0f,  10.0f, 1.0f, 0.0f, 1.0f,
+    };
+
+    EuclideanClusterExtractor extractor(1.0f);
+    std::vector<PointCluster> clusters;
+    extractor.extract(points.data(), 6, 4, clusters);
+
+    ASSERT_EQ(clusters.size(), 2u);
+    sort_clusters(clusters);
+    EXPECT_FLOAT_EQ(clusters[0].x, 0.5f);
+    EXPECT_FLOAT_EQ(clusters[0].y, 0.0f);
+    EXPECT_EQ(clusters[0].point_count, 3u);
+    EXPECT_FLOAT_EQ(clusters[1].x, 10.0f);
+    EXPECT_FLOAT_EQ(clusters[1].y, 0.5f);
+    EXPECT_EQ(clusters[1].point_count, 3u);
+}
+
+/**
+ * @brief Links are transitive and strictly shorter than the cluster distance
+ */
+TEST_F(PointCloudClusteringTest, LinksTransitivelyWithStrictDistance) {
+    // 0.9 m steps chain into one cluster; a 1.0 m gap does not link
+    std::vector<float> points = {0.0f, 0.0f, 0.0f, 0.9f, 0.0f, 0.0f, 1.8f, 0.0f, 0.0f, 2.8f, 0.0f, 0.0f};
+
+    EuclideanClusterExtractor extractor(1.0f);
+    std::vector<PointCluster> clusters;
+    extractor.extract(points.data(), 4, 3, clusters);
+
+    ASSERT_EQ(clusters.size(), 2u);
+    sort_clusters(clusters);
+    EXPECT_EQ(clusters[0].point_count, 1u);
+    EXPECT_EQ(clusters[1].point_count, 3u);
+}
+
+/**
+ * @brief Clusters smaller than min_points are dropped
+ */
+TEST_F(PointCloudClusteringTest, DropsSmallClusters) {
+    std::mt19937 rng(3);
+    std::vector<float> points;
+    add_blob(points, 0.0f, 0.0f, 0.0f, 30, rng);
+    points.insert(points.end(), {50.0f, 50.0f, 0.0f, 1.0f});
+
+    EuclideanClusterExtractor extractor(1.0f, 11);
+    std::vector<PointCluster> clusters;
+    extractor.extract(points.data(), points.size() / 4, 4, clusters);
+
+    for (const auto& cluster : clusters) {
+        EXPECT_GE(cluster.point_count, 11u);
+    }
+    EXPECT_TRUE(std::none_of(clusters.begin(), clusters.end(),
+                             [](const auto& c) { return c.x > 40.0f; }));
+}
+
+/**
+ * @brief Empty input yields no clusters
+ */
+TEST_F(PointCloudClusteringTest, HandlesEmptyCloud) {
+    EuclideanClusterExtractor extractor;
+    std::vector<PointCluster> clusters = {PointCluster{}};
+    extractor.extract(nullptr, 0, 4, clusters);
+    EXPECT_TRUE(clusters.empty());
+}
+
+/**
+ * @brief Non-finite points are skipped and far points clamped into the edge cells
+ */
+TEST_F(PointCloudClusteringTest, SkipsNonFiniteAndClampsFarPoints) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    std::vector<float> points = {
+        0.0f, 0.0f, 0.0f,   0.5f, 0.0f, 0.0f,
+        nan, 0.0f, 0.0f,    0.0f, inf, 0.0f,   0.0f, 0.0f, -inf,
+        1e30f, 0.0f, 0.0f,  -1e30f, 0.0f, 0.0f,
+    };
+
+    EuclideanClusterExtractor extractor(1.0f);
+    std::vector<PointCluster> clusters;
+    extractor.extract(points.data(), points.size() / 3, 3, clusters);
+
+    ASSERT_EQ(clusters.size(), 3u);
+    sort_clusters(clusters);
+    EXPECT_EQ(clusters[2].point_count, 2u);
+    EXPECT_FLOAT_EQ(clusters[2].x, 0.25f);
+}
+
+/**
+ * @brief Random clouds (including negative coordinates) match the O(n^2) reference
+ */
+TEST_F(PointCloudClusteringTest, MatchesBruteForceReference) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> center(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> scatter(-60.0f, 60.0f);
+    EuclideanClusterExtractor extractor(1.0f, 2);
+
+    for (int trial = 0; trial < 20; ++trial) {
+        std::vector<float> points;
+        for (int blob = 0; blob < 5; ++blob) {
+            add_blob(points, center(rng), center(rng), center(rng) * 0.1f, 40, rng);
+        }
+        for (int i = 0; i < 200; ++i) {
+            points.insert(points.end(), {scatter(rng), scatter(rng), scatter(rng) * 0.05f, 1.0f});
+        }
+
+        std::vector<PointCluster> clusters;
+        extractor.extract(points.data(), points.size() / 4, 4, clusters);
+        auto expected = brute_force_clusters(points, 4, 1.0f, 2);
+
+        ASSERT_EQ(clusters.size(), expected.size()) << "Trial " << trial;
+        sort_clusters(clusters);
+        sort_clusters(expected);
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            EXPECT_EQ(clusters[i].point_count, expected[i].point_count);
+            EXPECT_NEAR(clusters[i].x, expected[i].x, 1e-3f);
+            EXPECT_NEAR(clusters[i].y, expected[i].y, 1e-3f);
+            EXPECT_NEAR(clusters[i].z, expected[i].z, 1e-3f);
+        }
+    }
+}
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+#include "sharded_track_store.h"
+#include "algorithms/target_tracking_algorithm.h"
+#include "messages/l1_to_l2.pb.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <set>
+#include <span>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace dp_aero_l2;
+using namespace dp_aero_l2::algorithms;
+
+/**
+ * @brief Test fixture for ShardedTrackStore
+ */
+class ShardedTrackStoreTest : public ::testing::Test {
+protected:
+    ShardedTrackStore store{8, 100.0f, 5.0f};
+
+    // Radar message whose detections sit at the given (x, y) positions
+    static messages::L1ToL2Message radar_at(const std::string& node_id,
+                                            const std::vector<std::pair<float, float>>& positions) {
+        messages::L1ToL2Message message;
+        message.mutable_sender()->set_node_id(node_id);
+        auto* radar = message.mutable_sensor_data()->mutable_radar();
+        for (const auto& [x, y] : positions) {
+            auto* detection = radar->add_detections();
+            detection->set_range(std::sqrt(x * x + y * y));
+            detection->set_azimuth(std::atan2(y, x));
+            detection->set_rcs(1.0f);
+        }
+        return message;
+    }
+};
+
+/**
+ * @brief Tracks are created in the shard owning their position, with unique ids
+ */
+TEST_F(ShardedTrackStoreTest, CreatesTracksInOwningShard) {
+    std::set<std::string> ids;
+    {
+        auto region = store.lock(store.all_shards());
+        for (int i = 0; i < 50; ++i) {
+            float x = -1000.0f + 40.0f * i;
+            auto& target = region.create(x, 3.0f * i, 0.0f);
+            ids.insert(target.target_id);
+        }
+    }
+
+    EXPECT_EQ(ids.size(), 50u);
+    EXPECT_EQ(store.size(), 50u);
+    for (const auto& [id, target] : store) {
+        size_t shard = store.shard_index(target.x, target.y);
+        EXPECT_NE(store.shard(shard).find(id), nullptr);
+    }
+}
+
+/**
+ * @brief Radius queries see tracks in every locked shard
+ */
+TEST_F(ShardedTrackStoreTest, FindsCandidatesAcrossRegionBorders) {
+    {
+        auto region = store.lock(store.all_shards());
+        region.create(99.0f, 0.0f, 0.0f);   // Left of the x = 100 border
+        region.create(101.0f, 0.0f, 0.0f);  // Right of it
+    }
+
+    auto mask = store.shards_near(100.0f, 0.0f, 5.0f);
+    EXPECT_NE(mask & (ShardedTrackStore::ShardMask{1} << store.shard_index(99.0f, 0.0f)), 0u);
+    EXPECT_NE(mask & (ShardedTrackStore::ShardMask{1} << store.shard_index(101.0f, 0.0f)), 0u);
+
+    auto region = store.lock(mask);
+    std::vector<std::pair<Target*, float>> candidates;
+    region.find_within(100.0f, 0.0f, 0.0f, 5.0f, candidates);
+    EXPECT_EQ(candidates.size(), 2u);
+}
+
+/**
+ * @brief Moving a track into another region migrates it and keeps its address
+ */
+TEST_F(ShardedTrackStoreTest, MigratesMovedTracks) {
+    auto region = store.lock(store.all_shards());
+    Target& target = region.create(10.0f, 10.0f, 0.0f);
+    const std::string id = target.target_id;
+
+    target.x = 450.0f;
+    target.y = -320.0f;
+    region.relocate(target);
+
+    const size_t home = store.shard_index(450.0f, -320.0f);
+    EXPECT_EQ(store.shard(home).find(id), &target);
+
+    std::vector<std::pair<Target*, float>> candidates;
+    region.find_within(450.0f, -320.0f, 0.0f, 1.0f, candidates);
+    ASSERT_EQ(candidates.size(), 1u);
+    EXPECT_EQ(candidates[0].first, &target);
+}
+
+/**
+ * @brief Out-of-range and non-finite positions still map to a valid shard
+ */
+TEST_F(ShardedTrackStoreTest, MapsExtremePositionsToValidShards) {
+    const float inf = std::numeric_limits<float>::infinity();
+    for (float x : {1e30f, -1e30f, inf, -inf, std::numeric_limits<float>::quiet_NaN()}) {
+        EXPECT_LT(store.shard_index(x, 0.0f), store.shard_count());
+        EXPECT_NE(store.shards_near(x, x, 5.0f), 0u);
+    }
+}
+
+/**
+ * @brief Creating outside the locked shards is a logic error
+ */
+TEST_F(ShardedTrackStoreTest, RejectsAccessOutsideLockedShards) {
+    const size_t shard = store.shard_index(0.0f, 0.0f);
+    auto region = store.lock(ShardedTrackStore::ShardMask{1} << shard);
+
+    float x = 100.0f;
+    while (store.shard_index(x, 0.0f) == shard) {
+        x += 100.0f;
+    }
+    EXPECT_THROW(region.create(x, 0.0f, 0.0f), std::logic_error);
+}
+
+/**
+ * @brief Copies are independent
+ */
+TEST_F(ShardedTrackStoreTest, CopiesAreIndependent) {
+    {
+        auto region = store.lock(store.all_shards());
+        region.create(1.0f, 1.0f, 0.0f);
+    }
+    ShardedTrackStore copy = store;
+    copy.clear();
+    EXPECT_EQ(store.size(), 1u);
+    EXPECT_TRUE(copy.empty());
+
+    // Cleared stores do not hand out ids again
+    auto region = copy.lock(copy.all_shards());
+    EXPECT_EQ(region.create(1.0f, 1.0f, 0.0f).target_id, "target_1");
+}
+
+/**
+ * @brief Concurrent message processing builds the same tracks as sequential processing
+ */
+TEST_F(ShardedTrackStoreTest, ConcurrentProcessingMatchesSequential) {
+    // Four groups of objects far apart, each seen by its own radar for several frames
+    std::vector<messages::L1ToL2Message> messages;
+    for (int frame = 0; frame < 20; ++frame) {
+        for (int group = 0; group < 4; ++group) {
+            std::vector<std::pair<float, float>> positions;
+            for (int object = 0; object < 5; ++object) {
+                positions.emplace_back(600.0f * group + 20.0f * object + 100.0f, 50.0f + 30.0f * group);
+            }
+            messages.push_back(radar_at("radar_" + std::to_string(group), positions));
+        }
+    }
+
+    auto positions_after = [&messages](size_t threads) {
+        TargetTrackingAlgorithm algorithm;
+        fusion::AlgorithmContext context;
+        algorithm.initialize(context);
+
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (size_t i = t; i < messages.size(); i += threads) {
+                    algorithm.process_l1_message(context, messages[i]);
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+
+        std::vector<std::pair<int, int>> positions;
+        for (const auto& [id, target] : *context.get_data_ptr<ShardedTrackStore>("targets")) {
+            positions.emplace_back(static_cast<int>(std::lround(target.x)), static_cast<int>(std::lround(target.y)));
+        }
+        std::sort(positions.begin(), positions.end());
+        return positions;
+    };
+
+    auto sequential = positions_after(1);
+    auto concurrent = positions_after(4);
+    EXPECT_EQ(sequential.size(), 20u);
+    EXPECT_EQ(concurrent, sequential);
+}
+
+/**
+ * @brief Concurrent processing leaves tasking of new tracks to update()
+ */
+TEST_F(ShardedTrackStoreTest, AssignsNewTracksInUpdate) {
+    // Counts calls; a data race on the count would mean concurrent assignment
+    class CountingAssignment : public SingleDeviceAssignmentStrategy {
+    public:
+        size_t& calls;
+        explicit CountingAssignment(size_t& count) : SingleDeviceAssignmentStrategy("default_device"), calls(count) {}
+        std::string select_device_for_target(const Target& target, const fusion::TaskManager& task_manager,
+                                             const fusion::AlgorithmContext& context) override {
+            ++calls;
+            return SingleDeviceAssignmentStrategy::select_device_for_target(target, task_manager, context);
+        }
+    };
+
+    size_t calls = 0;
+    TargetTrackingAlgorithm algorithm;
+    algorithm.set_device_assignment_strategy(std::make_unique<CountingAssignment>(calls));
+    fusion::AlgorithmContext context;
+    algorithm.initialize(context);
+
+    std::vector<std::thread> workers;
+    for (int group = 0; group < 4; ++group) {
+        workers.emplace_back([&, group] {
+            algorithm.process_l1_message(context, radar_at("radar_" + std::to_string(group),
+                                                          {{600.0f * group + 100.0f, 50.0f}}));
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    EXPECT_EQ(context.get_data_ptr<ShardedTrackStore>("targets")->size(), 4u);
+    EXPECT_EQ(calls, 0u);
+    EXPECT_TRUE(context.take_update_request());
+
+    algorithm.update(context);
+    EXPECT_EQ(calls, 4u);
+
+    algorithm.update(context);
+    EXPECT_EQ(calls, 4u);
+}
+
+/**
+ * @brief Batched processing builds the same tracks as message-by-message processing
+ */
+TEST_F(ShardedTrackStoreTest, BatchProcessingMatchesPerMessage) {
+    // Two groups of objects drifting across a region border, so batches span shards
+    std::vector<fusion::L1MessagePtr> messages;
+    for (int frame = 0; frame < 30; ++frame) {
+        for (int group = 0; group < 2; ++group) {
+            std::vector<std::pair<float, float>> positions;
+            for (int object = 0; object < 4; ++object) {
+                positions.emplace_back(243.0f + 0.3f * frame + 15.0f * object, 40.0f + 400.0f * group);
+            }
+            messages.push_back(std::make_shared<messages::L1ToL2Message>(
+                radar_at("radar_" + std::to_string(group), positions)));
+        }
+    }
+
+    auto tracks_after = [&messages](size_t batch_size) {
+        TargetTrackingAlgorithm algorithm;
+        fusion::AlgorithmContext context;
+        algorithm.initialize(context);
+
+        std::span<const fusion::L1MessagePtr> all(messages);
+        for (size_t i = 0; i < all.size(); i += batch_size) {
+            if (batch_size == 1) {
+                algorithm.process_l1_message(context, *all[i]);
+            } else {
+                algorithm.process_l1_batch(context, all.subspan(i, std::min(batch_size, all.size() - i)));
+            }
+        }
+
+        std::vector<std::tuple<std::string, int, int, int>> tracks;
+        for (const auto& [id, target] : *context.get_data_ptr<ShardedTrackStore>("targets")) {
+            tracks.emplace_back(id, static_cast<int>(std::lround(target.x * 100)),
+                                static_cast<int>(std::lround(target.y * 100)),
+                                target.sensor_detections.begin()->second);
+        }
+        std::sort(tracks.begin(), tracks.end());
+        return tracks;
+    };
+
+    auto per_message = tracks_after(1);
+    EXPECT_EQ(per_message.size(), 8u);
+    EXPECT_EQ(tracks_after(7), per_message);
+    EXPECT_EQ(tracks_after(messages.size()), per_message);
+}
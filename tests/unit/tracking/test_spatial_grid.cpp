@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "spatial_grid.h"
+#include "track_store.h"
+#include <random>
+#include <vector>
+
+using namespace dp_aero_l2::algorithms;
+
+namespace {
+
+Target* brute_force_nearest(TrackStore& store, float x, float y, float z, float radius) {
+    Target* best = nullptr;
+    float best_sq = radius * radius;
+    for (auto& [id, target] : store) {
+        float d2 = SpatialGrid::distance_sq(target, x, y, z);
+        if (d2 < best_sq) {
+            best_sq = d2;
+            best = &target;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+/**
+ * @brief Test fixture for SpatialGrid and its use inside TrackStore
+ */
+class SpatialGridTest : public ::testing::Test {
+protected:
+    Target make_target(const std::string& id, float x, float y, float z) {
+        Target target(id);
+        target.x = x;
+        target.y = y;
+        target.z = z;
+        return target;
+    }
+};
+
+/**
+ * @brief Neighbouring cells are searched, including negative coordinates
+ */
+TEST_F(SpatialGridTest, FindsNearestAcrossCellBoundaries) {
+    SpatialGrid grid(5.0f);
+    auto a = make_target("a", -0.5f, 0.0f, 0.0f);
+    auto b = make_target("b", 4.9f, 4.9f, 0.0f);
+    grid.insert(&a);
+    grid.insert(&b);
+    
+    EXPECT_EQ(grid.find_nearest(0.5f, 0.0f, 0.0f, 5.0f), &a);
+    EXPECT_EQ(grid.find_nearest(5.1f, 5.1f, 0.0f, 5.0f), &b);
+    EXPECT_EQ(grid.find_nearest(50.0f, 0.0f, 0.0f, 5.0f), nullptr);
+    
+    std::vector<std::pair<Target*, float>> hits;
+    grid.query_radius(2.0f, 2.0f, 0.0f, 5.0f, hits);
+    EXPECT_EQ(hits.size(), 2);
+}
+
+/**
+ * @brief Moved targets are re-bucketed by update()
+ */
+TEST_F(SpatialGridTest, TracksMovedTargets) {
+    SpatialGrid grid(5.0f);
+    auto a = make_target("a", 0.0f, 0.0f, 0.0f);
+    grid.insert(&a);
+    
+    a.x = 100.0f;
+    grid.update(&a);
+    EXPECT_EQ(grid.find_nearest(0.0f, 0.0f, 0.0f, 5.0f), nullptr);
+    EXPECT_EQ(grid.find_nearest(101.0f, 0.0f, 0.0f, 5.0f), &a);
+    
+    grid.erase(&a);
+    EXPECT_EQ(grid.size(), 0);
+    EXPECT_EQ(grid.find_nearest(101.0f, 0.0f, 0.0f, 5.0f), nullptr);
+}
+
+/**
+ * @brief Radii larger than a cell widen the searched neighbourhood
+ */
+TEST_F(SpatialGridTest, SupportsRadiusLargerThanCell) {
+    SpatialGrid grid(1.0f);
+    auto a = make_target("a", 7.0f, 0.0f, 0.0f);
+    grid.insert(&a);
+    
+    EXPECT_EQ(grid.find_nearest(0.0f, 0.0f, 0.0f, 7.5f), &a);
+    EXPECT_EQ(grid.find_nearest(0.0f, 0.0f, 0.0f, 6.5f), nullptr);
+}
+
+/**
+ * @brief TrackStore lookups match a brute-force scan after moves and removals
+ */
+TEST_F(SpatialGridTest, TrackStoreMatchesBruteForce) {
+    TrackStore store;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    
+    for (int i = 0; i < 500; ++i) {
+        auto& target = store.create();
+        target.x = position(rng);
+        target.y = position(rng);
+        target.z = position(rng) / 10.0f;
+        store.relocate(target);
+    }
+    
+    // Move some tracks and drop others
+    int n = 0;
+    for (auto& [id, target] : store) {
+        if (n++ % 3 == 0) {
+            target.x += 7.0f;
+            store.relocate(target);
+        }
+    }
+    store.erase_if([](const std::string&, const Target& target) { return target.y > 80.0f; });
+    
+    for (int q = 0; q < 200; ++q) {
+        float x = position(rng), y = position(rng), z = position(rng) / 10.0f;
+        EXPECT_EQ(store.find_closest(x, y, z, 5.0f), brute_force_nearest(store, x, y, z, 5.0f));
+    }
+    
+    // Copies carry an index of their own targets
+    TrackStore copy = store;
+    for (auto& [id, target] : copy) {
+        EXPECT_EQ(copy.find_closest(target.x, target.y, target.z, 0.01f)->target_id, id);
+    }
+}
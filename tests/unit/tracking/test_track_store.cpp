@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "track_store.h"
+#include "test_data_factory.h"
+#include <string>
+
+using namespace dp_aero_l2::algorithms;
+
+/**
+ * @brief Test fixture for TrackStore
+ */
+class TrackStoreTest : public ::testing::Test {
+protected:
+    TrackStore store;
+};
+
+/**
+ * @brief Test id generation and lookup
+ */
+TEST_F(TrackStoreTest, CreatesTracksWithSequentialIds) {
+    auto& first = store.create();
+    auto& second = store.create();
+    
+    EXPECT_EQ(first.target_id, "target_0");
+    EXPECT_EQ(second.target_id, "target_1");
+    EXPECT_EQ(store.size(), 2);
+    EXPECT_EQ(store.find("target_1"), &second);
+    EXPECT_EQ(store.find("target_9"), nullptr);
+}
+
+/**
+ * @brief Generated ids must never overwrite a live track after removals
+ */
+TEST_F(TrackStoreTest, DoesNotReuseLiveIdsAfterErase) {
+    store.create();
+    auto& kept = store.create();
+    kept.confidence = 0.9f;
+    ASSERT_TRUE(store.erase("target_0"));
+    
+    auto& created = store.create();
+    EXPECT_NE(created.target_id, "target_1");
+    EXPECT_FLOAT_EQ(store.find("target_1")->confidence, 0.9f);
+    EXPECT_EQ(store.size(), 2);
+}
+
+/**
+ * @brief Test closest-track gating
+ */
+TEST_F(TrackStoreTest, FindsClosestTrackInsideGate) {
+    auto& near_target = store.create();
+    near_target.x = 1.0f;
+    auto& far_target = store.create();
+    far_target.x = 4.0f;
+    
+    EXPECT_EQ(store.find_closest(0.0f, 0.0f, 0.0f, 5.0f), &near_target);
+    EXPECT_EQ(store.find_closest(4.5f, 0.0f, 0.0f, 5.0f), &far_target);
+    EXPECT_EQ(store.find_closest(20.0f, 0.0f, 0.0f, 5.0f), nullptr);
+}
+
+/**
+ * @brief Test predicate removal and clearing
+ */
+TEST_F(TrackStoreTest, ErasesByPredicateAndClears) {
+    for (int i = 0; i < 4; ++i) {
+        store.create().confidence = 0.25f * i;
+    }
+    
+    size_t removed = store.erase_if([](const std::string&, const Target& target) {
+        return target.confidence < 0.5f;
+    });
+    EXPECT_EQ(removed, 2);
+    EXPECT_EQ(store.size(), 2);
+    
+    store.clear();
+    EXPECT_TRUE(store.empty());
+    EXPECT_EQ(store.create().target_id, "target_4");
+}
+
+/**
+ * @brief Tracks stored in an AlgorithmContext slot are mutated in place
+ */
+TEST_F(TrackStoreTest, MutatesInPlaceThroughContextSlot) {
+    AlgorithmContext context;
+    context.emplace_data<TrackStore>("targets");
+    
+    auto* targets = context.get_data_ptr<TrackStore>("targets");
+    ASSERT_NE(targets, nullptr);
+    targets->create().confidence = 0.6f;
+    
+    const auto* again = context.get_data_ptr<TrackStore>("targets");
+    ASSERT_NE(again, nullptr);
+    ASSERT_EQ(again->size(), 1);
+    EXPECT_FLOAT_EQ(again->find("target_0")->confidence, 0.6f);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "track_table.h"
+#include "test_data_factory.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace dp_aero_l2::algorithms;
+
+/**
+ * @brief Test fixture for TrackTable
+ */
+class TrackTableTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (const auto& target : TargetFactory::createTargetCluster()) {
+            table.add(target);
+        }
+    }
+    
+    TrackTable table;
+};
+
+/**
+ * @brief Rows round-trip through Target and ids are interned
+ */
+TEST_F(TrackTableTest, RoundTripsTargets) {
+    ASSERT_EQ(table.size(), 4);
+    
+    auto row = table.index_of("approaching_001");
+    ASSERT_NE(row, TrackTable::npos);
+    EXPECT_EQ(table.id_of(row), "approaching_001");
+    
+    auto target = table.to_target(row);
+    auto expected = TargetFactory::createApproachingTarget();
+    EXPECT_FLOAT_EQ(target.x, expected.x);
+    EXPECT_FLOAT_EQ(target.vy, expected.vy);
+    EXPECT_FLOAT_EQ(target.confidence, expected.confidence);
+    EXPECT_EQ(table.index_of("unknown"), TrackTable::npos);
+}
+
+/**
+ * @brief Removal keeps indices dense and the id map consistent
+ */
+TEST_F(TrackTableTest, RemovesBySwappingLastRow) {
+    table.remove(table.index_of("high_conf_001"));
+    
+    ASSERT_EQ(table.size(), 3);
+    EXPECT_EQ(table.index_of("high_conf_001"), TrackTable::npos);
+    for (TrackTable::Index row = 0; row < table.size(); ++row) {
+        EXPECT_EQ(table.index_of(table.id_of(row)), row);
+    }
+    EXPECT_FLOAT_EQ(table.to_target(table.index_of("distant_001")).x, 1000.0f);
+}
+
+/**
+ * @brief Constant-velocity prediction
+ */
+TEST_F(TrackTableTest, PredictsConstantVelocity) {
+    table.predict(2.0f);
+    
+    auto target = table.to_target(table.index_of("high_conf_001"));
+    EXPECT_FLOAT_EQ(target.x, 100.0f - 20.0f);
+    EXPECT_FLOAT_EQ(target.y, 200.0f - 40.0f);
+    EXPECT_FLOAT_EQ(target.z, 50.0f);
+}
+
+/**
+ * @brief Only stale tracks lose confidence
+ */
+TEST_F(TrackTableTest, DecaysOnlyStaleTracks) {
+    auto stale = TargetFactory::createHighConfidenceTarget();
+    stale.target_id = "stale_001";
+    stale.last_update = std::chrono::steady_clock::now() - std::chrono::seconds(30);
+    table.add(stale);
+    
+    table.decay_confidence(std::chrono::steady_clock::now(), std::chrono::seconds(10), 0.5f);
+    
+    EXPECT_FLOAT_EQ(table.to_target(table.index_of("stale_001")).confidence, 0.475f);
+    EXPECT_FLOAT_EQ(table.to_target(table.index_of("high_conf_001")).confidence, 0.95f);
+}
+
+/**
+ * @brief Gating returns rows inside the radius; nearest picks the closest
+ */
+TEST_F(TrackTableTest, GatesAndFindsNearest) {
+    std::vector<TrackTable::Index> rows;
+    EXPECT_EQ(table.gate(100.0f, 200.0f, 50.0f, 5.0f, rows), 1);
+    EXPECT_EQ(table.id_of(rows[0]), "high_conf_001");
+    
+    EXPECT_EQ(table.gate(0.0f, 0.0f, 0.0f, 1.0f, rows), 0);
+    EXPECT_EQ(table.gate(0.0f, 0.0f, 0.0f, 2000.0f, rows), 4);
+    
+    EXPECT_EQ(table.id_of(table.nearest(52.0f, 30.0f, 10.0f, 5.0f)), "approaching_001");
+    EXPECT_EQ(table.nearest(52.0f, 30.0f, 10.0f, 1.0f), TrackTable::npos);
+}
+
+/**
+ * @brief Tables load from and write back to a TrackStore
+ */
+TEST_F(TrackTableTest, SynchronizesWithTrackStore) {
+    TrackStore store;
+    auto& target = store.create();
+    target.vx = 1.0f;
+    target.sensor_detections[dp_aero_l2::core::intern_node("radar_001")] = 3;
+    
+    auto loaded = TrackTable::from_store(store);
+    loaded.predict(5.0f);
+    loaded.write_back(store);
+    
+    EXPECT_FLOAT_EQ(store.find("target_0")->x, 5.0f);
+    EXPECT_EQ(store.find("target_0")->sensor_detections.at(dp_aero_l2::core::intern_node("radar_001")), 3);
+}
+
+/**
+ * @brief Tables load from and write back to a ShardedTrackStore, moving tracks between shards
+ */
+TEST_F(TrackTableTest, SynchronizesWithShardedTrackStore) {
+    ShardedTrackStore store{4, 100.0f, 5.0f};
+    {
+        auto region = store.lock(store.all_shards());
+        auto& target = region.create(10.0f, 10.0f, 0.0f);
+        target.vx = 100.0f;
+    }
+    const size_t start_shard = store.shard_index(10.0f, 10.0f);
+    ASSERT_NE(store.shard_index(510.0f, 10.0f), start_shard);
+    
+    auto loaded = TrackTable::from_store(store);
+    ASSERT_EQ(loaded.size(), 1);
+    loaded.predict(5.0f);
+    loaded.write_back(store);
+    
+    const auto& id = loaded.id_of(0);
+    ASSERT_NE(store.find(id), nullptr);
+    EXPECT_FLOAT_EQ(store.find(id)->x, 510.0f);
+    EXPECT_EQ(store.shard(start_shard).find(id), nullptr);
+    EXPECT_NE(store.shard(store.shard_index(510.0f, 10.0f)).find(id), nullptr);
+}